@@ -0,0 +1,82 @@
+#include <sleip/arena.hpp>
+#include <sleip/dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#ifndef SLEIP_NO_CXX17_PMR
+#include <memory_resource>
+#endif
+
+// a "request" builds a few dozen small arrays, keeps them all alive until it's done and then drops
+// them together, which is the lifetime pattern an arena is built for
+//
+// the arena and the monotonic resource both get the same initial buffer so neither goes upstream
+// once warmed up and what's left is the cost of allocation and deallocation themselves
+//
+namespace
+{
+constexpr std::size_t const num_requests = 20'000;
+constexpr std::size_t const num_arrays   = 32;
+
+constexpr std::size_t const sizes[] = {16, 64, 8, 256, 32, 4};
+
+auto
+request_bytes() -> std::size_t
+{
+  auto n = std::size_t{0};
+  for (std::size_t i = 0; i < num_arrays; ++i) { n += sizes[i % std::size(sizes)] * sizeof(int); }
+  return n * num_requests;
+}
+
+template <class Array, class MakeAlloc>
+auto
+run_requests(MakeAlloc const& make_alloc) -> void
+{
+  auto arrays = std::vector<Array>();
+  arrays.reserve(num_arrays);
+
+  for (std::size_t r = 0; r < num_requests; ++r) {
+    auto alloc = make_alloc();
+    for (std::size_t i = 0; i < num_arrays; ++i) {
+      arrays.emplace_back(sizes[i % std::size(sizes)], static_cast<int>(i), alloc);
+    }
+    bench::escape(arrays.data());
+    arrays.clear();
+  }
+}
+} // namespace
+
+int
+main()
+{
+  std::printf("%zu requests of %zu arrays each\n", num_requests, num_arrays);
+
+  alignas(std::max_align_t) static unsigned char buffer[256 << 10];
+
+  bench::run("std::allocator", request_bytes(), 10, [&] {
+    run_requests<sleip::dynamic_array<int>>([] { return std::allocator<int>(); });
+  });
+
+#ifndef SLEIP_NO_CXX17_PMR
+  bench::run("pmr, monotonic_buffer_resource", request_bytes(), 10, [&] {
+    auto mem = std::pmr::monotonic_buffer_resource(buffer, sizeof(buffer));
+    run_requests<sleip::pmr::dynamic_array<int>>([&] {
+      mem.release();
+      return std::pmr::polymorphic_allocator<int>(&mem);
+    });
+  });
+#endif
+
+  bench::run("arena_allocator", request_bytes(), 10, [&] {
+    auto a = sleip::arena(buffer, sizeof(buffer));
+    run_requests<sleip::dynamic_array<int, sleip::arena_allocator<int>>>([&] {
+      a.release();
+      return sleip::arena_allocator<int>(a);
+    });
+  });
+}
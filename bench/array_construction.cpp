@@ -0,0 +1,116 @@
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/container/pmr/unsynchronized_pool_resource.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+namespace pmr = boost::container::pmr;
+
+// hides contiguity from the range constructor, the way a `std::list` or a filtering iterator
+// would, so it has to go through `detail::array_walker`
+//
+template <class T>
+struct forward_only
+{
+  using value_type        = T;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = T const*;
+  using reference         = T const&;
+  using iterator_category = std::forward_iterator_tag;
+
+  T const* p = nullptr;
+
+  auto
+  operator*() const -> reference
+  {
+    return *p;
+  }
+
+  auto
+  operator++() & -> forward_only&
+  {
+    ++p;
+    return *this;
+  }
+
+  auto
+  operator++(int) & -> forward_only
+  {
+    auto tmp = *this;
+    ++p;
+    return tmp;
+  }
+
+  auto
+  operator==(forward_only const& other) const -> bool
+  {
+    return p == other.p;
+  }
+
+  auto
+  operator!=(forward_only const& other) const -> bool
+  {
+    return p != other.p;
+  }
+};
+
+// constructing from `T[N]` sources used to walk every scalar through `detail::array_walker` which
+// branches once per scalar, compare that against the flattened path and the plain scalar case
+//
+template <class T>
+auto
+bench_element_type(char const* scalar_name, char const* array_name) -> void
+{
+  using scalar_type = std::remove_all_extents_t<T>;
+
+  auto const count = std::size_t{1} << 22;
+  auto const bytes = count * sizeof(T);
+  auto const n     = sleip::detail::array_size_v<T>;
+
+  auto const scalars = sleip::dynamic_array<scalar_type>(count * n, scalar_type{1});
+  auto const arrays  = sleip::dynamic_array<T>(count);
+
+  std::printf("\n%s vs %s, %zu MiB\n", scalar_name, array_name, bytes >> 20);
+
+  bench::run("range constructor, scalar", bytes, 10, [&] {
+    auto a = sleip::dynamic_array<scalar_type>(scalars.begin(), scalars.end());
+    bench::escape(a.data());
+  });
+
+  bench::run("range constructor, array", bytes, 10, [&] {
+    auto a = sleip::dynamic_array<T>(arrays.begin(), arrays.end());
+    bench::escape(a.data());
+  });
+
+  bench::run("range constructor, array via array_walker", bytes, 10, [&] {
+    auto a = sleip::dynamic_array<T>(forward_only<T>{arrays.data()},
+                                     forward_only<T>{arrays.data() + count});
+    bench::escape(a.data());
+  });
+
+  // the two resources differ so the move can't steal the buffer, `polymorphic_allocator` has its
+  // own `construct` but `T[N]` of scalars is trivially relocatable, so this is a byte copy
+  //
+  using alloc_type = pmr::polymorphic_allocator<T>;
+
+  auto pool = pmr::unsynchronized_pool_resource();
+
+  bench::run("allocator-extended move, array", bytes, 10, [&] {
+    auto a = sleip::dynamic_array<T, alloc_type>(arrays.begin(), arrays.end(), alloc_type(&pool));
+    auto b = sleip::dynamic_array<T, alloc_type>(std::move(a), alloc_type());
+    bench::escape(b.data());
+  });
+}
+
+int
+main()
+{
+  bench_element_type<float[4]>("float", "float[4]");
+  bench_element_type<std::uint8_t[3]>("std::uint8_t", "std::uint8_t[3]");
+}
@@ -0,0 +1,52 @@
+#ifndef SLEIP_BENCH_BENCH_HPP_
+#define SLEIP_BENCH_BENCH_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace bench
+{
+// keep the optimizer from discarding work whose result is otherwise unobserved
+//
+inline auto
+escape(void const* p) -> void
+{
+#ifdef _MSC_VER
+  static_cast<void>(p);
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "g"(p) : "memory");
+#endif
+}
+
+// runs `f` `iterations` times and reports the best observed throughput over `bytes` per iteration
+//
+template <class F>
+auto
+run(char const* name, std::size_t bytes, int iterations, F&& f) -> double
+{
+  using clock = std::chrono::steady_clock;
+
+  auto best = std::numeric_limits<double>::max();
+  for (auto i = 0; i < iterations; ++i) {
+    auto const start = clock::now();
+    f();
+    auto const stop = clock::now();
+
+    best = std::min(best, std::chrono::duration<double>(stop - start).count());
+  }
+
+  auto const gbps = static_cast<double>(bytes) / best / 1e9;
+  std::printf("%-48s %10.3f ms %8.2f GB/s\n", name, best * 1e3, gbps);
+  return best;
+}
+} // namespace bench
+
+#endif // SLEIP_BENCH_BENCH_HPP_
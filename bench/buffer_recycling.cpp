@@ -0,0 +1,58 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/recycling_resource.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+
+// a dozen distinct sizes churned through `noinit` arrays that are written once and dropped
+//
+// glibc raises its mmap threshold as large blocks are freed but stops at 32 MiB, past that
+// `std::allocator` pays an `mmap`/`munmap` pair and a page fault per page on every iteration
+//
+namespace
+{
+constexpr std::size_t const sizes[] = {64,      256,     1024,    4096,    16384,   65536,
+                                       262144,  1 << 20, 1 << 21, 1 << 22, 1 << 23, 1 << 24};
+
+constexpr std::size_t const num_rounds = 20;
+
+auto
+total_bytes() -> std::size_t
+{
+  auto n = std::size_t{0};
+  for (auto const s : sizes) { n += s * sizeof(float); }
+  return n * num_rounds;
+}
+
+template <class Alloc>
+auto
+churn(Alloc const& alloc) -> void
+{
+  for (std::size_t r = 0; r < num_rounds; ++r) {
+    for (auto const s : sizes) {
+      auto a = sleip::dynamic_array<float, Alloc>(s, sleip::noinit, alloc);
+      for (std::size_t i = 0; i < s; i += 1024) { a[i] = 1.0f; }
+      bench::escape(a.data());
+    }
+  }
+}
+} // namespace
+
+int
+main()
+{
+  std::printf("%zu sizes, %zu rounds, touching one float per page\n", std::size(sizes),
+              num_rounds);
+
+  bench::run("std::allocator", total_bytes(), 5, [] { churn(std::allocator<float>()); });
+
+  auto r = sleip::recycling_resource();
+  bench::run("recycling_allocator", total_bytes(), 5,
+             [&] { churn(sleip::recycling_allocator<float>(r)); });
+
+  auto const stats = r.stats();
+  std::printf("hits: %zu, misses: %zu\n", stats.hits, stats.misses);
+}
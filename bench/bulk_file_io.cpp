@@ -0,0 +1,66 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array.hpp>
+#include <sleip/file_io.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+// compares the README's single fstream::read against read_file's queue of concurrent requests on
+// each backend, with and without `O_DIRECT`
+//
+// with a warm page cache this mostly measures memcpy bandwidth, drop the caches between runs to
+// see what the device can do
+//
+int
+main()
+{
+  auto const path  = "sleip_bench_bulk_file_io.dat";
+  auto const count = std::size_t{1} << 28;
+
+  using buffer_type =
+    sleip::dynamic_array<std::uint8_t, sleip::page_aligned_allocator<std::uint8_t>>;
+
+  auto buff = buffer_type(count, std::uint8_t{1});
+  sleip::write_file(path, buff);
+
+  std::printf("reading a %zu MiB file\n", count >> 20);
+
+  bench::run("fstream::read", count, 5, [&] {
+    auto file = std::ifstream(path, std::ios::in | std::ios::binary);
+    file.read(reinterpret_cast<char*>(buff.data()), static_cast<std::streamsize>(buff.size()));
+    bench::escape(buff.data());
+  });
+
+  auto const backends = {
+    std::make_pair("read_file, thread pool", sleip::file_io_backend::thread_pool),
+    std::make_pair("read_file, io_uring", sleip::file_io_backend::io_uring)};
+
+  for (auto const& [name, backend] : backends) {
+    for (auto const direct : {false, true}) {
+      auto options    = sleip::file_io_options();
+      options.backend = backend;
+      options.direct  = direct;
+
+      auto const label = std::string(name) + (direct ? ", O_DIRECT" : "");
+
+      try {
+        bench::run(label.c_str(), count, 5, [&] {
+          sleip::read_file(path, buff, options);
+          bench::escape(buff.data());
+        });
+      }
+      catch (std::system_error const& e) {
+        std::printf("%-48s skipped: %s\n", label.c_str(), e.what());
+      }
+    }
+  }
+
+  std::remove(path);
+}
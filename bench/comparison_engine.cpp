@@ -0,0 +1,138 @@
+#include <sleip/dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <boost/core/first_scalar.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+// sorting and deduplicating keys spends its time in `<` and `==`, which used to go scalar by scalar
+// through `std::lexicographical_compare` and `std::equal` and now compare whole blocks with
+// `memcmp`
+//
+// the keys share a long common prefix, as paths or URLs do, so every comparison has to get past it
+//
+namespace
+{
+constexpr std::size_t const num_keys = std::size_t{1} << 15;
+constexpr std::size_t const prefix   = 1024;
+
+using byte_key = sleip::dynamic_array<std::uint8_t>;
+using word_key = sleip::dynamic_array<std::uint32_t[4]>;
+
+template <class Key>
+auto
+num_scalars(Key const& key) -> std::size_t
+{
+  using value_type = typename Key::value_type;
+  return key.size() * (sizeof(value_type) / sizeof(std::remove_all_extents_t<value_type>));
+}
+
+// the comparisons as they were before the `memcmp` engine
+//
+struct elementwise_less
+{
+  template <class Key>
+  auto
+  operator()(Key const& lhs, Key const& rhs) const -> bool
+  {
+    auto a = boost::first_scalar(lhs.data());
+    auto b = boost::first_scalar(rhs.data());
+    return std::lexicographical_compare(a, a + num_scalars(lhs), b, b + num_scalars(rhs));
+  }
+};
+
+struct elementwise_equal
+{
+  template <class Key>
+  auto
+  operator()(Key const& lhs, Key const& rhs) const -> bool
+  {
+    auto a = boost::first_scalar(lhs.data());
+    auto b = boost::first_scalar(rhs.data());
+    return std::equal(a, a + num_scalars(lhs), b, b + num_scalars(rhs));
+  }
+};
+
+auto
+make_byte_keys() -> std::vector<byte_key>
+{
+  auto keys = std::vector<byte_key>();
+  keys.reserve(num_keys);
+  for (std::size_t i = 0; i < num_keys; ++i) {
+    auto const x = (i * 2654435761u) % (num_keys / 4);
+
+    auto key = byte_key(prefix + 1 + x % 16, std::uint8_t{'/'});
+    for (std::size_t j = prefix; j < key.size(); ++j) {
+      key[j] = static_cast<std::uint8_t>(x >> (j - prefix));
+    }
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+auto
+make_word_keys() -> std::vector<word_key>
+{
+  auto keys = std::vector<word_key>();
+  keys.reserve(num_keys);
+  for (std::size_t i = 0; i < num_keys; ++i) {
+    auto const x = static_cast<std::uint32_t>((i * 2654435761u) % (num_keys / 4));
+
+    auto key                = word_key(prefix / 16 + 1, {7, 7, 7, 7});
+    key[prefix / 16][x % 4] = x;
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+// sorts pointers to the keys so the timings are of the comparisons rather than of moving keys
+//
+template <class Key, class Less, class Equal>
+auto
+dedup(std::vector<Key> const& keys, Less less, Equal equal) -> std::size_t
+{
+  auto order = std::vector<Key const*>(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) { order[i] = &keys[i]; }
+
+  std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) { return less(*lhs, *rhs); });
+
+  auto const last = std::unique(order.begin(), order.end(),
+                                [&](auto lhs, auto rhs) { return equal(*lhs, *rhs); });
+  return static_cast<std::size_t>(last - order.begin());
+}
+} // namespace
+
+int
+main()
+{
+  auto const byte_keys = make_byte_keys();
+  auto const word_keys = make_word_keys();
+
+  auto const bytes = num_keys * prefix;
+
+  auto unique = std::size_t{0};
+
+  bench::run("dedup uint8_t keys, element by element", bytes, 5,
+             [&] { unique = dedup(byte_keys, elementwise_less(), elementwise_equal()); });
+  std::printf("%zu unique\n", unique);
+
+  bench::run("dedup uint8_t keys, memcmp", bytes, 5, [&] {
+    unique = dedup(byte_keys, std::less<byte_key>(), std::equal_to<byte_key>());
+  });
+  std::printf("%zu unique\n", unique);
+
+  bench::run("dedup uint32_t[4] keys, element by element", bytes, 5,
+             [&] { unique = dedup(word_keys, elementwise_less(), elementwise_equal()); });
+  std::printf("%zu unique\n", unique);
+
+  bench::run("dedup uint32_t[4] keys, memcmp", bytes, 5, [&] {
+    unique = dedup(word_keys, std::less<word_key>(), std::equal_to<word_key>());
+  });
+  std::printf("%zu unique\n", unique);
+}
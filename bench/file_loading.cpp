@@ -0,0 +1,54 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/mapped_dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+// compares the README's fstream::read into a noinit buffer against mapping the file, both touch
+// every byte afterwards so the mapping's lazy faults are part of its cost
+//
+int
+main()
+{
+  auto const path  = "sleip_bench_file_loading.dat";
+  auto const count = std::size_t{1} << 28;
+
+  {
+    auto a = sleip::mapped_dynamic_array<std::uint8_t>(path, count);
+    std::fill(a.begin(), a.end(), std::uint8_t{1});
+  }
+
+  std::printf("loading a %zu MiB file (warm page cache)\n", count >> 20);
+
+  auto touch = [](auto const& a) {
+    auto const sum = std::accumulate(a.begin(), a.end(), std::uint64_t{0});
+    bench::escape(&sum);
+  };
+
+  bench::run("fstream::read into noinit dynamic_array", count, 5, [&] {
+    auto buff = sleip::dynamic_array<std::uint8_t>(count, sleip::noinit);
+    auto file = std::ifstream(path, std::ios::in | std::ios::binary);
+    file.read(reinterpret_cast<char*>(buff.data()), static_cast<std::streamsize>(buff.size()));
+    touch(buff);
+  });
+
+  bench::run("mapped_dynamic_array", count, 5, [&] {
+    auto const a = sleip::mapped_dynamic_array<std::uint8_t>(path);
+    touch(a);
+  });
+
+  bench::run("mapped_dynamic_array, populate", count, 5, [&] {
+    auto options     = sleip::map_options();
+    options.populate = true;
+
+    auto const a = sleip::mapped_dynamic_array<std::uint8_t>(path, options);
+    touch(a);
+  });
+
+  std::remove(path);
+}
@@ -0,0 +1,114 @@
+#include <sleip/dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+// filling `T[N]` elements one at a time rewrites a 3 byte pattern with 3 byte stores, while
+// `fill()` broadcasts it into a block that stays in L1 and copies the block along
+//
+// past `streaming_fill_bytes` the stores are non-temporal, they reach about the same bandwidth but
+// don't evict the working set, which shows up as the time to re-read it after the fill
+//
+namespace
+{
+using rgb = std::uint8_t[3];
+
+constexpr std::size_t const small_pixels = (std::size_t{4} << 20) / sizeof(rgb);
+constexpr std::size_t const large_pixels = (std::size_t{256} << 20) / sizeof(rgb);
+
+constexpr std::size_t const buffer_words  = (std::size_t{64} << 20) / sizeof(std::uint32_t);
+constexpr std::size_t const working_words = (std::size_t{1} << 20) / sizeof(std::uint32_t);
+
+// the fill as `dynamic_array` used to do it
+//
+auto
+fill_elementwise(sleip::dynamic_array<rgb>& a, rgb const& value) -> void
+{
+  std::for_each(a.begin(), a.end(),
+                [&](auto& px) { std::copy(std::begin(value), std::end(value), std::begin(px)); });
+}
+
+// the best time taken to sum `working` right after `f` has run
+//
+template <class F>
+auto
+reread_after(char const* name, sleip::dynamic_array<std::uint32_t> const& working, F&& f) -> void
+{
+  using clock = std::chrono::steady_clock;
+
+  auto best = std::numeric_limits<double>::max();
+  auto sink = std::uint64_t{0};
+  for (auto i = 0; i < 10; ++i) {
+    sink += std::accumulate(working.begin(), working.end(), std::uint64_t{0});
+    f();
+
+    auto const start = clock::now();
+    sink += std::accumulate(working.begin(), working.end(), std::uint64_t{0});
+    auto const stop = clock::now();
+
+    best = std::min(best, std::chrono::duration<double>(stop - start).count());
+  }
+
+  bench::escape(&sink);
+  std::printf("%-48s %10.3f us\n", name, best * 1e6);
+}
+} // namespace
+
+int
+main()
+{
+  rgb const value = {0x20, 0x40, 0x80};
+
+  auto small = sleip::dynamic_array<rgb>(small_pixels, sleip::noinit);
+  auto large = sleip::dynamic_array<rgb>(large_pixels, sleip::noinit);
+
+  bench::run("fill 4 MiB of rgb, element by element", sizeof(rgb) * small_pixels, 20, [&] {
+    fill_elementwise(small, value);
+    bench::escape(small.data());
+  });
+  bench::run("fill 4 MiB of rgb, fill()", sizeof(rgb) * small_pixels, 20, [&] {
+    small.fill(value);
+    bench::escape(small.data());
+  });
+
+  bench::run("fill 256 MiB of rgb, element by element", sizeof(rgb) * large_pixels, 5, [&] {
+    fill_elementwise(large, value);
+    bench::escape(large.data());
+  });
+  bench::run("fill 256 MiB of rgb, fill() streaming", sizeof(rgb) * large_pixels, 5, [&] {
+    large.fill(value);
+    bench::escape(large.data());
+  });
+
+  auto buffer  = sleip::dynamic_array<std::uint32_t>(buffer_words);
+  auto working = sleip::dynamic_array<std::uint32_t>(working_words, 1);
+
+  auto const bytes = sizeof(std::uint32_t) * buffer_words;
+
+  bench::run("fill 64 MiB of uint32_t, std::fill", bytes, 10, [&] {
+    std::fill(buffer.begin(), buffer.end(), 7u);
+    bench::escape(buffer.data());
+  });
+  bench::run("fill 64 MiB of uint32_t, fill() streaming", bytes, 10, [&] {
+    buffer.fill(7u);
+    bench::escape(buffer.data());
+  });
+
+  reread_after("re-read 1 MiB, nothing in between", working, [] {});
+  reread_after("re-read 1 MiB after std::fill of 64 MiB", working, [&] {
+    std::fill(buffer.begin(), buffer.end(), 7u);
+    bench::escape(buffer.data());
+  });
+  reread_after("re-read 1 MiB after fill() of 64 MiB", working, [&] {
+    buffer.fill(7u);
+    bench::escape(buffer.data());
+  });
+}
@@ -0,0 +1,56 @@
+#include <sleip/array_group.hpp>
+#include <sleip/dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// a kernel that needs six scratch arrays makes six trips to the allocator for them and six more to
+// give them back, `make_dynamic_arrays` makes one of each
+//
+namespace
+{
+constexpr std::size_t const n          = 512;
+constexpr int const         iterations = 200000;
+
+using rgba = std::uint8_t[4];
+
+template <class... Arrays>
+auto
+touch(Arrays&... arrays) -> void
+{
+  (bench::escape(arrays.data()), ...);
+}
+} // namespace
+
+int
+main()
+{
+  std::printf("%d kernel calls, six scratch arrays of %zu elements each\n", iterations, n);
+
+  auto const bytes =
+    iterations * n * (sizeof(float) + sizeof(int) + sizeof(rgba) + sizeof(double) * 2 + 1);
+
+  bench::run("six dynamic_arrays", bytes, 5, [&] {
+    for (auto i = 0; i < iterations; ++i) {
+      auto xs     = sleip::dynamic_array<float>(n, sleip::noinit);
+      auto ids    = sleip::dynamic_array<int>(n, sleip::noinit);
+      auto pixels = sleip::dynamic_array<rgba>(n, sleip::noinit);
+      auto lo     = sleip::dynamic_array<double>(n, sleip::noinit);
+      auto hi     = sleip::dynamic_array<double>(n, sleip::noinit);
+      auto mask   = sleip::dynamic_array<std::uint8_t>(n, sleip::noinit);
+      touch(xs, ids, pixels, lo, hi, mask);
+    }
+  });
+
+  bench::run("make_dynamic_arrays", bytes, 5, [&] {
+    for (auto i = 0; i < iterations; ++i) {
+      auto [xs, ids, pixels, lo, hi, mask] =
+        sleip::make_dynamic_arrays<float, int, rgba, double, double, std::uint8_t>(
+          sleip::noinit, n, n, n, n, n, n);
+      touch(xs, ids, pixels, lo, hi, mask);
+    }
+  });
+}
@@ -0,0 +1,53 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/huge_page_allocator.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// random reads over a table much larger than the TLB's reach, which is where huge pages pay off
+//
+template <class Array>
+auto
+lookup(char const* name, Array const& table) -> void
+{
+  auto const num_lookups = std::size_t{1} << 24;
+  auto const mask        = table.size() - 1;
+
+  bench::run(name, num_lookups * sizeof(std::uint64_t), 5, [&] {
+    auto x   = std::uint64_t{0x9e3779b97f4a7c15};
+    auto sum = std::uint64_t{0};
+    for (std::size_t i = 0; i < num_lookups; ++i) {
+      // xorshift so the access pattern defeats the prefetcher
+      //
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      sum += table[x & mask];
+    }
+    bench::escape(&sum);
+  });
+}
+
+int
+main()
+{
+  auto const count = std::size_t{1} << 27;
+
+  std::printf("random lookups over %zu MiB\n", (count * sizeof(std::uint64_t)) >> 20);
+
+  auto const normal = sleip::dynamic_array<std::uint64_t>(count, 1);
+  lookup("std::allocator", normal);
+
+  auto const huge =
+    sleip::dynamic_array<std::uint64_t, sleip::huge_page_allocator<std::uint64_t>>(count, 1);
+
+  auto const backing = sleip::huge_page_backing_of(huge.data());
+  std::printf("huge_page_allocator backing: %s\n",
+              backing == sleip::huge_page_backing::hugetlb       ? "hugetlb"
+              : backing == sleip::huge_page_backing::transparent ? "transparent"
+                                                                 : "normal");
+  lookup("huge_page_allocator", huge);
+}
@@ -0,0 +1,84 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/jagged_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// an adjacency list as `dynamic_array<dynamic_array<int>>` makes an allocation per row and chases
+// a pointer per row to reach it, copying and destroying it makes an allocator call per row too
+//
+// `jagged_array` keeps every row in one allocation so walking it streams through the offsets and
+// the values, and a copy is two `memcpy`s
+//
+namespace
+{
+constexpr std::size_t const rows = std::size_t{1} << 20;
+
+using nested_type = sleip::dynamic_array<sleip::dynamic_array<std::int32_t>>;
+using jagged_type = sleip::jagged_array<std::int32_t>;
+
+auto
+row_size(std::size_t i) -> std::size_t
+{
+  return (i * 7) % 16;
+}
+
+template <class Array>
+auto
+sum_rows(Array const& a) -> std::int64_t
+{
+  auto sum = std::int64_t{0};
+  for (auto const& row : a) {
+    for (auto const x : row) { sum += x; }
+  }
+  return sum;
+}
+} // namespace
+
+int
+main()
+{
+  auto sizes = std::vector<std::size_t>(rows);
+  auto total = std::size_t{0};
+  for (std::size_t i = 0; i < rows; ++i) {
+    sizes[i] = row_size(i);
+    total += sizes[i];
+  }
+
+  std::printf("%zu rows, %zu int32 values in all\n", rows, total);
+
+  // rows are filled in a scattered order, as they would be when a graph is built edge by edge, so
+  // neighbouring rows don't end up in neighbouring heap blocks
+  //
+  auto nested = nested_type(rows);
+  for (std::size_t k = 0; k < rows; ++k) {
+    auto const i = (k * 40503) % rows;
+    nested[i]    = sleip::dynamic_array<std::int32_t>(sizes[i], static_cast<std::int32_t>(i));
+  }
+
+  auto jagged = jagged_type(nested);
+
+  auto const bytes = total * sizeof(std::int32_t);
+
+  auto sink = std::int64_t{0};
+
+  bench::run("walk rows, dynamic_array<dynamic_array>", bytes, 10,
+             [&] { sink += sum_rows(nested); });
+  bench::run("walk rows, jagged_array", bytes, 10, [&] { sink += sum_rows(jagged); });
+
+  bench::run("copy and destroy, dynamic_array<dynamic_array>", bytes, 5, [&] {
+    auto copy = nested;
+    bench::escape(copy.data());
+  });
+
+  bench::run("copy and destroy, jagged_array", bytes, 5, [&] {
+    auto copy = jagged;
+    bench::escape(copy.data());
+  });
+
+  bench::escape(&sink);
+}
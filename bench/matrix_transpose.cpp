@@ -0,0 +1,76 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array_nd.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+// the textbook double loop reads the source a row at a time but writes the destination a column at
+// a time, touching a new cache line (and, at this size, a new page) for every element
+//
+// `sleip::transpose` walks tiles small enough that both sides stay in L1, and `copy_rect` moves a
+// sub-rectangle a row at a time with `memcpy` instead of element by element
+//
+namespace
+{
+constexpr std::size_t const rows = 3000;
+constexpr std::size_t const cols = 5000;
+
+using matrix = sleip::dynamic_array_nd<float, 2, sleip::cache_aligned_allocator<float>>;
+
+auto
+naive_transpose(matrix const& src, matrix& dst) -> void
+{
+  for (std::size_t i = 0; i < src.extent(0); ++i) {
+    for (std::size_t j = 0; j < src.extent(1); ++j) { dst(j, i) = src(i, j); }
+  }
+}
+
+auto
+naive_copy(sleip::nd_view<float const, 2> const& src, sleip::nd_view<float, 2> const& dst) -> void
+{
+  for (std::size_t i = 0; i < src.extent(0); ++i) {
+    for (std::size_t j = 0; j < src.extent(1); ++j) { dst(i, j) = src(i, j); }
+  }
+}
+} // namespace
+
+int
+main()
+{
+  std::printf("%zu x %zu floats, rows padded to a cache line\n", rows, cols);
+
+  auto const pad = sleip::row_padding{64};
+
+  auto a = matrix({rows, cols}, pad, 1.0f);
+  auto b = matrix({cols, rows}, pad, 0.0f);
+  auto c = matrix({rows, cols}, pad, 0.0f);
+
+  auto const bytes = rows * cols * sizeof(float);
+
+  bench::run("transpose, naive", bytes, 5, [&] {
+    naive_transpose(a, b);
+    bench::escape(b.data());
+  });
+
+  bench::run("transpose, sleip::transpose", bytes, 5, [&] {
+    sleip::transpose(a.cview(), b.view());
+    bench::escape(b.data());
+  });
+
+  auto const origin = matrix::extents_type{100, 100};
+  auto const extent = matrix::extents_type{rows - 200, cols - 200};
+
+  auto const rect_bytes = extent[0] * extent[1] * sizeof(float);
+
+  bench::run("copy_rect, naive", rect_bytes, 5, [&] {
+    naive_copy(a.cview().subview(origin, extent), c.view().subview(origin, extent));
+    bench::escape(c.data());
+  });
+
+  bench::run("copy_rect, sleip::copy_rect", rect_bytes, 5, [&] {
+    sleip::copy_rect(a.cview().subview(origin, extent), c.view().subview(origin, extent));
+    bench::escape(c.data());
+  });
+}
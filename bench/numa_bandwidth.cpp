@@ -0,0 +1,81 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/numa_allocator.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// pin the calling thread to the CPUs of `node` so that "local" and "remote" mean something
+//
+auto
+pin_to_node(int node) -> bool
+{
+#ifdef __linux__
+  auto file = std::ifstream("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+
+  auto list = std::string();
+  if (!std::getline(file, list)) { return false; }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  // cpulist looks like "0-15,32-47"
+  //
+  for (std::size_t pos = 0; pos < list.size();) {
+    auto const comma = std::min(list.find(',', pos), list.size());
+    auto const range = list.substr(pos, comma - pos);
+    auto const dash  = range.find('-');
+
+    auto const lo = std::stoi(range.substr(0, dash));
+    auto const hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+    for (auto cpu = lo; cpu <= hi; ++cpu) { CPU_SET(cpu, &set); }
+
+    pos = comma + 1;
+  }
+
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  static_cast<void>(node);
+  return false;
+#endif
+}
+
+int
+main()
+{
+  using alloc_type = sleip::numa_allocator<std::uint64_t>;
+
+  auto const count     = std::size_t{1} << 26;
+  auto const bytes     = count * sizeof(std::uint64_t);
+  auto const num_nodes = sleip::numa_num_nodes();
+
+  auto const pinned = pin_to_node(0);
+  std::printf("%d node(s), reader %s to node 0, %zu MiB\n", num_nodes,
+              pinned ? "pinned" : "not pinned", bytes >> 20);
+
+  auto read = [&](auto const& a) {
+    auto const sum = std::accumulate(a.begin(), a.end(), std::uint64_t{0});
+    bench::escape(&sum);
+  };
+
+  for (auto node = 0; node < num_nodes; ++node) {
+    auto a = sleip::dynamic_array<std::uint64_t, alloc_type>(
+      count, 1, alloc_type(sleip::numa_policy::bind(node)));
+
+    auto const name = std::string(node == 0 ? "local" : "remote") + " read, bound to node " +
+                      std::to_string(node);
+    bench::run(name.c_str(), bytes, 5, [&] { read(a); });
+  }
+
+  auto a = sleip::dynamic_array<std::uint64_t, alloc_type>(
+    count, 1, alloc_type(sleip::numa_policy::interleave()));
+  bench::run("read, interleaved", bytes, 5, [&] { read(a); });
+}
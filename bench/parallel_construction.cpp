@@ -0,0 +1,48 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/execution.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+
+int
+main()
+{
+  auto const count = std::size_t{1} << 27;
+  auto const bytes = count * sizeof(double);
+
+  std::printf("dynamic_array<double>, %zu MiB, %zu threads\n", bytes >> 20,
+              sleip::par.concurrency());
+
+  bench::run("count + value constructor", bytes, 5, [&] {
+    auto a = sleip::dynamic_array<double>(count, 1.0);
+    bench::escape(a.data());
+  });
+
+  bench::run("count + value constructor, par", bytes, 5, [&] {
+    auto a = sleip::dynamic_array<double>(sleip::par, count, 1.0);
+    bench::escape(a.data());
+  });
+
+  auto a = sleip::dynamic_array<double>(count, sleip::noinit);
+
+  bench::run("fill", bytes, 5, [&] {
+    a.fill(2.0);
+    bench::escape(a.data());
+  });
+
+  bench::run("fill, par", bytes, 5, [&] {
+    a.fill(sleip::par, 2.0);
+    bench::escape(a.data());
+  });
+
+  bench::run("iterator constructor", bytes, 5, [&] {
+    auto b = sleip::dynamic_array<double>(a.begin(), a.end());
+    bench::escape(b.data());
+  });
+
+  bench::run("iterator constructor, par", bytes, 5, [&] {
+    auto b = sleip::dynamic_array<double>(sleip::par, a.begin(), a.end());
+    bench::escape(b.data());
+  });
+}
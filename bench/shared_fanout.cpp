@@ -0,0 +1,117 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/shared_dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// a producer fans every message out to a fixed set of consumers, each of which keeps the payload
+// for a while and reads part of it
+//
+// a deep copy per consumer pays an allocation and a copy of the whole payload for every one of
+// them, `std::shared_ptr<dynamic_array>` pays a second allocation for the control block and a
+// second pointer chase on every read, `shared_dynamic_array` bumps a count in the payload's own
+// allocation
+//
+// the payload is 4 KiB so both shared layouts are past glibc's per-thread cache, a 1 KiB payload
+// plus the 16 byte header would fall just past it while the `shared_ptr` version stays inside
+//
+namespace
+{
+constexpr std::size_t const num_messages  = std::size_t{1} << 14;
+constexpr std::size_t const num_consumers = 8;
+constexpr std::size_t const payload_words = 1024;
+constexpr std::size_t const inbox_size    = 64;
+
+using payload = sleip::dynamic_array<std::uint32_t>;
+
+template <class Message>
+struct consumer
+{
+  std::vector<Message> inbox = std::vector<Message>(inbox_size);
+  std::size_t          next  = 0;
+  std::uint64_t        sum   = 0;
+};
+
+template <class Message>
+auto
+read(Message const& m) -> std::uint64_t
+{
+  if constexpr (std::is_same_v<Message, std::shared_ptr<payload const>>) {
+    return (*m)[0] + (*m)[payload_words - 1];
+  } else {
+    return m[0] + m[payload_words - 1];
+  }
+}
+
+// each consumer holds on to its last `inbox_size` messages so the payloads stay alive across many
+// sends, as they would in a queue
+//
+template <class Message, class Make, class Send>
+auto
+fan_out(char const* name, Make make, Send send) -> void
+{
+  auto consumers = std::vector<consumer<Message>>(num_consumers);
+
+  auto const bytes = num_messages * num_consumers * payload_words * sizeof(std::uint32_t);
+  bench::run(name, bytes, 5, [&] {
+    for (std::size_t i = 0; i < num_messages; ++i) {
+      auto const m = make(static_cast<std::uint32_t>(i));
+      for (auto& c : consumers) {
+        auto& slot = c.inbox[c.next++ % inbox_size];
+        slot       = send(m);
+        c.sum += read(slot);
+      }
+    }
+
+    for (auto const& c : consumers) { bench::escape(&c.sum); }
+  });
+}
+
+auto
+make_payload(std::uint32_t seed) -> payload
+{
+  auto p = payload(payload_words, sleip::noinit);
+  std::iota(p.begin(), p.end(), seed);
+  return p;
+}
+} // namespace
+
+int
+main()
+{
+  // libstdc++ drops the atomics from `std::shared_ptr` until the process starts a second thread,
+  // a fan-out to other threads never sees that case
+  //
+  std::thread([] {}).join();
+
+  fan_out<std::shared_ptr<payload const>>(
+    "std::shared_ptr<dynamic_array>",
+    [](std::uint32_t seed) { return std::make_shared<payload const>(make_payload(seed)); },
+    [](std::shared_ptr<payload const> const& m) { return m; });
+
+  using shared_payload = sleip::shared_dynamic_array<std::uint32_t>;
+
+  fan_out<shared_payload>(
+    "shared_dynamic_array",
+    [](std::uint32_t seed) {
+      auto  p = shared_payload(payload_words, sleip::noinit);
+      auto* d = p.unique_data();
+      std::iota(d, d + payload_words, seed);
+      return p;
+    },
+    [](shared_payload const& m) { return m; });
+
+  // last, its thousands of short-lived copies leave the heap in a state that slows down whatever
+  // runs after it
+  //
+  fan_out<payload>(
+    "deep copy per consumer", [](std::uint32_t seed) { return make_payload(seed); },
+    [](payload const& m) { return m; });
+}
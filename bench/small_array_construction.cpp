@@ -0,0 +1,121 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/small_dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// a node holds a handful of values in its own array, the shape of adjacency lists, small
+// polygons or per-cell particle lists
+//
+// with `dynamic_array` every node points off to its values somewhere else on the heap while the
+// inline buffer of `small_dynamic_array` keeps them in the node itself, so building the nodes saves
+// an allocation apiece and walking them is a linear scan through one block
+//
+namespace
+{
+constexpr std::size_t const num_nodes = 1'000'000;
+constexpr std::size_t const inline_n  = 8;
+
+inline std::size_t num_allocs = 0;
+
+template <class T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  counting_allocator() = default;
+
+  template <class U>
+  counting_allocator(counting_allocator<U> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    ++num_allocs;
+    return std::allocator<T>().allocate(n);
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template <class T, class U>
+auto
+operator==(counting_allocator<T> const&, counting_allocator<U> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U>
+auto
+operator!=(counting_allocator<T> const&, counting_allocator<U> const&) noexcept -> bool
+{
+  return false;
+}
+
+// mostly fits inline with the occasional node that spills to the heap
+//
+auto
+node_size(std::size_t i) -> std::size_t
+{
+  return i % 16 == 0 ? 2 * inline_n : 1 + i % inline_n;
+}
+
+template <class Array>
+auto
+build(std::vector<Array>& nodes) -> void
+{
+  nodes.clear();
+  for (std::size_t i = 0; i < num_nodes; ++i) {
+    nodes.emplace_back(node_size(i), static_cast<int>(i));
+  }
+  bench::escape(nodes.data());
+}
+
+template <class Array>
+auto
+walk(std::vector<Array> const& nodes) -> void
+{
+  auto sum = 0l;
+  for (auto const& n : nodes) { sum = std::accumulate(n.begin(), n.end(), sum); }
+  bench::escape(&sum);
+}
+
+template <class Array>
+auto
+run(char const* name) -> void
+{
+  auto nodes = std::vector<Array>();
+  nodes.reserve(num_nodes);
+
+  auto bytes = std::size_t{0};
+  for (std::size_t i = 0; i < num_nodes; ++i) { bytes += node_size(i) * sizeof(int); }
+
+  num_allocs = 0;
+  build(nodes);
+  std::printf("%s: %zu allocations for %zu nodes, %zu bytes per node\n", name, num_allocs,
+              num_nodes, sizeof(Array));
+
+  auto label = std::string(name);
+  bench::run((label + ", build").c_str(), bytes, 10, [&] { build(nodes); });
+  bench::run((label + ", walk").c_str(), bytes, 10, [&] { walk(nodes); });
+}
+} // namespace
+
+int
+main()
+{
+  run<sleip::dynamic_array<int, counting_allocator<int>>>("dynamic_array");
+  run<sleip::small_dynamic_array<int, inline_n, counting_allocator<int>>>("small_dynamic_array");
+}
@@ -0,0 +1,74 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/soa_dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// a loop that reads two fields of a 64 byte record pulls the whole record through the cache, so 3/4
+// of every line it loads is wasted; with the fields stored as columns every byte loaded is used and
+// the loop vectorizes
+//
+namespace
+{
+struct order
+{
+  double        price      = 0;
+  double        quantity   = 0;
+  std::uint64_t id         = 0;
+  std::uint64_t time       = 0;
+  std::int32_t  side       = 0;
+  std::int32_t  venue      = 0;
+  char          symbol[24] = {};
+};
+
+static_assert(sizeof(order) == 64);
+
+constexpr std::size_t const count = std::size_t{1} << 22;
+} // namespace
+
+int
+main()
+{
+  std::printf("%zu records of %zu bytes, summing price * quantity\n", count, sizeof(order));
+
+  auto aos = sleip::dynamic_array<order>(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    aos[i].price    = static_cast<double>(i % 1000);
+    aos[i].quantity = 0.5;
+  }
+
+  auto soa = sleip::to_soa(aos, &order::price, &order::quantity);
+
+  auto const touched = count * 2 * sizeof(double);
+
+  auto total = 0.0;
+  bench::run("dynamic_array<order>", touched, 10, [&] {
+    auto sum = 0.0;
+    for (auto const& o : aos) { sum += o.price * o.quantity; }
+    total += sum;
+  });
+
+  bench::run("soa_dynamic_array<double, double>", touched, 10, [&] {
+    auto const price    = soa.column<0>();
+    auto const quantity = soa.column<1>();
+
+    auto sum = 0.0;
+    for (std::size_t i = 0; i < price.size(); ++i) { sum += price[i] * quantity[i]; }
+    total += sum;
+  });
+
+  bench::run("to_soa", touched, 10, [&] {
+    auto columns = sleip::to_soa(aos, &order::price, &order::quantity);
+    bench::escape(columns.data<0>());
+  });
+
+  bench::run("scatter", touched, 10, [&] {
+    soa.scatter(aos, &order::price, &order::quantity);
+    bench::escape(aos.data());
+  });
+
+  bench::escape(&total);
+}
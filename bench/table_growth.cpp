@@ -0,0 +1,84 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/zero_page_allocator.hpp>
+
+#include <bench.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+
+// growing a 1 GiB table by half through `reallocate`, once with `std::allocator` which has to
+// allocate the new block, copy into it and free the old one, and once with `zero_page_allocator`
+// which hands the pages to `mremap` and copies nothing
+//
+// the peak resident set during the grow is the other half of the story, a copy holds both blocks
+// at once
+//
+namespace
+{
+constexpr std::size_t const old_count = (std::size_t{1} << 30) / sizeof(std::uint64_t);
+constexpr std::size_t const new_count = old_count + old_count / 2;
+
+// the peak resident set in KiB, which writing "5" to `clear_refs` resets on Linux
+//
+auto
+peak_rss_kib() -> long
+{
+  auto status = std::ifstream("/proc/self/status");
+  auto line   = std::string();
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) { return std::stol(line.substr(6)); }
+  }
+  return -1;
+}
+
+auto
+reset_peak_rss() -> void
+{
+  auto clear_refs = std::ofstream("/proc/self/clear_refs");
+  clear_refs << "5";
+}
+
+template <class Allocator>
+auto
+grow(char const* name) -> void
+{
+  using clock = std::chrono::steady_clock;
+
+  auto best = std::numeric_limits<double>::max();
+  auto peak = long{0};
+  for (auto i = 0; i < 3; ++i) {
+    auto table = sleip::dynamic_array<std::uint64_t, Allocator>(old_count, sleip::noinit);
+    std::fill(table.begin(), table.end(), static_cast<std::uint64_t>(i));
+
+    reset_peak_rss();
+
+    auto const start = clock::now();
+    table.reallocate(new_count, sleip::noinit);
+    auto const stop = clock::now();
+
+    bench::escape(table.data());
+
+    best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    peak = std::max(peak, peak_rss_kib());
+  }
+
+  std::printf("%-48s %10.3f ms %8ld MiB peak\n", name, best * 1e3, peak / 1024);
+}
+} // namespace
+
+int
+main()
+{
+  std::printf("grow %zu MiB to %zu MiB\n", (old_count * sizeof(std::uint64_t)) >> 20,
+              (new_count * sizeof(std::uint64_t)) >> 20);
+
+  grow<std::allocator<std::uint64_t>>("reallocate, std::allocator");
+  grow<sleip::zero_page_allocator<std::uint64_t>>("reallocate, zero_page_allocator (mremap)");
+}
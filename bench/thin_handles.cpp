@@ -0,0 +1,54 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/thin_dynamic_array.hpp>
+
+#include <bench.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <numeric>
+#include <string>
+
+// a sparse table of rows where most rows are empty, e.g. a hash table of buckets or the rows of a
+// sparse matrix, walked from top to bottom
+//
+// the walk is dominated by streaming through the handles themselves so halving their size halves
+// the bytes it touches for every empty row, non-empty rows pay an extra load for their size
+//
+namespace
+{
+constexpr std::size_t const num_rows = std::size_t{1} << 23;
+
+auto
+row_size(std::size_t i) -> std::size_t
+{
+  return i % 32 == 0 ? 4 : 0;
+}
+
+template <class Row>
+auto
+run(char const* name) -> void
+{
+  auto table = sleip::dynamic_array<Row>(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    if (auto const n = row_size(i); n > 0) { table[i] = Row(n, static_cast<int>(i)); }
+  }
+
+  std::printf("%s: %zu bytes per handle\n", name, sizeof(Row));
+
+  // throughput is counted against the 16 byte handle for both so the figures compare directly
+  //
+  auto label = std::string(name);
+  bench::run((label + ", walk").c_str(), num_rows * sizeof(sleip::dynamic_array<int>), 10, [&] {
+    auto sum = 0l;
+    for (auto const& row : table) { sum = std::accumulate(row.begin(), row.end(), sum); }
+    bench::escape(&sum);
+  });
+}
+} // namespace
+
+int
+main()
+{
+  run<sleip::dynamic_array<int>>("dynamic_array");
+  run<sleip::thin_dynamic_array<int>>("thin_dynamic_array");
+}
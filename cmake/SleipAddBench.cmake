@@ -0,0 +1,14 @@
+find_package(Boost 1.71 REQUIRED container)
+find_package(Threads REQUIRED)
+
+function(sleip_add_bench bench_name)
+  add_executable(${bench_name} "${bench_name}.cpp")
+
+  target_link_libraries(${bench_name} PRIVATE dynamic_array Boost::container Threads::Threads)
+  target_include_directories(${bench_name} PRIVATE "${PROJECT_SOURCE_DIR}/bench")
+  set_target_properties(${bench_name} PROPERTIES FOLDER "Bench")
+
+  if (MSVC)
+    target_link_libraries(${bench_name} PRIVATE Boost::disable_autolinking)
+  endif()
+endfunction()
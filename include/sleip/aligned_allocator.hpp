@@ -0,0 +1,81 @@
+#ifndef SLEIP_ALIGNED_ALLOCATOR_HPP_
+#define SLEIP_ALIGNED_ALLOCATOR_HPP_
+
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace sleip
+{
+// an Allocator whose storage is aligned to at least `Align` bytes, e.g. 64 for AVX-512 loads that
+// never split a cache line or 4096 for `O_DIRECT` I/O
+//
+// `dynamic_array` picks up the `alignment` member and annotates `data()` with it so loops over
+// `begin()`/`end()` can be vectorized without a peeling prologue
+//
+template <class T, std::size_t Align>
+struct aligned_allocator
+{
+  using value_type = T;
+
+  using is_always_equal                        = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  static constexpr std::size_t const alignment = Align < alignof(T) ? alignof(T) : Align;
+
+  static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+  template <class U>
+  struct rebind
+  {
+    using other = aligned_allocator<U, Align>;
+  };
+
+  aligned_allocator() = default;
+
+  template <class U>
+  aligned_allocator(aligned_allocator<U, Align> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+  }
+
+  auto
+  deallocate(T* p, std::size_t) noexcept -> void
+  {
+    ::operator delete(p, std::align_val_t{alignment});
+  }
+};
+
+template <class T, class U, std::size_t Align>
+auto
+operator==(aligned_allocator<T, Align> const&, aligned_allocator<U, Align> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U, std::size_t Align>
+auto
+operator!=(aligned_allocator<T, Align> const&, aligned_allocator<U, Align> const&) noexcept -> bool
+{
+  return false;
+}
+
+template <class T>
+using cache_aligned_allocator = aligned_allocator<T, 64>;
+
+template <class T>
+using page_aligned_allocator = aligned_allocator<T, 4096>;
+} // namespace sleip
+
+#endif // SLEIP_ALIGNED_ALLOCATOR_HPP_
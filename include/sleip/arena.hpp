@@ -0,0 +1,222 @@
+#ifndef SLEIP_ARENA_HPP_
+#define SLEIP_ARENA_HPP_
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace sleip
+{
+// a monotonic region of memory that hands out storage by bumping a pointer and gives it all back
+// at once in `release()` or on destruction
+//
+// unlike `std::pmr::monotonic_buffer_resource` it isn't polymorphic so allocation inlines down to
+// an add and a compare, and deallocation only ever has to check whether it can give back the most
+// recent allocation
+//
+// an arena is neither copyable nor movable as every `arena_allocator` refers to it by address, nor
+// is it thread-safe
+//
+struct arena
+{
+private:
+  struct block
+  {
+    block*      prev;
+    std::size_t size;
+  };
+
+  unsigned char* cur_          = nullptr;
+  unsigned char* end_          = nullptr;
+  block*         blocks_       = nullptr;
+  unsigned char* initial_      = nullptr;
+  std::size_t    initial_size_ = 0;
+  std::size_t    block_size_   = 0;
+  std::size_t    next_size_    = 0;
+
+  static auto
+  padding(unsigned char const* p, std::size_t align) noexcept -> std::size_t
+  {
+    return (align - reinterpret_cast<std::uintptr_t>(p) % align) % align;
+  }
+
+  // the slow path, kept out of line so that `allocate` stays small enough to inline everywhere
+  //
+  BOOST_NOINLINE auto
+  grow(std::size_t bytes, std::size_t align) -> void*
+  {
+    auto const overhead = sizeof(block) + align;
+    if (bytes > std::numeric_limits<std::size_t>::max() - overhead) {
+      boost::throw_exception(std::bad_alloc());
+    }
+
+    auto const size = std::max(next_size_, bytes + overhead);
+
+    auto* const b = static_cast<block*>(::operator new(size));
+    b->prev       = blocks_;
+    b->size       = size;
+    blocks_       = b;
+
+    auto* const first = reinterpret_cast<unsigned char*>(b + 1);
+    auto* const p     = first + padding(first, align);
+
+    cur_ = p + bytes;
+    end_ = reinterpret_cast<unsigned char*>(b) + size;
+
+    if (next_size_ <= std::numeric_limits<std::size_t>::max() / 2) { next_size_ *= 2; }
+    return p;
+  }
+
+public:
+  static constexpr std::size_t const default_block_size = std::size_t{64} << 10;
+
+  // blocks are obtained from `::operator new`, starting at `block_size` bytes and doubling
+  //
+  explicit arena(std::size_t block_size = default_block_size) noexcept
+    : block_size_{std::max<std::size_t>(block_size, 2 * sizeof(block))}
+    , next_size_{block_size_}
+  {
+  }
+
+  // serves allocations from the `size` bytes at `buffer` before going to `::operator new`, the
+  // buffer must outlive the arena
+  //
+  arena(void* buffer, std::size_t size, std::size_t block_size = default_block_size) noexcept
+    : cur_{static_cast<unsigned char*>(buffer)}
+    , end_{static_cast<unsigned char*>(buffer) + size}
+    , initial_{static_cast<unsigned char*>(buffer)}
+    , initial_size_{size}
+    , block_size_{std::max<std::size_t>(block_size, 2 * sizeof(block))}
+    , next_size_{block_size_}
+  {
+  }
+
+  arena(arena const&) = delete;
+
+  auto
+  operator=(arena const&) -> arena& = delete;
+
+  ~arena() { release(); }
+
+  auto
+  allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) -> void*
+  {
+    BOOST_ASSERT((align & (align - 1)) == 0);
+
+    auto const space = static_cast<std::size_t>(end_ - cur_);
+    auto const pad   = padding(cur_, align);
+    if (cur_ != nullptr && pad <= space && bytes <= space - pad) {
+      auto* const p = cur_ + pad;
+      cur_          = p + bytes;
+      return p;
+    }
+    return grow(bytes, align);
+  }
+
+  // gives back the storage if it was the most recent allocation, otherwise it's only reclaimed by
+  // `release()`
+  //
+  auto
+  deallocate(void* p, std::size_t bytes) noexcept -> void
+  {
+    if (static_cast<unsigned char*>(p) + bytes == cur_) { cur_ = static_cast<unsigned char*>(p); }
+  }
+
+  // returns every block to `::operator new` and starts over from the initial buffer
+  //
+  // every pointer the arena handed out is invalidated
+  //
+  auto
+  release() noexcept -> void
+  {
+    while (blocks_ != nullptr) {
+      auto* const prev = blocks_->prev;
+      ::operator delete(blocks_);
+      blocks_ = prev;
+    }
+
+    cur_       = initial_;
+    end_       = initial_ + initial_size_;
+    next_size_ = block_size_;
+  }
+
+  // the number of bytes still available before the arena has to get another block
+  //
+  auto
+  remaining() const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(end_ - cur_);
+  }
+};
+
+// an Allocator that draws its storage from an `arena`
+//
+// it has no `construct` so `dynamic_array` keeps its bulk `memcpy`/`memset` paths, and moving an
+// array carries the arena along with it
+//
+template <class T>
+struct arena_allocator
+{
+  using value_type = T;
+
+  using is_always_equal                        = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  arena* arena_;
+
+  arena_allocator(arena& a) noexcept
+    : arena_{&a}
+  {
+  }
+
+  template <class U>
+  arena_allocator(arena_allocator<U> const& other) noexcept
+    : arena_{other.arena_}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    arena_->deallocate(p, n * sizeof(T));
+  }
+
+  auto
+  get_arena() const noexcept -> arena&
+  {
+    return *arena_;
+  }
+};
+
+template <class T, class U>
+auto
+operator==(arena_allocator<T> const& lhs, arena_allocator<U> const& rhs) noexcept -> bool
+{
+  return lhs.arena_ == rhs.arena_;
+}
+
+template <class T, class U>
+auto
+operator!=(arena_allocator<T> const& lhs, arena_allocator<U> const& rhs) noexcept -> bool
+{
+  return !(lhs == rhs);
+}
+} // namespace sleip
+
+#endif // SLEIP_ARENA_HPP_
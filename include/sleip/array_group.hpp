@@ -0,0 +1,412 @@
+#ifndef SLEIP_ARRAY_GROUP_HPP_
+#define SLEIP_ARRAY_GROUP_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+namespace detail
+{
+// every array in a group starts on its own cache line
+//
+inline constexpr std::size_t const group_alignment = 64;
+
+struct alignas(group_alignment) group_unit
+{
+  unsigned char bytes[group_alignment];
+};
+
+// lives in the first units of the block and counts the allocators that still refer to it, the
+// last one to go returns the whole block to the upstream allocator
+//
+// the count is atomic because const use of an array copies its allocator too, e.g.
+// `get_allocator()` or copying the array, and that's expected to be safe from several threads
+//
+struct array_group_header
+{
+  std::atomic<std::size_t> refs      = 0;
+  std::uint64_t            claimed   = 0;
+  std::size_t              num_units = 0;
+
+  auto
+  begin() noexcept -> unsigned char*
+  {
+    return reinterpret_cast<unsigned char*>(this);
+  }
+
+  auto
+  end() noexcept -> unsigned char*
+  {
+    return begin() + num_units * sizeof(group_unit);
+  }
+
+  auto
+  owns(void const* p) noexcept -> bool
+  {
+    auto const* const q = static_cast<unsigned char const*>(p);
+    return std::less_equal<>()(begin(), q) && std::less<>()(q, end());
+  }
+};
+
+inline constexpr std::size_t const group_header_units =
+  (sizeof(array_group_header) + sizeof(group_unit) - 1) / sizeof(group_unit);
+
+inline constexpr std::size_t const no_slot = std::size_t(-1);
+} // namespace detail
+
+// an Allocator handed to each of the arrays built by `make_dynamic_arrays`, all of them share one
+// block obtained from `Allocator`
+//
+// the first `allocate` of the array's own size returns its reserved slot in the block, anything
+// after that, e.g. a copy of the array, goes to `Allocator` as usual
+//
+// the block is given back once, when the last array of the group and every allocator that
+// refers to it are gone, copies of a grouped array don't refer to the group at all
+//
+// like `arena_allocator` it isn't thread-safe, the elements can be used from any thread but the
+// arrays of one group have to be moved and destroyed by one thread at a time
+//
+template <class T, class Allocator = std::allocator<std::byte>>
+struct array_group_allocator
+{
+  using value_type = T;
+
+  using is_always_equal                        = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+
+  static_assert(std::is_pointer_v<typename std::allocator_traits<Allocator>::pointer>,
+                "The upstream allocator must use raw pointers");
+
+private:
+  template <class U, class A>
+  friend struct array_group_allocator;
+
+  template <class U>
+  using upstream_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+  detail::array_group_header* group_  = nullptr;
+  std::size_t                 slot_   = detail::no_slot;
+  std::size_t                 offset_ = 0;
+  std::size_t                 count_  = 0;
+  Allocator                   upstream_;
+
+  auto
+  acquire_() noexcept -> void
+  {
+    if (group_ != nullptr) { group_->refs.fetch_add(1, std::memory_order_relaxed); }
+  }
+
+  auto
+  release_() noexcept -> void
+  {
+    if (group_ == nullptr) { return; }
+    if (group_->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+
+    auto* const block = reinterpret_cast<detail::group_unit*>(group_);
+    auto const  n     = group_->num_units;
+    group_->~array_group_header();
+
+    auto a = upstream_alloc<detail::group_unit>(upstream_);
+    std::allocator_traits<decltype(a)>::deallocate(a, block, n);
+  }
+
+  // kept out of line, after inlining the compiler can't see that a slot never reaches here
+  //
+  BOOST_NOINLINE auto
+  deallocate_upstream_(T* p, std::size_t n) noexcept -> void
+  {
+    auto a = upstream_alloc<T>(upstream_);
+    std::allocator_traits<upstream_alloc<T>>::deallocate(a, p, n);
+  }
+
+public:
+  // only usable when `Allocator` is default constructible, but always declared so that a
+  // `dynamic_array` using it can still ask whether it is
+  //
+  array_group_allocator() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+    : upstream_()
+  {
+  }
+
+  explicit array_group_allocator(Allocator const& upstream) noexcept
+    : upstream_(upstream)
+  {
+  }
+
+  // refers to `group` and reserves the `count` elements at byte `offset` of it for the first
+  // allocation of exactly that many
+  //
+  array_group_allocator(detail::array_group_header* group,
+                        std::size_t                 slot,
+                        std::size_t                 offset,
+                        std::size_t                 count,
+                        Allocator const&            upstream) noexcept
+    : group_{group}
+    , slot_{slot}
+    , offset_{offset}
+    , count_{count}
+    , upstream_(upstream)
+  {
+    acquire_();
+  }
+
+  array_group_allocator(array_group_allocator const& other) noexcept
+    : group_{other.group_}
+    , slot_{other.slot_}
+    , offset_{other.offset_}
+    , count_{other.count_}
+    , upstream_(other.upstream_)
+  {
+    acquire_();
+  }
+
+  // a rebound copy can still give back memory from the group but never claims a slot
+  //
+  template <class U>
+  array_group_allocator(array_group_allocator<U, Allocator> const& other) noexcept
+    : group_{other.group_}
+    , upstream_(other.upstream_)
+  {
+    acquire_();
+  }
+
+  auto
+  operator=(array_group_allocator const& other) noexcept -> array_group_allocator&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    release_();
+    group_    = other.group_;
+    slot_     = other.slot_;
+    offset_   = other.offset_;
+    count_    = other.count_;
+    upstream_ = other.upstream_;
+    acquire_();
+
+    return *this;
+  }
+
+  ~array_group_allocator() { release_(); }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (group_ != nullptr && slot_ != detail::no_slot && n == count_) {
+      auto const bit = std::uint64_t{1} << slot_;
+      if ((group_->claimed & bit) == 0) {
+        group_->claimed |= bit;
+        return reinterpret_cast<T*>(group_->begin() + offset_);
+      }
+    }
+
+    auto a = upstream_alloc<T>(upstream_);
+    return std::allocator_traits<upstream_alloc<T>>::allocate(a, n);
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    if (group_ != nullptr && group_->owns(p)) { return; }
+    deallocate_upstream_(p, n);
+  }
+
+  // copies of a grouped array allocate on their own and don't keep the group alive
+  //
+  auto
+  select_on_container_copy_construction() const -> array_group_allocator
+  {
+    return array_group_allocator(upstream_);
+  }
+
+  auto
+  upstream() const noexcept -> Allocator const&
+  {
+    return upstream_;
+  }
+
+  template <class U, class V, class A>
+  friend auto
+  operator==(array_group_allocator<U, A> const& lhs, array_group_allocator<V, A> const& rhs)
+    -> bool;
+};
+
+// memory from a group can only be given back through an allocator of the same group
+//
+template <class T, class U, class Allocator>
+auto
+operator==(array_group_allocator<T, Allocator> const& lhs,
+           array_group_allocator<U, Allocator> const& rhs) -> bool
+{
+  return lhs.group_ == rhs.group_ && lhs.upstream_ == rhs.upstream_;
+}
+
+template <class T, class U, class Allocator>
+auto
+operator!=(array_group_allocator<T, Allocator> const& lhs,
+           array_group_allocator<U, Allocator> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+template <class T, class Allocator = std::allocator<std::byte>>
+using grouped_dynamic_array = dynamic_array<T, array_group_allocator<T, Allocator>>;
+
+namespace detail
+{
+template <class Allocator, class... Ts, class Init, std::size_t... Is>
+auto
+make_dynamic_arrays(Allocator const&                             alloc,
+                    Init const&                                  init,
+                    std::array<std::size_t, sizeof...(Ts)> const& counts,
+                    std::index_sequence<Is...>)
+  -> std::tuple<grouped_dynamic_array<Ts, Allocator>...>
+{
+  static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 64, "A group holds from 1 to 64 arrays");
+
+  static_assert(((alignof(Ts) <= group_alignment) && ...),
+                "Array elements can't be more aligned than a cache line");
+
+  constexpr std::size_t sizes[] = {sizeof(Ts)...};
+  constexpr auto const  max     = std::numeric_limits<std::size_t>::max();
+
+  // every slot takes at least one unit so that no two arrays, nor the end of the block, share an
+  // address
+  //
+  auto offsets = std::array<std::size_t, sizeof...(Ts)>{};
+  auto units   = group_header_units;
+  for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+    if (counts[i] > (max - sizeof(group_unit)) / sizes[i]) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    auto const n = std::max<std::size_t>(
+      1, (counts[i] * sizes[i] + sizeof(group_unit) - 1) / sizeof(group_unit));
+    if (n > max / sizeof(group_unit) - units) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+
+    offsets[i] = units * sizeof(group_unit);
+    units += n;
+  }
+
+  using unit_allocator =
+    typename std::allocator_traits<Allocator>::template rebind_alloc<group_unit>;
+
+  auto  a      = unit_allocator(alloc);
+  auto* block  = std::allocator_traits<unit_allocator>::allocate(a, units);
+  auto* header = ::new (static_cast<void*>(block)) array_group_header();
+
+  header->num_units = units;
+
+  // `root` holds the group's first reference until every array has its own
+  //
+  auto const root = array_group_allocator<std::byte, Allocator>(header, no_slot, 0, 0, alloc);
+
+  auto arrays = std::tuple<grouped_dynamic_array<Ts, Allocator>...>(
+    init(std::integral_constant<std::size_t, Is>{},
+         array_group_allocator<Ts, Allocator>(header, Is, offsets[Is], counts[Is], alloc))...);
+
+  header->claimed = ~std::uint64_t{0};
+  return arrays;
+}
+
+template <class... Ts>
+struct value_init_arrays
+{
+  std::array<std::size_t, sizeof...(Ts)> const& counts;
+
+  template <std::size_t I, class GroupAllocator>
+  auto
+  operator()(std::integral_constant<std::size_t, I>, GroupAllocator const& alloc) const
+  {
+    using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+    return dynamic_array<T, GroupAllocator>(counts[I], alloc);
+  }
+};
+
+template <class... Ts>
+struct noinit_arrays
+{
+  std::array<std::size_t, sizeof...(Ts)> const& counts;
+
+  template <std::size_t I, class GroupAllocator>
+  auto
+  operator()(std::integral_constant<std::size_t, I>, GroupAllocator const& alloc) const
+  {
+    using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+    return dynamic_array<T, GroupAllocator>(counts[I], noinit, alloc);
+  }
+};
+
+template <class... Counts>
+inline constexpr bool const are_counts_v = (std::is_integral_v<Counts> && ...);
+} // namespace detail
+
+// builds one `dynamic_array<Ts[i]>` of `counts[i]` elements for every type in `Ts...` with a
+// single allocation from `alloc`, the arrays come back as a tuple ready for a structured binding
+//
+//   auto [xs, ids, rgba] = sleip::make_dynamic_arrays<float, int, std::uint8_t[4]>(n, n, m);
+//
+template <class... Ts,
+          class Allocator,
+          class... Counts,
+          std::enable_if_t<detail::are_counts_v<Counts...>, int> = 0>
+auto
+make_dynamic_arrays(std::allocator_arg_t, Allocator const& alloc, Counts... counts)
+  -> std::tuple<grouped_dynamic_array<Ts, Allocator>...>
+{
+  static_assert(sizeof...(Counts) == sizeof...(Ts), "Every array needs exactly one count");
+
+  auto const sizes = std::array<std::size_t, sizeof...(Ts)>{static_cast<std::size_t>(counts)...};
+  return detail::make_dynamic_arrays<Allocator, Ts...>(
+    alloc, detail::value_init_arrays<Ts...>{sizes}, sizes, std::index_sequence_for<Ts...>{});
+}
+
+template <class... Ts,
+          class Allocator,
+          class... Counts,
+          std::enable_if_t<detail::are_counts_v<Counts...>, int> = 0>
+auto
+make_dynamic_arrays(std::allocator_arg_t, Allocator const& alloc, noinit_t, Counts... counts)
+  -> std::tuple<grouped_dynamic_array<Ts, Allocator>...>
+{
+  static_assert(sizeof...(Counts) == sizeof...(Ts), "Every array needs exactly one count");
+
+  auto const sizes = std::array<std::size_t, sizeof...(Ts)>{static_cast<std::size_t>(counts)...};
+  return detail::make_dynamic_arrays<Allocator, Ts...>(
+    alloc, detail::noinit_arrays<Ts...>{sizes}, sizes, std::index_sequence_for<Ts...>{});
+}
+
+template <class... Ts, class... Counts, std::enable_if_t<detail::are_counts_v<Counts...>, int> = 0>
+auto
+make_dynamic_arrays(Counts... counts) -> std::tuple<grouped_dynamic_array<Ts>...>
+{
+  return make_dynamic_arrays<Ts...>(std::allocator_arg, std::allocator<std::byte>(), counts...);
+}
+
+template <class... Ts, class... Counts, std::enable_if_t<detail::are_counts_v<Counts...>, int> = 0>
+auto
+make_dynamic_arrays(noinit_t, Counts... counts) -> std::tuple<grouped_dynamic_array<Ts>...>
+{
+  return make_dynamic_arrays<Ts...>(std::allocator_arg, std::allocator<std::byte>(), noinit,
+                                    counts...);
+}
+} // namespace sleip
+
+#endif // SLEIP_ARRAY_GROUP_HPP_
@@ -21,13 +21,53 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#else
+#define SLEIP_NO_STREAMING_STORES
+#endif
+
 namespace sleip
 {
+// customization point: specialize for types where moving an object to a new address and ending the
+// lifetime of the old one is equivalent to a `std::memcpy` of its bytes, i.e. types that don't
+// store pointers back into themselves
+//
+// trivially copyable types are trivially relocatable by default, as are bound arrays of trivially
+// relocatable types
+//
+template <class T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <class T, std::size_t N>
+struct is_trivially_relocatable<T[N]> : is_trivially_relocatable<T>
+{
+};
+
+template <class T>
+inline constexpr bool const is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// customization point: specialize for types that can run the chunks of a parallel construction or
+// fill, see <sleip/execution.hpp> for the requirements and the policies we ship
+//
+template <class T>
+struct is_execution_policy : std::false_type
+{
+};
+
+template <class T>
+inline constexpr bool const is_execution_policy_v = is_execution_policy<T>::value;
+
 namespace detail
 {
 template <class T>
@@ -86,6 +126,134 @@ struct array_walker
   }
 };
 
+// an Allocator that supplies its own `construct` can observe or alter element construction so we
+// can only bypass it when it's absent
+//
+// `std::allocator<T>::construct` still exists in C++17 but it's only ever placement new so we treat
+// it as though it didn't
+//
+template <class Allocator, class U>
+using construct_expr_ =
+  decltype(std::declval<Allocator&>().construct(std::declval<U*>(), std::declval<U const&>()));
+
+template <class Allocator>
+struct has_construct
+  : boost::mp11::mp_valid<construct_expr_, Allocator,
+                          std::remove_all_extents_t<typename Allocator::value_type>>
+{
+};
+
+template <class T>
+struct has_construct<std::allocator<T>> : boost::mp11::mp_false
+{
+};
+
+// an Allocator may opt into supplying zero-filled storage by providing
+// `pointer allocate_zeroed(size_type n)`
+//
+template <class Allocator>
+using allocate_zeroed_expr_ =
+  decltype(std::declval<Allocator&>().allocate_zeroed(std::declval<std::size_t>()));
+
+template <class Allocator>
+using has_allocate_zeroed = boost::mp11::mp_valid<allocate_zeroed_expr_, Allocator>;
+
+// an Allocator may opt into resizing a block in place, or moving its pages without copying them, by
+// providing `pointer reallocate(pointer p, size_type old_n, size_type new_n) noexcept`
+//
+// it returns null and leaves the block alone when it can't, and an Allocator that also has
+// `allocate_zeroed` must hand back zero-filled storage past the old size
+//
+template <class Allocator>
+using reallocate_expr_ = decltype(std::declval<Allocator&>().reallocate(
+  std::declval<typename std::allocator_traits<Allocator>::pointer>(), std::declval<std::size_t>(),
+  std::declval<std::size_t>()));
+
+template <class Allocator>
+using has_reallocate = boost::mp11::mp_valid<reallocate_expr_, Allocator>;
+
+// an Allocator whose `deallocate` releases storage the same way a deleter does can say so with a
+// `deleter_type` member, which lets a `std::unique_ptr<T[], deleter_type>` be adopted as is
+//
+template <class Allocator>
+using deleter_type_expr_ = typename Allocator::deleter_type;
+
+template <class Allocator, class Deleter>
+inline constexpr bool const is_adoptable_deleter_v =
+  std::is_same_v<boost::mp11::mp_eval_or<void, deleter_type_expr_, Allocator>, Deleter>;
+
+// member pointers are the only scalars whose null value isn't all-zero bytes on the platforms we
+// care about
+//
+template <class T, class Allocator>
+inline constexpr bool const is_zero_allocatable_v =
+  has_allocate_zeroed<Allocator>::value && !has_construct<Allocator>::value &&
+  std::is_scalar_v<std::remove_all_extents_t<T>> &&
+  !std::is_member_pointer_v<std::remove_all_extents_t<T>>;
+
+template <class T, class Allocator>
+inline constexpr bool const is_bulk_copyable_v =
+  std::is_trivially_copyable_v<T> && !has_construct<Allocator>::value;
+
+// uses-allocator types expect to be told about the container's allocator when they're constructed
+// so a byte copy would leave them pointing at the old one
+//
+template <class T, class Allocator>
+inline constexpr bool const is_bulk_relocatable_v =
+  is_trivially_relocatable_v<T> && !std::uses_allocator_v<std::remove_all_extents_t<T>, Allocator>;
+
+// contiguous sources let us walk `T[N]` elements as a single run of `N * count` scalars instead of
+// going through `array_walker`
+//
+template <class It, class T>
+inline constexpr bool const is_contiguous_iterator_v =
+#ifdef __cpp_lib_concepts
+  std::contiguous_iterator<It> &&
+  std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, std::remove_cv_t<T>>;
+#else
+  std::is_same_v<It, T*> || std::is_same_v<It, T const*>;
+#endif
+
+template <class T>
+inline constexpr bool const is_nothrow_copy_assignable_v =
+  std::is_nothrow_copy_assignable_v<std::remove_all_extents_t<T>>;
+
+// an Allocator may advertise that its storage is over-aligned with a
+// `static constexpr std::size_t alignment` member which lets us tell the optimizer about it
+//
+template <class Allocator>
+using alignment_expr_ = std::integral_constant<std::size_t, Allocator::alignment>;
+
+template <class Allocator>
+inline constexpr std::size_t const allocator_alignment_v = boost::mp11::mp_eval_or<
+  std::integral_constant<std::size_t, alignof(typename Allocator::value_type)>,
+  alignment_expr_,
+  Allocator>::value;
+
+template <std::size_t Align, class T>
+auto
+assume_aligned(T* p) noexcept -> T*
+{
+#if defined(__cpp_lib_assume_aligned)
+  return std::assume_aligned<Align>(p);
+#elif defined(BOOST_GCC) || defined(BOOST_CLANG)
+  return static_cast<T*>(__builtin_assume_aligned(p, Align));
+#else
+  return p;
+#endif
+}
+
+template <class It>
+auto
+to_address(It const& it) noexcept
+{
+#ifdef __cpp_lib_concepts
+  return std::to_address(it);
+#else
+  return it;
+#endif
+}
+
 template <class It, class To>
 using is_category_convertible_ =
   std::is_convertible<typename std::iterator_traits<It>::iterator_category, To>;
@@ -132,6 +300,272 @@ using is_range = boost::mp11::mp_eval_or<boost::mp11::mp_false, has_begin_end, R
 template <class Range>
 inline constexpr bool const is_range_v = is_range<Range>::value;
 
+// below this many bytes per chunk, the cost of handing work to another thread outweighs the work
+//
+inline constexpr std::size_t const min_chunk_bytes = std::size_t{1} << 16;
+
+template <class T>
+auto
+num_chunks(std::size_t const concurrency, std::size_t const count) noexcept -> std::size_t
+{
+  auto const max_chunks = std::max<std::size_t>(1, count * sizeof(T) / min_chunk_bytes);
+  return std::max<std::size_t>(1, std::min(concurrency, max_chunks));
+}
+
+// an allocator with its own `construct`, or elements that take an allocator, may allocate from a
+// resource that isn't synchronized such as `monotonic_buffer_resource`, so the policy overloads
+// build those elements as a single chunk instead of concurrently
+//
+template <class T, class Allocator>
+inline constexpr bool const is_concurrently_constructible_v =
+  !has_construct<Allocator>::value &&
+  !std::uses_allocator_v<std::remove_all_extents_t<T>, Allocator>;
+
+// assigning to an element that holds an allocator may allocate from its resource, the same goes
+// for the policy overload of `fill`
+//
+template <class T, class Allocator>
+inline constexpr bool const is_concurrently_assignable_v =
+  !std::uses_allocator_v<std::remove_all_extents_t<T>, Allocator>;
+
+// the half-open range of elements covered by chunk `idx` when `count` elements are split as evenly
+// as possible into `num_chunks` pieces
+//
+inline auto
+chunk_bounds(std::size_t const count, std::size_t const num_chunks, std::size_t const idx) noexcept
+  -> std::pair<std::size_t, std::size_t>
+{
+  auto const q = count / num_chunks;
+  auto const r = count % num_chunks;
+
+  auto const first = idx * q + std::min(idx, r);
+  return {first, first + q + (idx < r ? 1 : 0)};
+}
+
+// a fill this large won't fit in the caches anyway so its stores go around them, which leaves the
+// rest of the working set where it was
+//
+inline constexpr std::size_t const streaming_fill_bytes = std::size_t{1} << 24;
+
+template <class T>
+inline constexpr bool const is_pattern_fillable_v =
+  std::is_trivially_copyable_v<T> &&
+  std::is_trivially_copy_assignable_v<std::remove_all_extents_t<T>>;
+
+template <class T>
+auto
+is_streaming_fill(std::size_t const count) noexcept -> bool
+{
+  return is_pattern_fillable_v<T> && count >= streaming_fill_bytes / sizeof(T);
+}
+
+// the first `filled` bytes at `p` hold whole copies of the pattern, they're doubled until they
+// make a block that stays in L1 and the block is then copied along the rest of the range
+//
+inline auto
+replicate_pattern(unsigned char* p, std::size_t filled, std::size_t const num_bytes) noexcept
+  -> void
+{
+  constexpr std::size_t const max_block = std::size_t{1} << 14;
+
+  while (filled < num_bytes && filled < max_block) {
+    auto const n = std::min(filled, num_bytes - filled);
+    std::memcpy(p + filled, p, n);
+    filled += n;
+  }
+
+  auto const block = filled;
+  while (filled < num_bytes) {
+    auto const n = std::min(block, num_bytes - filled);
+    std::memcpy(p + filled, p, n);
+    filled += n;
+  }
+}
+
+#ifndef SLEIP_NO_STREAMING_STORES
+// once the bytes up to the first cache line boundary and one block after it are written normally,
+// the block is a cache-aligned run of whole patterns that the non-temporal stores copy from
+//
+inline auto
+stream_pattern(unsigned char* p, std::size_t const period, std::size_t const num_bytes) noexcept
+  -> void
+{
+  constexpr std::size_t const line      = 64;
+  constexpr std::size_t const max_block = std::size_t{1} << 12;
+
+  auto const head  = (line - reinterpret_cast<std::uintptr_t>(p) % line) % line;
+  auto const block = std::lcm(period, line);
+  if (block > max_block || num_bytes < head + 2 * block) {
+    replicate_pattern(p, period, num_bytes);
+    return;
+  }
+
+  replicate_pattern(p, period, head + block);
+
+  auto const* const src = p + head;
+
+  auto* dst       = p + head + block;
+  auto  remaining = num_bytes - head - block;
+  for (; remaining >= block; remaining -= block, dst += block) {
+    for (std::size_t idx = 0; idx < block; idx += sizeof(__m128i)) {
+      auto const x = _mm_load_si128(reinterpret_cast<__m128i const*>(src + idx));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + idx), x);
+    }
+  }
+  std::memcpy(dst, src, remaining);
+
+  // non-temporal stores are weakly ordered, fence them before anyone else can look at the range
+  //
+  _mm_sfence();
+}
+#endif
+
+// scalars already become `memset` or a vectorized loop under `std::fill`, but `T[N]` and
+// trivially copyable classes are written one element at a time so we broadcast the pattern
+// with `memcpy` instead
+//
+template <class T>
+auto
+fill_elements(T* first, std::size_t const count, T const& value, bool const streaming) -> void
+{
+  if (count == 0) { return; }
+
+  if constexpr (is_pattern_fillable_v<T>) {
+    if constexpr (std::is_scalar_v<T>) {
+      if (!streaming) {
+        std::fill(first, first + count, value);
+        return;
+      }
+    }
+
+    auto* const p         = reinterpret_cast<unsigned char*>(first);
+    auto const  num_bytes = count * sizeof(T);
+
+    // `value` may be one of the elements being filled
+    //
+    std::memmove(p, std::addressof(value), sizeof(T));
+
+#ifndef SLEIP_NO_STREAMING_STORES
+    if (streaming) {
+      stream_pattern(p, sizeof(T), num_bytes);
+      return;
+    }
+#endif
+    replicate_pattern(p, sizeof(T), num_bytes);
+  } else if constexpr (std::is_array_v<T>) {
+    std::for_each(first, first + count, [&](auto& arr) {
+      std::copy(std::begin(value), std::end(value), std::begin(arr));
+    });
+  } else {
+    std::fill(first, first + count, value);
+  }
+}
+
+// scalars with unique object representations are equal exactly when their bytes are, which rules
+// out floating point where `-0.0 == 0.0` and NaN never equals itself
+//
+template <class T>
+inline constexpr bool const is_bytewise_comparable_v =
+  std::is_scalar_v<std::remove_all_extents_t<T>> &&
+  std::has_unique_object_representations_v<std::remove_all_extents_t<T>>;
+
+// `memcmp` compares bytes as `unsigned char` so its ordering only agrees with the element's own
+// for single unsigned bytes
+//
+template <class T, class U = std::remove_cv_t<std::remove_all_extents_t<T>>>
+inline constexpr bool const is_bytewise_ordered_v =
+  std::is_same_v<U, unsigned char> || std::is_same_v<U, std::byte> ||
+#ifdef __cpp_char8_t
+  std::is_same_v<U, char8_t> ||
+#endif
+  (std::is_same_v<U, char> && std::is_unsigned_v<char>);
+
+// the index of the first scalar that differs, found by comparing whole blocks with `memcmp` and
+// only looking at single scalars inside the block that differs
+//
+template <class U>
+auto
+bytewise_mismatch(U const* a, U const* b, std::size_t const count) noexcept -> std::size_t
+{
+  constexpr std::size_t const block = sizeof(U) < 256 ? 256 / sizeof(U) : 1;
+
+  auto idx = std::size_t{0};
+  for (; count - idx >= block; idx += block) {
+    if (std::memcmp(a + idx, b + idx, block * sizeof(U)) != 0) { break; }
+  }
+
+  while (idx < count && a[idx] == b[idx]) { ++idx; }
+  return idx;
+}
+
+template <class T>
+auto
+elements_equal(T const* a, T const* b, std::size_t const count) -> bool
+{
+  if constexpr (is_bytewise_comparable_v<T>) {
+    return count == 0 || std::memcmp(a, b, count * sizeof(T)) == 0;
+  } else {
+    auto x = boost::first_scalar(a);
+    auto y = boost::first_scalar(b);
+    return std::equal(x, x + num_elems<T>(count), y);
+  }
+}
+
+// `T[N]` elements are made of the same number of scalars so comparing the scalars
+// lexicographically orders the elements lexicographically too
+//
+template <class T>
+auto
+elements_less(T const* a, std::size_t const a_count, T const* b, std::size_t const b_count)
+  -> bool
+{
+  auto const count = std::min(a_count, b_count);
+
+  if constexpr (is_bytewise_ordered_v<T>) {
+    auto const r = count == 0 ? 0 : std::memcmp(a, b, count * sizeof(T));
+    return r < 0 || (r == 0 && a_count < b_count);
+  } else if constexpr (is_bytewise_comparable_v<T>) {
+    auto x = boost::first_scalar(a);
+    auto y = boost::first_scalar(b);
+
+    auto const num_scalars = num_elems<T>(count);
+    auto const idx         = bytewise_mismatch(x, y, num_scalars);
+    return idx < num_scalars ? x[idx] < y[idx] : a_count < b_count;
+  } else {
+    auto x = boost::first_scalar(a);
+    auto y = boost::first_scalar(b);
+    return std::lexicographical_compare(x, x + num_elems<T>(a_count), y,
+                                        y + num_elems<T>(b_count));
+  }
+}
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T>
+auto
+elements_three_way(T const* a, std::size_t const a_count, T const* b, std::size_t const b_count)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  auto const count = std::min(a_count, b_count);
+
+  if constexpr (is_bytewise_ordered_v<T>) {
+    auto const r = count == 0 ? 0 : std::memcmp(a, b, count * sizeof(T));
+    return r != 0 ? r <=> 0 : a_count <=> b_count;
+  } else if constexpr (is_bytewise_comparable_v<T>) {
+    auto x = boost::first_scalar(a);
+    auto y = boost::first_scalar(b);
+
+    auto const num_scalars = num_elems<T>(count);
+    auto const idx         = bytewise_mismatch(x, y, num_scalars);
+    return idx < num_scalars ? x[idx] <=> y[idx] : a_count <=> b_count;
+  } else {
+    auto x = boost::first_scalar(a);
+    auto y = boost::first_scalar(b);
+    return std::lexicographical_compare_three_way(x, x + num_elems<T>(a_count), y,
+                                                  y + num_elems<T>(b_count));
+  }
+}
+#endif
+
 } // namespace detail
 
 struct noinit_t
@@ -140,6 +574,85 @@ struct noinit_t
 
 inline constexpr noinit_t noinit;
 
+// tags the constructors that take ownership of storage that was allocated somewhere else
+//
+struct adopt_t
+{
+};
+
+inline constexpr adopt_t adopt;
+
+// a run of contiguous elements inside a larger allocation, such as one column of a
+// `soa_dynamic_array` or one row of a `jagged_array`
+//
+// it's a contiguous sized range so under C++20 it converts to `std::span<T>` directly
+//
+template <class T>
+struct column_span
+{
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<T>;
+  using size_type    = std::size_t;
+  using iterator     = T*;
+
+private:
+  T*          data_ = nullptr;
+  std::size_t size_ = 0;
+
+public:
+  column_span() = default;
+
+  column_span(T* data, std::size_t size) noexcept
+    : data_{data}
+    , size_{size}
+  {
+  }
+
+  template <class U, std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>, int> = 0>
+  column_span(column_span<U> const& other) noexcept
+    : data_{other.data()}
+    , size_{other.size()}
+  {
+  }
+
+  auto
+  data() const noexcept -> T*
+  {
+    return data_;
+  }
+
+  auto
+  size() const noexcept -> std::size_t
+  {
+    return size_;
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  auto
+  begin() const noexcept -> iterator
+  {
+    return data_;
+  }
+
+  auto
+  end() const noexcept -> iterator
+  {
+    return data_ + size_;
+  }
+
+  auto operator[](std::size_t pos) const noexcept -> T&
+  {
+    BOOST_ASSERT(pos < size_);
+    return data_[pos];
+  }
+};
+
 template <class T, class Allocator>
 struct dynamic_array : boost::empty_value<Allocator>
 {
@@ -164,6 +677,16 @@ public:
   static_assert(std::is_same_v<typename allocator_type::value_type, value_type>,
                 "Allocator's value type must match container's");
 
+  // what `release()` hands back, the caller destroys the `size` elements at `data` and then
+  // deallocates them with `allocator`
+  //
+  struct release_type
+  {
+    pointer        data;
+    size_type      size;
+    allocator_type allocator;
+  };
+
 private:
   pointer     data_ = nullptr;
   std::size_t size_ = 0;
@@ -172,6 +695,17 @@ private:
   static pointer
   create_(Allocator_& alloc, std::size_t count, Args&&... args)
   {
+    // value-initialization of a scalar is all-zero bytes so an allocator that can hand us memory
+    // that's already zeroed lets us skip touching every page
+    //
+    // `noinit_adaptor<Allocator>` inherits `allocate_zeroed` but default-initialization has no use
+    // for it
+    //
+    if constexpr (sizeof...(Args) == 0 && std::is_same_v<Allocator_, Allocator> &&
+                  detail::is_zero_allocatable_v<T, Allocator>) {
+      return alloc.allocate_zeroed(count);
+    }
+
     pointer data = std::allocator_traits<Allocator>::allocate(alloc, count);
     try {
       auto* const p = boost::first_scalar(boost::to_address(data));
@@ -184,6 +718,89 @@ private:
     return data;
   }
 
+  // same as `create_` with a source range of `[src, src + count)` but in the case where the element
+  // construction is unobservable, we can skip the per-scalar loop and copy the whole buffer at once
+  //
+  template <typename Allocator_>
+  static pointer
+  copy_create_(Allocator_& alloc, std::size_t count, T const* src)
+  {
+    if constexpr (detail::is_bulk_copyable_v<T, Allocator_>) {
+      pointer data = std::allocator_traits<Allocator>::allocate(alloc, count);
+      if (count > 0) { std::memcpy(boost::to_address(data), src, count * sizeof(T)); }
+      return data;
+    } else {
+      return create_(alloc, count, boost::first_scalar(src));
+    }
+  }
+
+  // splits `count` elements into chunks which `policy` constructs concurrently, each chunk is built
+  // by `construct_chunk(p, first, last)` which must clean up after itself if it throws
+  //
+  // chunks that completed are tracked so that a failure anywhere unwinds exactly what was built
+  //
+  template <class ExecutionPolicy, typename Allocator_, class ConstructChunk>
+  static pointer
+  par_create_(ExecutionPolicy const& policy,
+              Allocator_&            alloc,
+              std::size_t            count,
+              ConstructChunk const&  construct_chunk)
+  {
+    auto const num_chunks = detail::is_concurrently_constructible_v<T, Allocator>
+                              ? detail::num_chunks<T>(policy.concurrency(), count)
+                              : std::size_t{1};
+    auto       built      = std::unique_ptr<bool[]>(new bool[num_chunks]());
+
+    pointer data = std::allocator_traits<Allocator>::allocate(alloc, count);
+
+    auto* const p = boost::first_scalar(boost::to_address(data));
+    try {
+      policy.bulk(num_chunks, [&](std::size_t const idx) {
+        auto const [first, last] = detail::chunk_bounds(count, num_chunks, idx);
+        construct_chunk(p, first, last);
+        built[idx] = true;
+      });
+    }
+    catch (...) {
+      for (std::size_t idx = 0; idx < num_chunks; ++idx) {
+        if (!built[idx]) { continue; }
+
+        auto const [first, last] = detail::chunk_bounds(count, num_chunks, idx);
+        boost::alloc_destroy_n(alloc, p + detail::num_elems<T>(first),
+                               detail::num_elems<T>(last - first));
+      }
+      std::allocator_traits<Allocator>::deallocate(alloc, data, count);
+      throw;
+    }
+    return data;
+  }
+
+  // relocate the elements of `other` into a fresh allocation from `alloc` and release `other`'s
+  // storage without running any destructors, the lifetimes of the old elements end with the copy
+  //
+  template <typename Allocator_>
+  static pointer
+  relocate_create_(Allocator_& alloc, dynamic_array& other)
+  {
+    static_assert(detail::is_bulk_relocatable_v<T, Allocator>);
+
+    pointer data = std::allocator_traits<Allocator>::allocate(alloc, other.size_);
+    if (other.size_ > 0) {
+      std::memcpy(static_cast<void*>(boost::to_address(data)), other.data(),
+                  other.size_ * sizeof(T));
+    }
+
+    if (other.data_ != nullptr) {
+      auto& other_alloc = static_cast<boost::empty_value<Allocator>&>(other).get();
+      std::allocator_traits<Allocator>::deallocate(other_alloc, other.data_, other.size_);
+    }
+
+    other.data_ = nullptr;
+    other.size_ = 0;
+
+    return data;
+  }
+
   template <typename Allocator_>
   static void
   destroy_(Allocator_& alloc, pointer data, std::size_t count)
@@ -196,6 +813,117 @@ private:
     std::allocator_traits<Allocator>::deallocate(alloc, data, count);
   }
 
+  // the allocator can only move the block's bytes, so the new elements must be constructible
+  // without throwing and the ones dropped by a shrink must have nothing to destroy
+  //
+  static constexpr bool const is_reallocatable_in_place_ =
+    detail::has_reallocate<Allocator>::value && detail::is_bulk_relocatable_v<T, Allocator> &&
+    !detail::has_construct<Allocator>::value &&
+    std::is_nothrow_default_constructible_v<std::remove_all_extents_t<T>> &&
+    std::is_trivially_destructible_v<std::remove_all_extents_t<T>>;
+
+  // `alloc` decides how the new elements are initialized, the allocation and the moves always go
+  // through our own allocator
+  //
+  template <typename Allocator_>
+  auto
+  reallocate_(Allocator_& alloc, std::size_t const count) -> void
+  {
+    auto& alloc_ = boost::empty_value<Allocator>::get();
+
+    if (count == size_) { return; }
+
+    if (data_ == nullptr || count == 0) {
+      pointer data = create_(alloc, count);
+      destroy_(alloc_, data_, size_);
+
+      data_ = data;
+      size_ = count;
+      return;
+    }
+
+    constexpr bool const zeroed =
+      std::is_same_v<Allocator_, Allocator> && detail::is_zero_allocatable_v<T, Allocator>;
+
+    auto const keep = std::min(size_, count);
+
+    if constexpr (is_reallocatable_in_place_) {
+      pointer data = alloc_.reallocate(data_, size_, count);
+      if (data != nullptr) {
+        if constexpr (!zeroed) {
+          auto* const p = boost::first_scalar(boost::to_address(data));
+          boost::alloc_construct_n(alloc, p + detail::num_elems<T>(keep),
+                                   detail::num_elems<T>(count - keep));
+        }
+
+        data_ = data;
+        size_ = count;
+        return;
+      }
+    }
+
+    pointer data = nullptr;
+    if constexpr (zeroed) {
+      data = alloc_.allocate_zeroed(count);
+    } else {
+      data = std::allocator_traits<Allocator>::allocate(alloc_, count);
+    }
+
+    auto* const p    = boost::first_scalar(boost::to_address(data));
+    auto* const tail = p + detail::num_elems<T>(keep);
+    try {
+      if constexpr (!zeroed) {
+        boost::alloc_construct_n(alloc, tail, detail::num_elems<T>(count - keep));
+      }
+    }
+    catch (...) {
+      std::allocator_traits<Allocator>::deallocate(alloc_, data, count);
+      throw;
+    }
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      std::memcpy(static_cast<void*>(boost::to_address(data)), boost::to_address(data_),
+                  keep * sizeof(T));
+
+      // the kept elements now live in the new block, only the ones past them are destroyed
+      //
+      auto* const old = boost::first_scalar(boost::to_address(data_));
+      boost::alloc_destroy_n(alloc_, old + detail::num_elems<T>(keep),
+                             detail::num_elems<T>(size_ - keep));
+      std::allocator_traits<Allocator>::deallocate(alloc_, data_, size_);
+    } else {
+      try {
+        boost::alloc_construct_n(alloc_, p, detail::num_elems<T>(keep),
+                                 detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                                   boost::first_scalar(boost::to_address(data_))});
+      }
+      catch (...) {
+        boost::alloc_destroy_n(alloc_, tail, detail::num_elems<T>(count - keep));
+        std::allocator_traits<Allocator>::deallocate(alloc_, data, count);
+        throw;
+      }
+      destroy_(alloc_, data_, size_);
+    }
+
+    data_ = data;
+    size_ = count;
+  }
+
+  // overwrite the current elements with `[src, src + size())` without touching the allocation
+  //
+  // only used when `T`'s copy assignment can't throw so the strong exception guarantee is preserved
+  //
+  auto
+  assign_in_place_(T const* src) noexcept -> void
+  {
+    static_assert(detail::is_nothrow_copy_assignable_v<T>);
+
+    if (size_ == 0 || boost::to_address(data_) == src) { return; }
+
+    auto const* const first = boost::first_scalar(src);
+    std::copy(first, first + detail::num_elems<T>(size_), boost::first_scalar(data()));
+  }
+
 public:
   dynamic_array() noexcept(noexcept(Allocator()))
     : boost::empty_value<Allocator>(boost::empty_init_t{}){};
@@ -242,8 +970,64 @@ public:
     auto const count = static_cast<size_type>(std::distance(first, last));
 
     auto& alloc_ = boost::empty_value<Allocator>::get();
-    data_        = create_(alloc_, count, detail::array_walker<ForwardIterator>{first});
-    size_        = count;
+    if constexpr (detail::is_contiguous_iterator_v<ForwardIterator, T>) {
+      data_ = copy_create_(alloc_, count, detail::to_address(first));
+    } else {
+      data_ = create_(alloc_, count, detail::array_walker<ForwardIterator>{first});
+    }
+    size_ = count;
+  }
+
+  // the parallel overloads construct each chunk of the buffer on the thread that `policy` assigns
+  // it to which, under a first-touch NUMA policy, also decides where those pages live
+  //
+  template <class ExecutionPolicy,
+            std::enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy>>, int> = 0>
+  dynamic_array(ExecutionPolicy&& policy,
+                size_type         count,
+                T const&          value,
+                Allocator const&  alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto& alloc_ = boost::empty_value<Allocator>::get();
+    data_ = par_create_(policy, alloc_, count, [&](auto* p, std::size_t lo, std::size_t hi) {
+      boost::alloc_construct_n(alloc_, p + detail::num_elems<T>(lo), detail::num_elems<T>(hi - lo),
+                               boost::first_scalar(std::addressof(value)), detail::num_elems<T>(1));
+    });
+    size_ = count;
+  }
+
+  template <class ExecutionPolicy,
+            class ForwardIterator,
+            std::enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy>> &&
+                               detail::is_forward_iterator_v<ForwardIterator>,
+                             int> = 0>
+  dynamic_array(ExecutionPolicy&& policy,
+                ForwardIterator   first,
+                ForwardIterator   last,
+                Allocator const&  alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto const count = static_cast<size_type>(std::distance(first, last));
+
+    auto& alloc_ = boost::empty_value<Allocator>::get();
+    data_ = par_create_(policy, alloc_, count, [&](auto* p, std::size_t lo, std::size_t hi) {
+      auto* const dst = p + detail::num_elems<T>(lo);
+      auto const  n   = detail::num_elems<T>(hi - lo);
+
+      if constexpr (detail::is_contiguous_iterator_v<ForwardIterator, T>) {
+        auto const* const src = boost::first_scalar(detail::to_address(first)) + (dst - p);
+        if constexpr (detail::is_bulk_copyable_v<T, Allocator>) {
+          if (n > 0) { std::memcpy(dst, src, n * sizeof(*src)); }
+        } else {
+          boost::alloc_construct_n(alloc_, dst, n, src);
+        }
+      } else {
+        auto it = std::next(first, static_cast<difference_type>(lo));
+        boost::alloc_construct_n(alloc_, dst, n, detail::array_walker<ForwardIterator>{it});
+      }
+    });
+    size_ = count;
   }
 
   dynamic_array(dynamic_array const& other)
@@ -253,7 +1037,7 @@ public:
           other.get_allocator()))
   {
     auto& alloc_ = boost::empty_value<Allocator>::get();
-    data_        = create_(alloc_, other.size(), boost::first_scalar(other.data()));
+    data_        = copy_create_(alloc_, other.size(), other.data());
     size_        = other.size();
   }
 
@@ -261,7 +1045,7 @@ public:
     : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
   {
     auto& alloc_ = boost::empty_value<Allocator>::get();
-    data_        = create_(alloc_, other.size(), boost::first_scalar(other.data()));
+    data_        = copy_create_(alloc_, other.size(), other.data());
     size_        = other.size();
   }
 
@@ -283,10 +1067,39 @@ public:
       return;
     }
 
-    data_ = create_(alloc_, other.size(),
-                    detail::move_if_noexcept_adaptor<detail::array_walker<iterator>>{
-                      detail::array_walker<iterator>{other.begin()}});
-    size_ = other.size();
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      size_ = other.size();
+      data_ = relocate_create_(alloc_, other);
+    } else {
+      data_ = create_(alloc_, other.size(),
+                      detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                        boost::first_scalar(other.data())});
+      size_ = other.size();
+    }
+  }
+
+  // takes over `count` live elements at `data` that an allocator equal to `alloc` allocated with
+  // `allocate(count)`, such as the result of another array's `release()`
+  //
+  dynamic_array(adopt_t,
+                pointer          data,
+                size_type        count,
+                Allocator const& alloc = Allocator()) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    BOOST_ASSERT(data != nullptr || count == 0);
+
+    data_ = data;
+    size_ = count;
+  }
+
+  template <class Deleter,
+            std::enable_if_t<detail::is_adoptable_deleter_v<Allocator, Deleter>, int> = 0>
+  dynamic_array(std::unique_ptr<T[], Deleter>&& ptr,
+                size_type                      count,
+                Allocator const&               alloc = Allocator()) noexcept
+    : dynamic_array(adopt, ptr.release(), count, alloc)
+  {
   }
 
   dynamic_array(std::initializer_list<T> init, Allocator const& alloc = Allocator())
@@ -311,6 +1124,20 @@ public:
   {
     auto& alloc_ = boost::empty_value<Allocator>::get();
 
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      // if we get to keep our allocator, the existing storage can be reused when it's already the
+      // right size which saves us an allocate/deallocate round-trip
+      //
+      auto const keeps_allocator =
+        !std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value ||
+        alloc_ == other.get_allocator();
+
+      if (keeps_allocator && size_ == other.size_) {
+        assign_in_place_(other.data());
+        return *this;
+      }
+    }
+
     if (alloc_ == other.get_allocator()) {
       auto tmp = dynamic_array(other, alloc_);
       destroy_(alloc_, data_, size_);
@@ -363,15 +1190,28 @@ public:
       return *this;
     }
 
-    destroy_(alloc_, data_, size_);
-
+    // the new buffer is fully built before the old one is released so that a throwing element move
+    // leaves `*this` untouched
+    //
     auto a = std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value
                ? other.get_allocator()
                : alloc_;
-    data_  = create_(a, other.size(),
-                    detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
-                      boost::first_scalar(other.data())});
-    size_  = other.size();
+
+    auto const size = other.size();
+
+    pointer data = nullptr;
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      data = relocate_create_(a, other);
+    } else {
+      data = create_(a, size,
+                     detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                       boost::first_scalar(other.data())});
+    }
+
+    destroy_(alloc_, data_, size_);
+
+    data_  = data;
+    size_  = size;
     alloc_ = a;
 
     return *this;
@@ -380,6 +1220,13 @@ public:
   auto
   operator=(std::initializer_list<T> ilist) & -> dynamic_array&
   {
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if (size_ == ilist.size()) {
+        assign_in_place_(ilist.begin());
+        return *this;
+      }
+    }
+
     auto& alloc_ = boost::empty_value<Allocator>::get();
     auto  tmp    = dynamic_array(ilist, alloc_);
 
@@ -406,13 +1253,15 @@ public:
   auto
   data() noexcept -> T*
   {
-    return boost::to_address(data_);
+    return detail::assume_aligned<detail::allocator_alignment_v<Allocator>>(
+      boost::to_address(data_));
   }
 
   auto
   data() const noexcept -> T const*
   {
-    return boost::to_address(data_);
+    return detail::assume_aligned<detail::allocator_alignment_v<Allocator>>(
+      boost::to_address(data_));
   }
 
   auto
@@ -568,13 +1417,53 @@ public:
   auto
   fill(T const& value) -> void
   {
-    if constexpr (std::is_array_v<T>) {
-      std::for_each(begin(), end(), [&](auto& arr) {
-        std::copy(std::begin(value), std::end(value), std::begin(arr));
-      });
-    } else {
-      std::fill(begin(), end(), value);
-    }
+    detail::fill_elements(data(), size_, value, detail::is_streaming_fill<T>(size_));
+  }
+
+  template <class ExecutionPolicy,
+            std::enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy>>, int> = 0>
+  auto
+  fill(ExecutionPolicy&& policy, T const& value) -> void
+  {
+    // the whole fill decides on streaming stores, each chunk alone might fit in the caches
+    //
+    auto const streaming  = detail::is_streaming_fill<T>(size_);
+    auto const num_chunks = detail::is_concurrently_assignable_v<T, Allocator>
+                              ? detail::num_chunks<T>(policy.concurrency(), size_)
+                              : std::size_t{1};
+    policy.bulk(num_chunks, [&](std::size_t const idx) {
+      auto const [first, last] = detail::chunk_bounds(size_, num_chunks, idx);
+      detail::fill_elements(data() + first, last - first, value, streaming);
+    });
+  }
+
+  // gives up ownership without destroying or deallocating anything and leaves the array empty
+  //
+  auto
+  release() noexcept -> release_type
+  {
+    auto const& alloc = boost::empty_value<Allocator>::get();
+    return {std::exchange(data_, nullptr), std::exchange(size_, 0), alloc};
+  }
+
+  // the size never changes behind the caller's back, this is the one place it does and it costs an
+  // allocation and a relocation unless the allocator can move the pages itself
+  //
+  // the new elements are value-initialized, or default-initialized with `noinit`
+  //
+  auto
+  reallocate(size_type count) -> void
+  {
+    auto& alloc_ = boost::empty_value<Allocator>::get();
+    reallocate_(alloc_, count);
+  }
+
+  auto
+  reallocate(size_type count, noinit_t) -> void
+  {
+    auto& alloc_ = boost::empty_value<Allocator>::get();
+    auto  a      = boost::noinit_adapt(alloc_);
+    reallocate_(a, count);
   }
 
   auto
@@ -599,11 +1488,8 @@ template <class T, class Allocator>
 auto
 operator==(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> const& rhs) -> bool
 {
-  auto a = boost::first_scalar(lhs.data());
-  auto b = boost::first_scalar(rhs.data());
-
-  return std::equal(a, a + detail::num_elems<T>(lhs.size()), b,
-                    b + detail::num_elems<T>(rhs.size()));
+  if (lhs.size() != rhs.size()) { return false; }
+  return detail::elements_equal(lhs.data(), rhs.data(), lhs.size());
 }
 
 template <class T, class Allocator>
@@ -617,12 +1503,7 @@ template <class T, class Allocator>
 auto
 operator<(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> const& rhs) -> bool
 {
-  if (lhs.size() != rhs.size()) { return false; }
-  auto a = boost::first_scalar(lhs.data());
-  auto b = boost::first_scalar(rhs.data());
-
-  return std::lexicographical_compare(a, a + detail::num_elems<T>(lhs.size()), b,
-                                      b + detail::num_elems<T>(rhs.size()));
+  return detail::elements_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
 }
 
 template <class T, class Allocator>
@@ -645,6 +1526,16 @@ operator>=(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> c
 {
   return !(lhs < rhs);
 }
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T, class Allocator>
+auto
+operator<=>(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  return detail::elements_three_way(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+#endif
 } // namespace sleip
 
 #endif // SLEIP_DYNAMIC_ARRAY_HPP_
@@ -14,12 +14,27 @@
 #endif
 
 #include <memory>
+#include <type_traits>
 #ifndef SLEIP_NO_CXX17_PMR
 #include <memory_resource>
 #endif
 
+#if defined(__cpp_impl_three_way_comparison) && __has_include(<compare>)
+#include <compare>
+#endif
+
+#if !defined(__cpp_lib_three_way_comparison)
+#define SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+#endif
+
 namespace sleip
 {
+template <class T>
+struct is_trivially_relocatable;
+
+template <class T>
+struct is_execution_policy;
+
 template <class T, class Allocator = std::allocator<T>>
 struct dynamic_array;
 
@@ -54,6 +69,13 @@ operator<=(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> c
 template <class T, class Allocator>
 auto
 operator>=(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> const& rhs) -> bool;
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T, class Allocator>
+auto
+operator<=>(dynamic_array<T, Allocator> const& lhs, dynamic_array<T, Allocator> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>;
+#endif
 } // namespace sleip
 
 #endif // SLEIP_DYNAMIC_ARRAY_FWD_HPP_
@@ -0,0 +1,639 @@
+#ifndef SLEIP_DYNAMIC_ARRAY_ND_HPP_
+#define SLEIP_DYNAMIC_ARRAY_ND_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/first_scalar.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+namespace sleip
+{
+// asks `dynamic_array_nd` to round the length of every innermost row up so that each one spans a
+// multiple of `bytes` bytes, e.g. 64 for a cache line or 32 for an AVX register
+//
+struct row_padding
+{
+  std::size_t bytes = 0;
+};
+
+// a non-owning view of a `Rank`-dimensional grid of `T` with a stride for every dimension, the
+// same model as `std::mdspan` with `std::layout_stride`
+//
+// views are cheap to copy and are what the `copy_rect` and `transpose` kernels operate on
+//
+template <class T, std::size_t Rank>
+struct nd_view
+{
+public:
+  using element_type = T;
+  using value_type   = std::remove_cv_t<T>;
+  using size_type    = std::size_t;
+  using reference    = T&;
+  using pointer      = T*;
+  using extents_type = std::array<std::size_t, Rank>;
+
+  static_assert(Rank > 0, "A rank of 0 has no rows to view");
+
+private:
+  T*           data_ = nullptr;
+  extents_type extents_{};
+  extents_type strides_{};
+
+public:
+  nd_view() = default;
+
+  nd_view(T* data, extents_type const& extents, extents_type const& strides) noexcept
+    : data_{data}
+    , extents_{extents}
+    , strides_{strides}
+  {
+  }
+
+  // a densely packed row-major grid
+  //
+  nd_view(T* data, extents_type const& extents) noexcept
+    : data_{data}
+    , extents_{extents}
+  {
+    auto stride = std::size_t{1};
+    for (std::size_t r = Rank; r-- > 0;) {
+      strides_[r] = stride;
+      stride *= extents_[r];
+    }
+  }
+
+  template <class U, std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>, int> = 0>
+  nd_view(nd_view<U, Rank> const& other) noexcept
+    : data_{other.data()}
+    , extents_{other.extents()}
+    , strides_{other.strides()}
+  {
+  }
+
+  static constexpr auto
+  rank() noexcept -> std::size_t
+  {
+    return Rank;
+  }
+
+  auto
+  data() const noexcept -> T*
+  {
+    return data_;
+  }
+
+  auto
+  extent(std::size_t r) const noexcept -> std::size_t
+  {
+    BOOST_ASSERT(r < Rank);
+    return extents_[r];
+  }
+
+  auto
+  extents() const noexcept -> extents_type const&
+  {
+    return extents_;
+  }
+
+  auto
+  stride(std::size_t r) const noexcept -> std::size_t
+  {
+    BOOST_ASSERT(r < Rank);
+    return strides_[r];
+  }
+
+  auto
+  strides() const noexcept -> extents_type const&
+  {
+    return strides_;
+  }
+
+  // the number of elements in the grid, not counting any padding between rows
+  //
+  auto
+  size() const noexcept -> std::size_t
+  {
+    return std::accumulate(extents_.begin(), extents_.end(), std::size_t{1},
+                           [](std::size_t a, std::size_t b) { return a * b; });
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  template <class... Indices>
+  auto
+  operator()(Indices... idx) const noexcept -> T&
+  {
+    static_assert(sizeof...(Indices) == Rank, "Exactly one index per dimension is required");
+
+    std::size_t const indices[] = {static_cast<std::size_t>(idx)...};
+
+    auto offset = std::size_t{0};
+    for (std::size_t r = 0; r < Rank; ++r) {
+      BOOST_ASSERT(indices[r] < extents_[r]);
+      offset += indices[r] * strides_[r];
+    }
+    return data_[offset];
+  }
+
+  // the box of `extents` elements whose first element is at `origin`, sharing this view's strides
+  //
+  auto
+  subview(extents_type const& origin, extents_type const& extents) const noexcept -> nd_view
+  {
+    auto offset = std::size_t{0};
+    for (std::size_t r = 0; r < Rank; ++r) {
+      BOOST_ASSERT(origin[r] <= extents_[r] && extents[r] <= extents_[r] - origin[r]);
+      offset += origin[r] * strides_[r];
+    }
+    return nd_view(data_ + offset, extents, strides_);
+  }
+};
+
+namespace detail
+{
+// assignment that also works for bound array element types
+//
+template <class T, class U>
+auto
+nd_assign(T& dst, U const& src) -> void
+{
+  if constexpr (std::is_array_v<T>) {
+    std::copy_n(boost::first_scalar(std::addressof(src)), array_size_v<T>,
+                boost::first_scalar(std::addressof(dst)));
+  } else {
+    dst = src;
+  }
+}
+
+template <std::size_t Dim, class T, class U, std::size_t Rank>
+auto
+copy_rect_dim(nd_view<T, Rank> const& src, nd_view<U, Rank> const& dst, T* sp, U* dp) -> void
+{
+  auto const n  = src.extent(Dim);
+  auto const ss = src.stride(Dim);
+  auto const ds = dst.stride(Dim);
+
+  if constexpr (Dim + 1 < Rank) {
+    for (std::size_t i = 0; i < n; ++i) {
+      copy_rect_dim<Dim + 1>(src, dst, sp + i * ss, dp + i * ds);
+    }
+  } else {
+    if constexpr (std::is_trivially_copyable_v<U>) {
+      if (ss == 1 && ds == 1) {
+        if (n > 0) { std::memcpy(dp, sp, n * sizeof(U)); }
+        return;
+      }
+    }
+    for (std::size_t i = 0; i < n; ++i) { nd_assign(dp[i * ds], sp[i * ss]); }
+  }
+}
+
+// the edge of the square tile `transpose` works through, two cache lines' worth of elements,
+// which keeps both tiles in L1 and the destination rows of a tile within a handful of TLB entries
+//
+template <class T>
+inline constexpr std::size_t const transpose_tile_v =
+  std::clamp<std::size_t>(128 / sizeof(T), 4, 64);
+} // namespace detail
+
+// copies every element of `src` to the same position in `dst`, which must have the same extents
+// and must not overlap `src`
+//
+// rows are copied with `memcpy` when the element type allows it and both innermost strides are 1
+//
+template <class T, class U, std::size_t Rank>
+auto
+copy_rect(nd_view<T, Rank> const& src, nd_view<U, Rank> const& dst) -> void
+{
+  static_assert(std::is_same_v<std::remove_const_t<T>, U>,
+                "The destination must be a mutable view of the source's element type");
+
+  if (src.extents() != dst.extents()) {
+    boost::throw_exception(
+      std::invalid_argument("sleip::copy_rect -> the source and destination extents differ"));
+  }
+  if (src.empty()) { return; }
+
+  detail::copy_rect_dim<0>(src, dst, src.data(), dst.data());
+}
+
+// writes the transpose of the matrix `src` into `dst`, whose extents must be `src`'s swapped, the
+// two must not overlap
+//
+// the matrix is walked in square tiles so that the strided side of the copy touches a bounded set
+// of cache lines at a time instead of a new one for every element
+//
+template <class T, class U>
+auto
+transpose(nd_view<T, 2> const& src, nd_view<U, 2> const& dst) -> void
+{
+  static_assert(std::is_same_v<std::remove_const_t<T>, U>,
+                "The destination must be a mutable view of the source's element type");
+
+  auto const rows = src.extent(0);
+  auto const cols = src.extent(1);
+
+  if (dst.extent(0) != cols || dst.extent(1) != rows) {
+    boost::throw_exception(std::invalid_argument(
+      "sleip::transpose -> the destination extents must be the source's swapped"));
+  }
+
+  constexpr auto const tile = detail::transpose_tile_v<U>;
+
+  auto* const sp  = src.data();
+  auto* const dp  = dst.data();
+  auto const  ss0 = src.stride(0);
+  auto const  ss1 = src.stride(1);
+  auto const  ds0 = dst.stride(0);
+  auto const  ds1 = dst.stride(1);
+
+  for (std::size_t i0 = 0; i0 < rows; i0 += tile) {
+    auto const i1 = std::min(rows, i0 + tile);
+    for (std::size_t j0 = 0; j0 < cols; j0 += tile) {
+      auto const j1 = std::min(cols, j0 + tile);
+      for (std::size_t i = i0; i < i1; ++i) {
+        for (std::size_t j = j0; j < j1; ++j) {
+          detail::nd_assign(dp[j * ds0 + i * ds1], sp[i * ss0 + j * ss1]);
+        }
+      }
+    }
+  }
+}
+
+#ifdef __cpp_lib_mdspan
+template <class T, std::size_t Rank>
+auto
+to_mdspan(nd_view<T, Rank> const& v)
+  -> std::mdspan<T, std::dextents<std::size_t, Rank>, std::layout_stride>
+{
+  using extents_type = std::dextents<std::size_t, Rank>;
+  return {v.data(), std::layout_stride::mapping<extents_type>(extents_type(v.extents()),
+                                                              v.strides())};
+}
+#endif
+
+// a `Rank`-dimensional row-major grid stored in a single `dynamic_array`
+//
+// the extents are fixed at construction, optionally with every innermost row padded out to a
+// multiple of some number of bytes so that no two rows share a cache line or split a vector
+// register, provided the allocator aligns the storage to at least that much
+//
+template <class T, std::size_t Rank, class Allocator = std::allocator<T>>
+struct dynamic_array_nd
+{
+public:
+  using value_type      = T;
+  using allocator_type  = Allocator;
+  using size_type       = std::size_t;
+  using reference       = value_type&;
+  using const_reference = value_type const&;
+  using extents_type    = std::array<std::size_t, Rank>;
+  using view_type       = nd_view<T, Rank>;
+  using const_view_type = nd_view<T const, Rank>;
+
+  static_assert(Rank > 0, "A rank of 0 has no rows to store");
+
+private:
+  extents_type                 extents_{};
+  extents_type                 strides_{};
+  dynamic_array<T, Allocator> storage_;
+
+  static auto
+  checked_mul_(std::size_t a, std::size_t b) -> std::size_t
+  {
+    if (b != 0 && a > std::numeric_limits<std::size_t>::max() / b) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return a * b;
+  }
+
+  // the padded row has to be a whole number of elements and a multiple of `pad.bytes` bytes, which
+  // for element sizes that don't divide it means a multiple of their least common multiple
+  //
+  static auto
+  make_strides_(extents_type const& extents, row_padding pad) -> extents_type
+  {
+    auto row = extents[Rank - 1];
+    if (pad.bytes > 0) {
+      auto const unit = pad.bytes / std::gcd(pad.bytes, sizeof(T));
+      row             = checked_mul_((row + unit - 1) / unit, unit);
+    }
+
+    auto strides      = extents_type{};
+    strides[Rank - 1] = 1;
+
+    auto stride = row;
+    for (std::size_t r = Rank - 1; r-- > 0;) {
+      strides[r] = stride;
+      stride     = checked_mul_(stride, extents[r]);
+    }
+    return strides;
+  }
+
+  static auto
+  storage_size_(extents_type const& extents, extents_type const& strides) -> std::size_t
+  {
+    if (std::find(extents.begin(), extents.end(), 0) != extents.end()) { return 0; }
+    // a single row has no neighbour to keep apart from so it isn't padded
+    //
+    if constexpr (Rank == 1) {
+      return extents[0];
+    } else {
+      return checked_mul_(extents[0], strides[0]);
+    }
+  }
+
+  template <class... Indices>
+  auto
+  offset_(Indices... idx) const noexcept -> std::size_t
+  {
+    static_assert(sizeof...(Indices) == Rank, "Exactly one index per dimension is required");
+
+    std::size_t const indices[] = {static_cast<std::size_t>(idx)...};
+
+    auto offset = std::size_t{0};
+    for (std::size_t r = 0; r < Rank; ++r) {
+      BOOST_ASSERT(indices[r] < extents_[r]);
+      offset += indices[r] * strides_[r];
+    }
+    return offset;
+  }
+
+  template <class... Indices>
+  auto
+  check_bounds_(Indices... idx) const -> void
+  {
+    std::size_t const indices[] = {static_cast<std::size_t>(idx)...};
+    for (std::size_t r = 0; r < Rank; ++r) {
+      if (!(indices[r] < extents_[r])) {
+        boost::throw_exception(
+          std::out_of_range("sleip::dynamic_array_nd::at -> an index is larger than its extent"));
+      }
+    }
+  }
+
+public:
+  dynamic_array_nd() = default;
+
+  dynamic_array_nd(dynamic_array_nd const&) = default;
+
+  // the source is left empty with all-zero extents
+  //
+  dynamic_array_nd(dynamic_array_nd&& other) noexcept
+    : extents_{std::exchange(other.extents_, extents_type{})}
+    , strides_{std::exchange(other.strides_, extents_type{})}
+    , storage_(std::move(other.storage_))
+  {
+  }
+
+  explicit dynamic_array_nd(extents_type const& extents, Allocator const& alloc = Allocator())
+    : dynamic_array_nd(extents, row_padding{}, alloc)
+  {
+  }
+
+  dynamic_array_nd(extents_type const& extents,
+                   T const&            value,
+                   Allocator const&    alloc = Allocator())
+    : dynamic_array_nd(extents, row_padding{}, value, alloc)
+  {
+  }
+
+  dynamic_array_nd(extents_type const& extents, noinit_t, Allocator const& alloc = Allocator())
+    : dynamic_array_nd(extents, row_padding{}, noinit, alloc)
+  {
+  }
+
+  dynamic_array_nd(extents_type const& extents,
+                   row_padding         pad,
+                   Allocator const&    alloc = Allocator())
+    : extents_{extents}
+    , strides_{make_strides_(extents, pad)}
+    , storage_(storage_size_(extents_, strides_), alloc)
+  {
+  }
+
+  dynamic_array_nd(extents_type const& extents,
+                   row_padding         pad,
+                   T const&            value,
+                   Allocator const&    alloc = Allocator())
+    : extents_{extents}
+    , strides_{make_strides_(extents, pad)}
+    , storage_(storage_size_(extents_, strides_), value, alloc)
+  {
+  }
+
+  dynamic_array_nd(extents_type const& extents,
+                   row_padding         pad,
+                   noinit_t,
+                   Allocator const& alloc = Allocator())
+    : extents_{extents}
+    , strides_{make_strides_(extents, pad)}
+    , storage_(storage_size_(extents_, strides_), noinit, alloc)
+  {
+  }
+
+  // the storage goes first so that a throwing copy leaves `*this` as it was
+  //
+  auto
+  operator=(dynamic_array_nd const& other) & -> dynamic_array_nd&
+  {
+    storage_ = other.storage_;
+    extents_ = other.extents_;
+    strides_ = other.strides_;
+    return *this;
+  }
+
+  // with unequal allocators that don't propagate, the elements are moved one by one and the
+  // moved-from ones are destroyed straight after so that the source is always left empty
+  //
+  auto
+    operator=(dynamic_array_nd&& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> dynamic_array_nd&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    storage_ = std::move(other.storage_);
+    extents_ = std::exchange(other.extents_, extents_type{});
+    strides_ = std::exchange(other.strides_, extents_type{});
+
+    if (!other.storage_.empty()) {
+      other.storage_ = dynamic_array<T, Allocator>(other.storage_.get_allocator());
+    }
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return storage_.get_allocator();
+  }
+
+  static constexpr auto
+  rank() noexcept -> std::size_t
+  {
+    return Rank;
+  }
+
+  auto
+  extent(std::size_t r) const noexcept -> std::size_t
+  {
+    BOOST_ASSERT(r < Rank);
+    return extents_[r];
+  }
+
+  auto
+  extents() const noexcept -> extents_type const&
+  {
+    return extents_;
+  }
+
+  // in elements, the innermost stride is always 1
+  //
+  auto
+  stride(std::size_t r) const noexcept -> std::size_t
+  {
+    BOOST_ASSERT(r < Rank);
+    return strides_[r];
+  }
+
+  auto
+  strides() const noexcept -> extents_type const&
+  {
+    return strides_;
+  }
+
+  // the number of elements in the grid, not counting any padding
+  //
+  auto
+  size() const noexcept -> size_type
+  {
+    return view().size();
+  }
+
+  // the number of elements allocated, including the padding at the end of every row
+  //
+  auto
+  storage_size() const noexcept -> size_type
+  {
+    return storage_.size();
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return storage_.empty();
+  }
+
+  auto
+  data() noexcept -> T*
+  {
+    return storage_.data();
+  }
+
+  auto
+  data() const noexcept -> T const*
+  {
+    return storage_.data();
+  }
+
+  template <class... Indices>
+  auto
+  operator()(Indices... idx) & noexcept -> reference
+  {
+    return storage_.data()[offset_(idx...)];
+  }
+
+  template <class... Indices>
+  auto
+  operator()(Indices... idx) const& noexcept -> const_reference
+  {
+    return storage_.data()[offset_(idx...)];
+  }
+
+  template <class... Indices>
+  auto
+  at(Indices... idx) & -> reference
+  {
+    check_bounds_(idx...);
+    return storage_.data()[offset_(idx...)];
+  }
+
+  template <class... Indices>
+  auto
+  at(Indices... idx) const& -> const_reference
+  {
+    check_bounds_(idx...);
+    return storage_.data()[offset_(idx...)];
+  }
+
+  auto
+  view() noexcept -> view_type
+  {
+    return view_type(storage_.data(), extents_, strides_);
+  }
+
+  auto
+  view() const noexcept -> const_view_type
+  {
+    return const_view_type(storage_.data(), extents_, strides_);
+  }
+
+  auto
+  cview() const noexcept -> const_view_type
+  {
+    return view();
+  }
+
+  // fills the padding as well as the elements
+  //
+  auto
+  fill(T const& value) -> void
+  {
+    storage_.fill(value);
+  }
+
+  auto
+    swap(dynamic_array_nd& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> void
+  {
+    storage_.swap(other.storage_);
+    std::swap(extents_, other.extents_);
+    std::swap(strides_, other.strides_);
+  }
+};
+
+template <class T, std::size_t Rank, class Allocator>
+auto
+swap(dynamic_array_nd<T, Rank, Allocator>& lhs,
+     dynamic_array_nd<T, Rank, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+} // namespace sleip
+
+#endif // SLEIP_DYNAMIC_ARRAY_ND_HPP_
@@ -0,0 +1,128 @@
+#ifndef SLEIP_EXECUTION_HPP_
+#define SLEIP_EXECUTION_HPP_
+
+#include <sleip/dynamic_array_fwd.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sleip
+{
+// an execution policy is any type for which `is_execution_policy` is specialized to be true and
+// which provides:
+//
+//   auto concurrency() const -> std::size_t;
+//     the number of chunks it's worth splitting the work into
+//
+//   template <class F> auto bulk(std::size_t n, F const& f) const -> void;
+//     invokes `f(i)` for every `i` in `[0, n)`, returning only once every invocation has completed
+//     and then rethrowing the first exception thrown by any of them
+//
+
+// runs every chunk on the calling thread, mostly useful for testing
+//
+struct sequenced_policy
+{
+  auto
+  concurrency() const noexcept -> std::size_t
+  {
+    return 1;
+  }
+
+  template <class F>
+  auto
+  bulk(std::size_t const n, F const& f) const -> void
+  {
+    auto ep = std::exception_ptr();
+    for (std::size_t i = 0; i < n; ++i) {
+      try {
+        f(i);
+      }
+      catch (...) {
+        if (!ep) { ep = std::current_exception(); }
+      }
+    }
+
+    if (ep) { std::rethrow_exception(ep); }
+  }
+};
+
+// runs every chunk on its own `std::thread`, the calling thread takes the first one
+//
+// a `num_threads` of 0 means `std::thread::hardware_concurrency()`
+//
+struct parallel_policy
+{
+  std::size_t num_threads = 0;
+
+  auto
+  concurrency() const noexcept -> std::size_t
+  {
+    if (num_threads > 0) { return num_threads; }
+
+    auto const n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+  }
+
+  template <class F>
+  auto
+  bulk(std::size_t const n, F const& f) const -> void
+  {
+    auto ep  = std::exception_ptr();
+    auto mtx = std::mutex();
+    auto run = [&](std::size_t const i) noexcept {
+      try {
+        f(i);
+      }
+      catch (...) {
+        auto lock = std::lock_guard<std::mutex>(mtx);
+        if (!ep) { ep = std::current_exception(); }
+      }
+    };
+
+    auto threads = std::vector<std::thread>();
+
+    // if we can't get a thread for a chunk, we still owe the caller its completion so it's run
+    // inline instead
+    //
+    try {
+      threads.reserve(n > 0 ? n - 1 : 0);
+    }
+    catch (...) {
+    }
+
+    for (std::size_t i = 1; i < n; ++i) {
+      try {
+        threads.emplace_back(run, i);
+      }
+      catch (...) {
+        run(i);
+      }
+    }
+
+    if (n > 0) { run(0); }
+    for (auto& t : threads) { t.join(); }
+
+    if (ep) { std::rethrow_exception(ep); }
+  }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy  par{};
+
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type
+{
+};
+
+template <>
+struct is_execution_policy<parallel_policy> : std::true_type
+{
+};
+} // namespace sleip
+
+#endif // SLEIP_EXECUTION_HPP_
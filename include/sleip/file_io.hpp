@@ -0,0 +1,591 @@
+#ifndef SLEIP_FILE_IO_HPP_
+#define SLEIP_FILE_IO_HPP_
+
+#include <sleip/dynamic_array.hpp>
+#include <sleip/execution.hpp>
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "sleip::read_file and sleip::write_file require a POSIX platform"
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define SLEIP_HAS_IO_URING
+#endif
+
+namespace sleip
+{
+enum class file_io_backend
+{
+  automatic,  // io_uring when the kernel offers it, the thread pool otherwise
+  io_uring,   // fails with `ENOSYS` if the kernel doesn't offer it
+  thread_pool // `queue_depth` threads each issuing blocking `pread`/`pwrite` calls
+};
+
+struct file_io_options
+{
+  // the size of each individual request
+  //
+  std::size_t chunk_size = std::size_t{1} << 20;
+
+  // the number of requests kept in flight at once
+  //
+  unsigned queue_depth = 32;
+
+  // bypass the page cache with `O_DIRECT`
+  //
+  // this is best-effort, it's silently dropped if the file system refuses it or if the array's
+  // storage isn't aligned to `file_io_block_size`, see `page_aligned_allocator`
+  //
+  bool direct = false;
+
+  file_io_backend backend = file_io_backend::automatic;
+};
+
+// what a transfer actually did, which may differ from what was asked for
+//
+struct file_io_result
+{
+  std::size_t     bytes   = 0;
+  file_io_backend backend = file_io_backend::thread_pool;
+  bool            direct  = false;
+};
+
+// the alignment `O_DIRECT` needs of the buffer, the file offsets and the request lengths
+//
+// 4 KiB covers the logical block size of every device we care about
+//
+inline constexpr std::size_t const file_io_block_size = 4096;
+
+namespace detail
+{
+struct file_descriptor
+{
+  int fd = -1;
+
+  file_descriptor() = default;
+
+  explicit file_descriptor(int fd_) noexcept
+    : fd{fd_}
+  {
+  }
+
+  file_descriptor(file_descriptor const&) = delete;
+
+  auto
+  operator=(file_descriptor const&) -> file_descriptor& = delete;
+
+  ~file_descriptor()
+  {
+    if (fd >= 0) { ::close(fd); }
+  }
+};
+
+[[noreturn]] inline auto
+file_io_throw(int err, char const* what) -> void
+{
+  boost::throw_exception(std::system_error(err, std::generic_category(), what));
+}
+
+// a single contiguous transfer between `buf` and the bytes `[offset, offset + len)` of `fd`
+//
+struct file_io_job
+{
+  int            fd;
+  unsigned char* buf;
+  std::size_t    offset;
+  std::size_t    len;
+  bool           write;
+};
+
+// the number of bytes `pread`/`pwrite` moved for `job`, a read stops short at end of file
+//
+inline auto
+file_io_blocking(file_io_job const& job) -> std::size_t
+{
+  auto done = std::size_t{0};
+  while (done < job.len) {
+    auto const off = static_cast<off_t>(job.offset + done);
+    auto const r   = job.write ? ::pwrite(job.fd, job.buf + done, job.len - done, off)
+                               : ::pread(job.fd, job.buf + done, job.len - done, off);
+    if (r < 0) {
+      if (errno == EINTR) { continue; }
+      file_io_throw(errno, job.write ? "sleip::write_file -> pwrite" : "sleip::read_file -> pread");
+    }
+    if (r == 0) {
+      if (job.write) { file_io_throw(EIO, "sleip::write_file -> pwrite"); }
+      break;
+    }
+    done += static_cast<std::size_t>(r);
+  }
+  return done;
+}
+
+// splits `job` into `chunk` sized pieces handed out to `depth` threads
+//
+inline auto
+file_io_thread_pool(file_io_job const& job, std::size_t chunk, unsigned depth) -> std::size_t
+{
+  auto const num_chunks  = (job.len + chunk - 1) / chunk;
+  auto const num_threads = std::min<std::size_t>(depth, num_chunks);
+
+  auto next = std::atomic<std::size_t>{0};
+  auto eof  = std::atomic<std::size_t>{job.len};
+
+  parallel_policy{num_threads}.bulk(num_threads, [&](std::size_t) {
+    for (auto i = next.fetch_add(1); i < num_chunks; i = next.fetch_add(1)) {
+      auto const first = i * chunk;
+      auto const len   = std::min(chunk, job.len - first);
+
+      auto const n =
+        file_io_blocking({job.fd, job.buf + first, job.offset + first, len, job.write});
+
+      // the file ended inside this chunk, keep the earliest such point as the amount read
+      //
+      if (n < len) {
+        auto cur = eof.load();
+        while (first + n < cur && !eof.compare_exchange_weak(cur, first + n)) {}
+      }
+    }
+  });
+
+  return eof.load();
+}
+
+#ifdef SLEIP_HAS_IO_URING
+
+// just enough of an io_uring to keep a fixed number of reads or writes in flight
+//
+// we talk to the kernel directly rather than through liburing so that this stays header-only and
+// dependency-free
+//
+struct io_ring
+{
+  int fd = -1;
+
+  void*       sq_map   = MAP_FAILED;
+  std::size_t sq_len   = 0;
+  void*       cq_map   = MAP_FAILED;
+  std::size_t cq_len   = 0;
+  void*       sqe_map  = MAP_FAILED;
+  std::size_t sqe_len  = 0;
+  unsigned    entries  = 0;
+  unsigned*   sq_tail  = nullptr;
+  unsigned*   sq_mask  = nullptr;
+  unsigned*   sq_array = nullptr;
+  unsigned*   cq_head  = nullptr;
+  unsigned*   cq_tail  = nullptr;
+  unsigned*   cq_mask  = nullptr;
+
+  io_uring_sqe* sqes = nullptr;
+  io_uring_cqe* cqes = nullptr;
+
+  // leaves the ring closed if the kernel doesn't support io_uring, has it disabled or predates
+  // `IORING_OP_READ`/`IORING_OP_WRITE`
+  //
+  explicit io_ring(unsigned num_entries) noexcept
+  {
+    if (!setup(num_entries)) { close(); }
+  }
+
+  io_ring(io_ring const&) = delete;
+
+  auto
+  operator=(io_ring const&) -> io_ring& = delete;
+
+  ~io_ring() { close(); }
+
+  explicit operator bool() const noexcept { return fd >= 0; }
+
+  auto
+  setup(unsigned num_entries) noexcept -> bool
+  {
+    auto p = io_uring_params();
+    std::memset(&p, 0, sizeof(p));
+
+    fd = static_cast<int>(::syscall(SYS_io_uring_setup, num_entries, &p));
+    if (fd < 0) { return false; }
+
+    // `IORING_FEAT_RW_CUR_POS` shipped in the same release as the plain read and write opcodes
+    //
+    if (!(p.features & IORING_FEAT_RW_CUR_POS)) { return false; }
+
+    entries = p.sq_entries;
+    sq_len  = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_len  = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    sqe_len = p.sq_entries * sizeof(io_uring_sqe);
+
+    auto const single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) { sq_len = cq_len = std::max(sq_len, cq_len); }
+
+    sq_map = ::mmap(nullptr, sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                    IORING_OFF_SQ_RING);
+    if (sq_map == MAP_FAILED) { return false; }
+
+    cq_map = single ? sq_map
+                    : ::mmap(nullptr, cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             fd, IORING_OFF_CQ_RING);
+    if (cq_map == MAP_FAILED) { return false; }
+
+    sqe_map = ::mmap(nullptr, sqe_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                     IORING_OFF_SQES);
+    if (sqe_map == MAP_FAILED) { return false; }
+
+    auto* const sq = static_cast<unsigned char*>(sq_map);
+    auto* const cq = static_cast<unsigned char*>(cq_map);
+
+    sq_tail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_mask  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    cq_head  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask  = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    sqes     = static_cast<io_uring_sqe*>(sqe_map);
+    cqes     = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+  }
+
+  auto
+  close() noexcept -> void
+  {
+    if (sqe_map != MAP_FAILED) { ::munmap(sqe_map, sqe_len); }
+    if (cq_map != MAP_FAILED && cq_map != sq_map) { ::munmap(cq_map, cq_len); }
+    if (sq_map != MAP_FAILED) { ::munmap(sq_map, sq_len); }
+    if (fd >= 0) { ::close(fd); }
+
+    fd      = -1;
+    sq_map  = MAP_FAILED;
+    cq_map  = MAP_FAILED;
+    sqe_map = MAP_FAILED;
+  }
+
+  // queues a request, the caller guarantees fewer than `entries` are outstanding
+  //
+  auto
+  push(file_io_job const& job, std::uint64_t user_data) noexcept -> void
+  {
+    auto const tail = *sq_tail;
+    auto const idx  = tail & *sq_mask;
+
+    auto& sqe = sqes[idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode    = job.write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe.fd        = job.fd;
+    sqe.addr      = reinterpret_cast<std::uintptr_t>(job.buf);
+    sqe.len       = static_cast<std::uint32_t>(job.len);
+    sqe.off       = job.offset;
+    sqe.user_data = user_data;
+
+    sq_array[idx] = idx;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  // submits `to_submit` queued requests and waits for at least `min_complete` completions,
+  // returns how many requests the kernel consumed
+  //
+  // the kernel may consume fewer than it was handed, e.g. when it's short of memory, it then
+  // returns without waiting and the rest stay at the front of the submission queue
+  //
+  auto
+  enter(unsigned to_submit, unsigned min_complete) -> unsigned
+  {
+    for (;;) {
+      auto const n = ::syscall(SYS_io_uring_enter, fd, to_submit, min_complete,
+                               IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (n >= 0) { return static_cast<unsigned>(n); }
+      if (errno != EINTR && errno != EAGAIN) { file_io_throw(errno, "sleip -> io_uring_enter"); }
+    }
+  }
+
+  // calls `f(user_data, res)` for every completion posted so far
+  //
+  template <class F>
+  auto
+  reap(F&& f) -> void
+  {
+    auto head = *cq_head;
+    while (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+      auto const& cqe = cqes[head & *cq_mask];
+      f(cqe.user_data, cqe.res);
+      ++head;
+      __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    }
+  }
+};
+
+// keeps up to `depth` `chunk` sized requests in flight on `ring`, re-queueing the remainder of any
+// short transfer
+//
+// the kernel writes into the caller's buffer until the last completion is reaped so an error only
+// stops new submissions and is thrown once everything outstanding has drained
+//
+inline auto
+file_io_uring(io_ring& ring, file_io_job const& job, std::size_t chunk, unsigned depth)
+  -> std::size_t
+{
+  auto slots  = std::vector<file_io_job>(std::min(depth, ring.entries));
+  auto free   = std::vector<std::uint64_t>();
+  auto next   = std::size_t{0};
+  auto eof    = job.len;
+  auto err    = 0;
+  auto queued = 0u;
+  auto active = 0u;
+
+  free.reserve(slots.size());
+  for (auto i = slots.size(); i > 0; --i) { free.push_back(i - 1); }
+
+  auto retry = std::vector<std::uint64_t>();
+  retry.reserve(slots.size());
+
+  for (;;) {
+    if (err == 0) {
+      for (auto const i : retry) {
+        ring.push(slots[i], i);
+        ++queued;
+      }
+      retry.clear();
+
+      while (!free.empty() && next < eof) {
+        auto const i   = free.back();
+        auto const len = std::min(chunk, eof - next);
+
+        slots[i] = {job.fd, job.buf + next, job.offset + next, len, job.write};
+        free.pop_back();
+        ring.push(slots[i], i);
+
+        next += len;
+        ++queued;
+      }
+    }
+
+    if (queued == 0 && active == 0) { break; }
+
+    auto const submitted = ring.enter(queued, 1);
+    active += submitted;
+    queued -= submitted;
+
+    ring.reap([&](std::uint64_t const i, int const res) {
+      --active;
+
+      auto& s = slots[i];
+      if (res < 0 || (res == 0 && s.write)) {
+        if (err == 0) { err = res < 0 ? -res : EIO; }
+        free.push_back(i);
+        return;
+      }
+
+      auto const n = static_cast<std::size_t>(res);
+      if (n == 0) {
+        eof = std::min(eof, s.offset - job.offset);
+        free.push_back(i);
+        return;
+      }
+
+      s.buf += n;
+      s.offset += n;
+      s.len -= n;
+
+      if (s.len > 0) {
+        retry.push_back(i);
+      } else {
+        free.push_back(i);
+      }
+    });
+  }
+
+  if (err != 0) {
+    file_io_throw(err, job.write ? "sleip::write_file -> io_uring"
+                                 : "sleip::read_file -> io_uring");
+  }
+
+  return std::min(eof, next);
+}
+
+#endif
+
+// runs `job` on whichever backend `options` asks for and the platform provides
+//
+inline auto
+file_io_run(file_io_job const& job, file_io_options const& options, std::size_t chunk)
+  -> file_io_result
+{
+  auto       result = file_io_result();
+  auto const depth  = std::max(options.queue_depth, 1u);
+
+  if (job.len == 0) { return result; }
+
+#ifdef SLEIP_HAS_IO_URING
+  if (options.backend != file_io_backend::thread_pool) {
+    auto ring = io_ring(depth);
+    if (ring) {
+      result.backend = file_io_backend::io_uring;
+      result.bytes   = file_io_uring(ring, job, chunk, depth);
+      return result;
+    }
+  }
+#endif
+
+  if (options.backend == file_io_backend::io_uring) {
+    file_io_throw(ENOSYS, job.write ? "sleip::write_file -> io_uring"
+                                    : "sleip::read_file -> io_uring");
+  }
+
+  result.backend = file_io_backend::thread_pool;
+  result.bytes   = file_io_thread_pool(job, chunk, depth);
+  return result;
+}
+
+// splits the transfer of `len` bytes at `buf` into a block aligned head that can go through
+// `O_DIRECT` and a buffered tail of less than one block
+//
+inline auto
+file_io_transfer(char const* path, int fd, unsigned char* buf, std::size_t len, bool write,
+                 file_io_options const& options) -> file_io_result
+{
+  // an io_uring request length is 32 bits and `O_DIRECT` needs every offset block aligned
+  //
+  auto chunk =
+    std::clamp<std::size_t>(options.chunk_size, file_io_block_size, std::size_t{1} << 30);
+  chunk = chunk / file_io_block_size * file_io_block_size;
+
+  auto const aligned = len / file_io_block_size * file_io_block_size;
+
+  auto direct = file_descriptor();
+#ifdef O_DIRECT
+  if (options.direct && aligned > 0 &&
+      reinterpret_cast<std::uintptr_t>(buf) % file_io_block_size == 0) {
+    direct.fd = ::open(path, (write ? O_WRONLY : O_RDONLY) | O_DIRECT | O_CLOEXEC);
+  }
+#else
+  static_cast<void>(path);
+#endif
+
+  if (direct.fd < 0) { return file_io_run({fd, buf, 0, len, write}, options, chunk); }
+
+  auto result   = file_io_run({direct.fd, buf, 0, aligned, write}, options, chunk);
+  result.direct = true;
+
+  if (result.bytes == aligned && aligned < len) {
+    result.bytes += file_io_blocking({fd, buf + aligned, aligned, len - aligned, write});
+  }
+  return result;
+}
+} // namespace detail
+
+// reads the start of the file at `path` into `a`, stopping at whichever of the end of the file or
+// the end of the array comes first
+//
+// any elements past the bytes read are left untouched so the returned byte count should be
+// checked when the file may be shorter than the array
+//
+template <class T, class Allocator>
+auto
+read_file(char const* path, dynamic_array<T, Allocator>& a,
+          file_io_options const& options = file_io_options()) -> file_io_result
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable types can be read directly from a file");
+
+  auto const fd = detail::file_descriptor(::open(path, O_RDONLY | O_CLOEXEC));
+  if (fd.fd < 0) { detail::file_io_throw(errno, "sleip::read_file -> open"); }
+
+  return detail::file_io_transfer(path, fd.fd, reinterpret_cast<unsigned char*>(a.data()),
+                                  a.size() * sizeof(T), false, options);
+}
+
+template <class T, class Allocator>
+auto
+read_file(std::string const& path, dynamic_array<T, Allocator>& a,
+          file_io_options const& options = file_io_options()) -> file_io_result
+{
+  return read_file(path.c_str(), a, options);
+}
+
+// reads the whole of the file at `path` into a new `noinit` array, any trailing bytes that don't
+// make up a full `T` are not read
+//
+template <class T, class Allocator = std::allocator<T>>
+auto
+read_file(char const* path, file_io_options const& options = file_io_options(),
+          Allocator const& alloc = Allocator()) -> dynamic_array<T, Allocator>
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable types can be read directly from a file");
+
+  struct stat st;
+  if (::stat(path, &st) != 0) { detail::file_io_throw(errno, "sleip::read_file -> stat"); }
+
+  auto a = dynamic_array<T, Allocator>(static_cast<std::size_t>(st.st_size) / sizeof(T), noinit,
+                                       alloc);
+
+  auto const result = read_file(path, a, options);
+  if (result.bytes != a.size() * sizeof(T)) {
+    detail::file_io_throw(EIO, "sleip::read_file -> file was truncated while reading");
+  }
+  return a;
+}
+
+template <class T, class Allocator = std::allocator<T>>
+auto
+read_file(std::string const& path, file_io_options const& options = file_io_options(),
+          Allocator const& alloc = Allocator()) -> dynamic_array<T, Allocator>
+{
+  return read_file<T>(path.c_str(), options, alloc);
+}
+
+// creates the file at `path`, or truncates it if it already exists, and writes the contents of `a`
+// to it
+//
+template <class T, class Allocator>
+auto
+write_file(char const* path, dynamic_array<T, Allocator> const& a,
+           file_io_options const& options = file_io_options()) -> file_io_result
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable types can be written directly to a file");
+
+  auto const fd =
+    detail::file_descriptor(::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+  if (fd.fd < 0) { detail::file_io_throw(errno, "sleip::write_file -> open"); }
+
+  // sizing the file up-front keeps the concurrent writes from racing to extend it
+  //
+  auto const len = a.size() * sizeof(T);
+  if (::ftruncate(fd.fd, static_cast<off_t>(len)) != 0) {
+    detail::file_io_throw(errno, "sleip::write_file -> ftruncate");
+  }
+
+  auto* const p = const_cast<unsigned char*>(reinterpret_cast<unsigned char const*>(a.data()));
+  return detail::file_io_transfer(path, fd.fd, p, len, true, options);
+}
+
+template <class T, class Allocator>
+auto
+write_file(std::string const& path, dynamic_array<T, Allocator> const& a,
+           file_io_options const& options = file_io_options()) -> file_io_result
+{
+  return write_file(path.c_str(), a, options);
+}
+} // namespace sleip
+
+#endif // SLEIP_FILE_IO_HPP_
@@ -0,0 +1,346 @@
+#ifndef SLEIP_HUGE_PAGE_ALLOCATOR_HPP_
+#define SLEIP_HUGE_PAGE_ALLOCATOR_HPP_
+
+#include <sleip/dynamic_array_fwd.hpp>
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define SLEIP_HAS_HUGE_PAGES
+#endif
+
+namespace sleip
+{
+// the kind of pages backing an allocation
+//
+enum class huge_page_backing
+{
+  normal,      // regular base pages
+  transparent, // transparent huge pages granted after `madvise(MADV_HUGEPAGE)`
+  hugetlb      // pages from the preallocated `MAP_HUGETLB` pool
+};
+
+struct huge_page_options
+{
+  // allocations smaller than this go through `::operator new` as usual
+  //
+  std::size_t threshold = std::size_t{2} << 20;
+
+  // try the preallocated hugetlbfs pool first, falling back to transparent huge pages if it's empty
+  // or not configured
+  //
+  bool use_hugetlb = false;
+};
+
+namespace detail
+{
+inline constexpr std::size_t const huge_page_size = std::size_t{2} << 20;
+
+inline auto
+round_up(std::size_t n, std::size_t align) noexcept -> std::size_t
+{
+  return (n + align - 1) / align * align;
+}
+
+#ifdef SLEIP_HAS_HUGE_PAGES
+
+// over-map by one huge page so the region can be trimmed to a huge page boundary, otherwise the
+// kernel can't back the first and last partial huge pages with a single TLB entry
+//
+inline auto
+huge_page_map_aligned(std::size_t len) noexcept -> void*
+{
+  void* raw = ::mmap(nullptr, len + huge_page_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) { return nullptr; }
+
+  auto const addr    = reinterpret_cast<std::uintptr_t>(raw);
+  auto const aligned = round_up(addr, huge_page_size);
+  auto const head    = aligned - addr;
+  auto const tail    = huge_page_size - head;
+
+  if (head > 0) { ::munmap(raw, head); }
+  if (tail > 0) { ::munmap(reinterpret_cast<void*>(aligned + len), tail); }
+
+  auto* const p = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+  ::madvise(p, len, MADV_HUGEPAGE);
+#endif
+
+  return p;
+}
+
+inline auto
+huge_page_map(std::size_t num_bytes, bool use_hugetlb) -> void*
+{
+  auto const len = round_up(num_bytes, huge_page_size);
+
+#ifdef MAP_HUGETLB
+  if (use_hugetlb) {
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) { return p; }
+  }
+#else
+  static_cast<void>(use_hugetlb);
+#endif
+
+  void* p = huge_page_map_aligned(len);
+  if (p == nullptr) { boost::throw_exception(std::bad_alloc()); }
+  return p;
+}
+
+// grows the mapping in place when the address range after it is free, otherwise its pages move
+// to a fresh huge page aligned region so they can stay huge, either way nothing is copied
+//
+inline auto
+huge_page_remap(void* p, std::size_t old_bytes, std::size_t new_bytes) noexcept -> void*
+{
+  auto const old_len = round_up(old_bytes, huge_page_size);
+  auto const new_len = round_up(new_bytes, huge_page_size);
+  if (old_len == new_len) { return p; }
+
+  void* q = ::mremap(p, old_len, new_len, 0);
+  if (q != MAP_FAILED) { return q; }
+
+  void* dst = huge_page_map_aligned(new_len);
+  if (dst == nullptr) { return nullptr; }
+
+  q = ::mremap(p, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+  if (q == MAP_FAILED) {
+    ::munmap(dst, new_len);
+    return nullptr;
+  }
+  return q;
+}
+
+inline auto
+huge_page_unmap(void* p, std::size_t num_bytes) noexcept -> void
+{
+  ::munmap(p, round_up(num_bytes, huge_page_size));
+}
+
+#endif
+
+inline auto
+huge_page_allocate(std::size_t num_bytes, huge_page_options const& options) -> void*
+{
+#ifdef SLEIP_HAS_HUGE_PAGES
+  if (num_bytes >= options.threshold) { return huge_page_map(num_bytes, options.use_hugetlb); }
+#else
+  static_cast<void>(options);
+#endif
+  return ::operator new(num_bytes);
+}
+
+// only blocks that were mapped, and stay big enough to be, can be remapped
+//
+inline auto
+huge_page_reallocate(void*                    p,
+                     std::size_t              old_bytes,
+                     std::size_t              new_bytes,
+                     huge_page_options const& options) noexcept -> void*
+{
+#ifdef SLEIP_HAS_HUGE_PAGES
+  if (old_bytes >= options.threshold && new_bytes >= options.threshold) {
+    return huge_page_remap(p, old_bytes, new_bytes);
+  }
+#else
+  static_cast<void>(p);
+  static_cast<void>(old_bytes);
+  static_cast<void>(new_bytes);
+  static_cast<void>(options);
+#endif
+  return nullptr;
+}
+
+inline auto
+huge_page_deallocate(void* p, std::size_t num_bytes, huge_page_options const& options) noexcept
+  -> void
+{
+#ifdef SLEIP_HAS_HUGE_PAGES
+  if (num_bytes >= options.threshold) { return huge_page_unmap(p, num_bytes); }
+#else
+  static_cast<void>(options);
+#endif
+  ::operator delete(p);
+}
+} // namespace detail
+
+// reports the backing the OS actually gave the page containing `p`
+//
+// transparent huge pages are only granted once the memory is touched and only if the kernel had a
+// free huge page to hand out so this is the only reliable way to tell whether `madvise` worked
+//
+inline auto
+huge_page_backing_of(void const* p) -> huge_page_backing
+{
+#ifdef SLEIP_HAS_HUGE_PAGES
+  auto smaps = std::ifstream("/proc/self/smaps");
+
+  auto const addr = reinterpret_cast<std::uintptr_t>(p);
+
+  auto line      = std::string();
+  auto in_region = false;
+  while (std::getline(smaps, line)) {
+    // region headers look like "7f0000000000-7f0000200000 rw-p ..."
+    //
+    auto const dash = line.find('-');
+    auto const sp   = line.find(' ');
+    if (dash != std::string::npos && sp != std::string::npos && dash < sp &&
+        line.find(':') > sp) {
+      auto const first = std::stoull(line.substr(0, dash), nullptr, 16);
+      auto const last  = std::stoull(line.substr(dash + 1, sp - dash - 1), nullptr, 16);
+      in_region        = first <= addr && addr < last;
+      continue;
+    }
+
+    if (!in_region) { continue; }
+
+    auto field = std::string();
+    auto value = std::size_t{0};
+    std::istringstream(line) >> field >> value;
+
+    if (field == "KernelPageSize:" && value >= detail::huge_page_size / 1024) {
+      return huge_page_backing::hugetlb;
+    }
+    if (field == "AnonHugePages:") {
+      return value > 0 ? huge_page_backing::transparent : huge_page_backing::normal;
+    }
+  }
+#else
+  static_cast<void>(p);
+#endif
+  return huge_page_backing::normal;
+}
+
+// an Allocator that backs allocations of at least `options.threshold` bytes with 2 MiB aligned
+// memory that's been advised for huge pages
+//
+template <class T>
+struct huge_page_allocator
+{
+  using value_type = T;
+
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "huge_page_allocator does not support over-aligned types");
+
+  huge_page_options options;
+
+  huge_page_allocator() = default;
+
+  huge_page_allocator(huge_page_options options_) noexcept
+    : options{options_}
+  {
+  }
+
+  template <class U>
+  huge_page_allocator(huge_page_allocator<U> const& other) noexcept
+    : options{other.options}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return static_cast<T*>(detail::huge_page_allocate(n * sizeof(T), options));
+  }
+
+  // `dynamic_array::reallocate` moves the pages of a mapped block instead of copying them
+  //
+  auto
+  reallocate(T* p, std::size_t old_n, std::size_t new_n) noexcept -> T*
+  {
+    if (new_n > std::numeric_limits<std::size_t>::max() / sizeof(T)) { return nullptr; }
+    return static_cast<T*>(
+      detail::huge_page_reallocate(p, old_n * sizeof(T), new_n * sizeof(T), options));
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    detail::huge_page_deallocate(p, n * sizeof(T), options);
+  }
+};
+
+// the threshold decides how a block is released so it's the only thing that has to match
+//
+template <class T, class U>
+auto
+operator==(huge_page_allocator<T> const& lhs, huge_page_allocator<U> const& rhs) noexcept -> bool
+{
+  return lhs.options.threshold == rhs.options.threshold;
+}
+
+template <class T, class U>
+auto
+operator!=(huge_page_allocator<T> const& lhs, huge_page_allocator<U> const& rhs) noexcept -> bool
+{
+  return !(lhs == rhs);
+}
+
+#ifndef SLEIP_NO_CXX17_PMR
+
+// the same backing as `huge_page_allocator`, for use with `pmr::dynamic_array`
+//
+struct huge_page_resource : std::pmr::memory_resource
+{
+  huge_page_options options;
+
+  huge_page_resource() = default;
+
+  explicit huge_page_resource(huge_page_options options_) noexcept
+    : options{options_}
+  {
+  }
+
+private:
+  auto
+  do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+  {
+    if (bytes < options.threshold && alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(bytes, std::align_val_t{alignment});
+    }
+    return detail::huge_page_allocate(bytes, options);
+  }
+
+  auto
+  do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override
+  {
+    if (bytes < options.threshold && alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator delete(p, std::align_val_t{alignment});
+    }
+    detail::huge_page_deallocate(p, bytes, options);
+  }
+
+  auto
+  do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+  {
+    auto const* const p = dynamic_cast<huge_page_resource const*>(&other);
+    return p != nullptr && p->options.threshold == options.threshold;
+  }
+};
+
+#endif
+} // namespace sleip
+
+#endif // SLEIP_HUGE_PAGE_ALLOCATOR_HPP_
@@ -0,0 +1,853 @@
+#ifndef SLEIP_JAGGED_ARRAY_HPP_
+#define SLEIP_JAGGED_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/alloc_construct.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/noinit_adaptor.hpp>
+#include <boost/core/pointer_traits.hpp>
+
+#include <boost/mp11/utility.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+namespace detail
+{
+template <class Range>
+using range_element_t =
+  std::remove_cv_t<std::remove_reference_t<decltype(*begin(std::declval<Range const&>()))>>;
+
+// a range of rows, each of which is itself a range of something a `T` can be built from
+//
+template <class Range, class T>
+using is_nested_range_ = boost::mp11::mp_bool<
+  is_range<Range>::value && is_range<range_element_t<Range>>::value &&
+  std::is_constructible_v<T, range_element_t<range_element_t<Range>> const&>>;
+
+template <class Range, class T>
+inline constexpr bool const is_nested_range_v =
+  boost::mp11::mp_eval_or<boost::mp11::mp_false, is_nested_range_, Range, T>::value;
+
+template <class Range>
+using is_size_range_ =
+  boost::mp11::mp_bool<is_range<Range>::value && std::is_integral_v<range_element_t<Range>>>;
+
+template <class Range>
+inline constexpr bool const is_size_range_v =
+  boost::mp11::mp_eval_or<boost::mp11::mp_false, is_size_range_, Range>::value;
+} // namespace detail
+
+// a fixed number of variable-length rows stored in compressed sparse row form, an array of
+// `size() + 1` offsets followed by every row's elements back to back, all in one allocation
+//
+// compared to a `dynamic_array<dynamic_array<T>>` there's no allocation and no pointer to chase
+// per row, so walking every row is a single forward pass over memory and copying or destroying the
+// whole thing is a couple of bulk operations
+//
+// rows are exposed as `column_span<T>`s, the row iterators return them by value
+//
+template <class T, class Allocator = std::allocator<T>>
+struct jagged_array : boost::empty_value<Allocator>
+{
+public:
+  using value_type      = T;
+  using allocator_type  = Allocator;
+  using size_type       = typename std::allocator_traits<Allocator>::size_type;
+  using difference_type = typename std::allocator_traits<Allocator>::difference_type;
+  using reference       = value_type&;
+  using const_reference = value_type const&;
+  using pointer         = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer   = typename std::allocator_traits<Allocator>::const_pointer;
+  using row_type        = column_span<T>;
+  using const_row_type  = column_span<T const>;
+
+  static_assert(std::is_object_v<T> && !std::is_array_v<T>,
+                "Only support non-array object types as elements");
+
+  static_assert(std::is_same_v<typename allocator_type::value_type, value_type>,
+                "Allocator's value type must match container's");
+
+private:
+  // the allocation is counted in units that are as aligned as the elements, the offsets and any
+  // over-alignment the allocator advertises, the elements begin on the first unit past the offsets
+  //
+  static constexpr std::size_t const unit_align_ =
+    std::max({alignof(T), alignof(std::size_t), detail::allocator_alignment_v<Allocator>});
+
+  struct alignas(unit_align_) unit
+  {
+    unsigned char bytes[unit_align_];
+  };
+
+  using unit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unit>;
+  using unit_traits    = std::allocator_traits<unit_allocator>;
+  using unit_pointer   = typename unit_traits::pointer;
+
+  unit_pointer data_       = nullptr;
+  std::size_t  rows_       = 0;
+  std::size_t  num_values_ = 0;
+
+  auto
+  alloc_() noexcept -> Allocator&
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  // the number of units taken up by the offsets of `rows` rows, only valid once `num_units_` has
+  // accepted `rows`
+  //
+  static auto
+  offset_units_(std::size_t rows) noexcept -> std::size_t
+  {
+    return ((rows + 1) * sizeof(std::size_t) + sizeof(unit) - 1) / sizeof(unit);
+  }
+
+  static auto
+  num_units_(std::size_t rows, std::size_t num_values) -> std::size_t
+  {
+    constexpr auto const max = std::numeric_limits<std::size_t>::max();
+
+    if (rows > (max - 2 * sizeof(unit)) / sizeof(std::size_t) ||
+        num_values > (max - sizeof(unit)) / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+
+    auto const head = offset_units_(rows);
+    auto const tail = (num_values * sizeof(T) + sizeof(unit) - 1) / sizeof(unit);
+    if (tail > max / sizeof(unit) - head) { boost::throw_exception(std::bad_array_new_length()); }
+
+    return head + tail;
+  }
+
+  static auto
+  offsets_(unit_pointer const& block) noexcept -> std::size_t*
+  {
+    return reinterpret_cast<std::size_t*>(boost::to_address(block));
+  }
+
+  static auto
+  values_(unit_pointer const& block, std::size_t rows) noexcept -> T*
+  {
+    return reinterpret_cast<T*>(boost::to_address(block) + offset_units_(rows));
+  }
+
+  // allocates a block for `rows` rows holding `num_values` elements in all, then has
+  // `init(offsets, values)` write the offsets and construct the elements
+  //
+  // `init` cleans up the elements it built itself if it throws
+  //
+  template <class Init>
+  auto
+  create_(std::size_t rows, std::size_t num_values, Init const& init) -> void
+  {
+    BOOST_ASSERT(data_ == nullptr);
+    if (rows == 0) { return; }
+
+    auto       a     = unit_allocator(alloc_());
+    auto const n     = num_units_(rows, num_values);
+    auto       block = unit_traits::allocate(a, n);
+
+    try {
+      init(offsets_(block), values_(block, rows));
+    }
+    catch (...) {
+      unit_traits::deallocate(a, block, n);
+      throw;
+    }
+
+    data_       = block;
+    rows_       = rows;
+    num_values_ = num_values;
+  }
+
+  // `construct(values, num_values)` builds every element in one call once the offsets are known
+  //
+  template <class Sizes, class Construct>
+  auto
+  create_from_sizes_(Sizes const& row_sizes, Construct const& construct) -> void
+  {
+    auto rows  = std::size_t{0};
+    auto total = std::size_t{0};
+    for (auto const size : row_sizes) {
+      auto const n = static_cast<std::size_t>(size);
+      if (n > std::numeric_limits<std::size_t>::max() - total) {
+        boost::throw_exception(std::bad_array_new_length());
+      }
+      total += n;
+      ++rows;
+    }
+
+    create_(rows, total, [&](std::size_t* offsets, T* values) {
+      auto r   = std::size_t{0};
+      auto off = std::size_t{0};
+
+      ::new (static_cast<void*>(offsets)) std::size_t(0);
+      for (auto const size : row_sizes) {
+        off += static_cast<std::size_t>(size);
+        ::new (static_cast<void*>(offsets + ++r)) std::size_t(off);
+      }
+
+      construct(values, total);
+    });
+  }
+
+  template <class Range>
+  auto
+  create_from_rows_(Range const& rows) -> void
+  {
+    auto num_rows = std::size_t{0};
+    auto total    = std::size_t{0};
+    for (auto const& row : rows) {
+      auto const n = static_cast<std::size_t>(
+        std::distance(detail::sleip_begin(row), detail::sleip_end(row)));
+      if (n > std::numeric_limits<std::size_t>::max() - total) {
+        boost::throw_exception(std::bad_array_new_length());
+      }
+      total += n;
+      ++num_rows;
+    }
+
+    create_(num_rows, total, [&](std::size_t* offsets, T* values) {
+      auto r     = std::size_t{0};
+      auto built = std::size_t{0};
+
+      ::new (static_cast<void*>(offsets)) std::size_t(0);
+      try {
+        for (auto const& row : rows) {
+          auto const first = detail::sleip_begin(row);
+          auto const n     = static_cast<std::size_t>(std::distance(first, detail::sleip_end(row)));
+
+          using iterator_type = std::remove_cv_t<decltype(first)>;
+          if constexpr (detail::is_contiguous_iterator_v<iterator_type, T> &&
+                        detail::is_bulk_copyable_v<T, Allocator>) {
+            if (n > 0) { std::memcpy(values + built, detail::to_address(first), n * sizeof(T)); }
+          } else {
+            boost::alloc_construct_n(alloc_(), values + built, n, first);
+          }
+
+          built += n;
+          ::new (static_cast<void*>(offsets + ++r)) std::size_t(built);
+        }
+      }
+      catch (...) {
+        boost::alloc_destroy_n(alloc_(), values, built);
+        throw;
+      }
+    });
+  }
+
+  // the offsets are always a plain copy, the elements are too whenever that's allowed
+  //
+  template <class Construct>
+  auto
+  copy_offsets_create_(jagged_array const& other, Construct const& construct) -> void
+  {
+    create_(other.rows_, other.num_values_, [&](std::size_t* offsets, T* values) {
+      std::memcpy(offsets, other.offsets_(other.data_), (other.rows_ + 1) * sizeof(std::size_t));
+      construct(values);
+    });
+  }
+
+  auto
+  copy_create_(jagged_array const& other) -> void
+  {
+    copy_offsets_create_(other, [&](T* values) {
+      if constexpr (detail::is_bulk_copyable_v<T, Allocator>) {
+        if (other.num_values_ > 0) {
+          std::memcpy(values, other.data(), other.num_values_ * sizeof(T));
+        }
+      } else {
+        boost::alloc_construct_n(alloc_(), values, other.num_values_, other.data());
+      }
+    });
+  }
+
+  auto
+  deallocate_() noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+
+    auto a = unit_allocator(alloc_());
+    unit_traits::deallocate(a, data_, num_units_(rows_, num_values_));
+    data_       = nullptr;
+    rows_       = 0;
+    num_values_ = 0;
+  }
+
+  auto
+  destroy_() noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+
+    boost::alloc_destroy_n(alloc_(), values_(data_, rows_), num_values_);
+    deallocate_();
+  }
+
+  auto
+  steal_(jagged_array& other) noexcept -> void
+  {
+    data_       = std::exchange(other.data_, nullptr);
+    rows_       = std::exchange(other.rows_, 0);
+    num_values_ = std::exchange(other.num_values_, 0);
+  }
+
+  auto
+  same_shape_(jagged_array const& other) const noexcept -> bool
+  {
+    if (rows_ != other.rows_ || num_values_ != other.num_values_) { return false; }
+    if (rows_ == 0) { return true; }
+
+    return std::memcmp(offsets_(data_), offsets_(other.data_),
+                       (rows_ + 1) * sizeof(std::size_t)) == 0;
+  }
+
+  template <class U>
+  static auto
+  row_(std::size_t const* offsets, U* values, size_type pos) noexcept -> column_span<U>
+  {
+    return {values + offsets[pos], offsets[pos + 1] - offsets[pos]};
+  }
+
+public:
+  jagged_array() noexcept(noexcept(Allocator()))
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+  }
+
+  explicit jagged_array(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+  }
+
+  // builds `row_sizes.size()` rows with the lengths given, every element default-initialized
+  //
+  template <class Sizes, std::enable_if_t<detail::is_size_range_v<Sizes>, int> = 0>
+  jagged_array(Sizes const& row_sizes, noinit_t, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto a = boost::noinit_adapt(alloc_());
+    create_from_sizes_(row_sizes, [&](T* p, std::size_t n) { boost::alloc_construct_n(a, p, n); });
+  }
+
+  template <class Sizes, std::enable_if_t<detail::is_size_range_v<Sizes>, int> = 0>
+  jagged_array(Sizes const& row_sizes, T const& value, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_from_sizes_(row_sizes, [&](T* p, std::size_t n) {
+      boost::alloc_construct_n(alloc_(), p, n, std::addressof(value), 1);
+    });
+  }
+
+  // copies every row of a range of ranges, e.g. a `std::vector<std::vector<T>>`
+  //
+  template <class Range, std::enable_if_t<detail::is_nested_range_v<Range, T>, int> = 0>
+  explicit jagged_array(Range const& rows, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_from_rows_(rows);
+  }
+
+  jagged_array(std::initializer_list<std::initializer_list<T>> rows,
+               Allocator const&                                alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_from_rows_(rows);
+  }
+
+  jagged_array(jagged_array const& other)
+    : boost::empty_value<Allocator>(
+        boost::empty_init_t{},
+        std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+          other.get_allocator()))
+  {
+    copy_create_(other);
+  }
+
+  jagged_array(jagged_array const& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    copy_create_(other);
+  }
+
+  jagged_array(jagged_array&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, std::move(other.get_allocator()))
+  {
+    steal_(other);
+  }
+
+  jagged_array(jagged_array&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      steal_(other);
+      return;
+    }
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      // the bytes now live in `*this` so `other`'s storage is released without running any
+      // destructors
+      //
+      copy_offsets_create_(other, [&](T* values) {
+        if (other.num_values_ > 0) {
+          std::memcpy(values, other.data(), other.num_values_ * sizeof(T));
+        }
+      });
+      other.deallocate_();
+    } else {
+      copy_offsets_create_(other, [&](T* values) {
+        boost::alloc_construct_n(alloc_(), values, other.num_values_,
+                                 detail::move_if_noexcept_adaptor<T*>{other.data()});
+      });
+    }
+  }
+
+  ~jagged_array() { destroy_(); }
+
+  auto
+  operator=(jagged_array const& other) & -> jagged_array&
+  {
+    constexpr auto const pocca =
+      std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if ((!pocca || alloc_() == other.get_allocator()) && same_shape_(other)) {
+        if (this != std::addressof(other)) { std::copy_n(other.data(), num_values_, data()); }
+        return *this;
+      }
+    }
+
+    auto tmp = jagged_array(other, pocca ? other.get_allocator() : alloc_());
+    destroy_();
+
+    if constexpr (pocca) { alloc_() = other.get_allocator(); }
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+    operator=(jagged_array&& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> jagged_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocma =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+    if (pocma || alloc_() == other.get_allocator()) {
+      destroy_();
+
+      if constexpr (pocma) {
+        alloc_() = std::move(static_cast<boost::empty_value<Allocator>&>(other).get());
+      }
+      steal_(other);
+
+      return *this;
+    }
+
+    auto tmp = jagged_array(std::move(other), alloc_());
+    destroy_();
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  // the number of rows
+  //
+  auto
+  size() const noexcept -> size_type
+  {
+    return rows_;
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return rows_ == 0;
+  }
+
+  auto
+  max_size() const noexcept -> size_type
+  {
+    return -1;
+  }
+
+  // the number of elements across every row
+  //
+  auto
+  num_values() const noexcept -> size_type
+  {
+    return num_values_;
+  }
+
+  auto
+  row_size(size_type pos) const noexcept -> size_type
+  {
+    BOOST_ASSERT(pos < rows_);
+    auto const* const offsets = offsets_(data_);
+    return offsets[pos + 1] - offsets[pos];
+  }
+
+  // the first element of the first row, every row follows on directly from the one before it
+  //
+  auto
+  data() noexcept -> T*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<unit_align_>(values_(data_, rows_));
+  }
+
+  auto
+  data() const noexcept -> T const*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<unit_align_>(values_(data_, rows_));
+  }
+
+  auto
+  values() noexcept -> row_type
+  {
+    return {data(), num_values_};
+  }
+
+  auto
+  values() const noexcept -> const_row_type
+  {
+    return {data(), num_values_};
+  }
+
+  // row `i` holds the elements `[offsets()[i], offsets()[i + 1])` of `values()`
+  //
+  auto
+  offsets() const noexcept -> column_span<std::size_t const>
+  {
+    if (data_ == nullptr) { return {}; }
+    return {offsets_(data_), rows_ + 1};
+  }
+
+  auto operator[](size_type pos) & noexcept -> row_type
+  {
+    BOOST_ASSERT(pos < rows_);
+    return row_(offsets_(data_), data(), pos);
+  }
+
+  auto operator[](size_type pos) const& noexcept -> const_row_type
+  {
+    BOOST_ASSERT(pos < rows_);
+    return row_(offsets_(data_), data(), pos);
+  }
+
+  auto
+  at(size_type pos) & -> row_type
+  {
+    if (!(pos < rows_)) {
+      boost::throw_exception(
+        std::out_of_range("sleip::jagged_array::at -> size_type pos is larger than size()"));
+    }
+    return (*this)[pos];
+  }
+
+  auto
+  at(size_type pos) const& -> const_row_type
+  {
+    if (!(pos < rows_)) {
+      boost::throw_exception(
+        std::out_of_range("sleip::jagged_array::at -> size_type pos is larger than size()"));
+    }
+    return (*this)[pos];
+  }
+
+  auto
+  front() & noexcept -> row_type
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[0];
+  }
+
+  auto
+  front() const& noexcept -> const_row_type
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[0];
+  }
+
+  auto
+  back() & noexcept -> row_type
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[rows_ - 1];
+  }
+
+  auto
+  back() const& noexcept -> const_row_type
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[rows_ - 1];
+  }
+
+  auto
+  fill(T const& value) -> void
+  {
+    detail::fill_elements(data(), num_values_, value, detail::is_streaming_fill<T>(num_values_));
+  }
+
+  auto
+    swap(jagged_array& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> void
+  {
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_(), other.alloc_());
+    } else {
+      BOOST_ASSERT(get_allocator() == other.get_allocator());
+    }
+
+    using std::swap;
+    swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(num_values_, other.num_values_);
+  }
+
+  // walks the rows by reading each offset once, the rows are returned by value
+  //
+  template <bool Const>
+  struct row_iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = std::conditional_t<Const, const_row_type, row_type>;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = value_type;
+    using pointer           = void;
+
+  private:
+    using element = std::conditional_t<Const, T const, T>;
+
+    std::size_t const* offset_ = nullptr;
+    element*           values_ = nullptr;
+
+  public:
+    row_iterator() = default;
+
+    row_iterator(std::size_t const* offset, element* values) noexcept
+      : offset_{offset}
+      , values_{values}
+    {
+    }
+
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    row_iterator(row_iterator<false> const& other) noexcept
+      : offset_{other.offset_}
+      , values_{other.values_}
+    {
+    }
+
+    auto operator*() const noexcept -> reference
+    {
+      return {values_ + offset_[0], offset_[1] - offset_[0]};
+    }
+
+    auto operator[](difference_type n) const noexcept -> reference { return *(*this + n); }
+
+    auto
+    operator++() noexcept -> row_iterator&
+    {
+      ++offset_;
+      return *this;
+    }
+
+    auto
+    operator++(int) noexcept -> row_iterator
+    {
+      auto tmp = *this;
+      ++offset_;
+      return tmp;
+    }
+
+    auto
+    operator--() noexcept -> row_iterator&
+    {
+      --offset_;
+      return *this;
+    }
+
+    auto
+    operator--(int) noexcept -> row_iterator
+    {
+      auto tmp = *this;
+      --offset_;
+      return tmp;
+    }
+
+    auto
+    operator+=(difference_type n) noexcept -> row_iterator&
+    {
+      offset_ += n;
+      return *this;
+    }
+
+    auto
+    operator-=(difference_type n) noexcept -> row_iterator&
+    {
+      offset_ -= n;
+      return *this;
+    }
+
+    friend auto
+    operator+(row_iterator it, difference_type n) noexcept -> row_iterator
+    {
+      return it += n;
+    }
+
+    friend auto
+    operator+(difference_type n, row_iterator it) noexcept -> row_iterator
+    {
+      return it += n;
+    }
+
+    friend auto
+    operator-(row_iterator it, difference_type n) noexcept -> row_iterator
+    {
+      return it -= n;
+    }
+
+    friend auto
+    operator-(row_iterator const& lhs, row_iterator const& rhs) noexcept -> difference_type
+    {
+      return lhs.offset_ - rhs.offset_;
+    }
+
+    friend auto
+    operator==(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ == rhs.offset_;
+    }
+
+    friend auto
+    operator!=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ != rhs.offset_;
+    }
+
+    friend auto
+    operator<(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ < rhs.offset_;
+    }
+
+    friend auto
+    operator>(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ > rhs.offset_;
+    }
+
+    friend auto
+    operator<=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ <= rhs.offset_;
+    }
+
+    friend auto
+    operator>=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.offset_ >= rhs.offset_;
+    }
+
+    friend struct row_iterator<!Const>;
+  };
+
+  using iterator       = row_iterator<false>;
+  using const_iterator = row_iterator<true>;
+
+  auto
+  begin() noexcept -> iterator
+  {
+    return {offsets().data(), data()};
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return {offsets().data(), data()};
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return begin();
+  }
+
+  auto
+  end() noexcept -> iterator
+  {
+    return {offsets().data() + rows_, data()};
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return {offsets().data() + rows_, data()};
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return end();
+  }
+};
+
+template <class T, class Allocator>
+auto
+swap(jagged_array<T, Allocator>& lhs,
+     jagged_array<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class T, class Allocator>
+auto
+operator==(jagged_array<T, Allocator> const& lhs, jagged_array<T, Allocator> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size() || lhs.num_values() != rhs.num_values()) { return false; }
+
+  auto const lo = lhs.offsets();
+  auto const ro = rhs.offsets();
+  return std::equal(lo.begin(), lo.end(), ro.begin()) &&
+         std::equal(lhs.data(), lhs.data() + lhs.num_values(), rhs.data());
+}
+
+template <class T, class Allocator>
+auto
+operator!=(jagged_array<T, Allocator> const& lhs, jagged_array<T, Allocator> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+} // namespace sleip
+
+#endif // SLEIP_JAGGED_ARRAY_HPP_
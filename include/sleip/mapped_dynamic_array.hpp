@@ -0,0 +1,469 @@
+#ifndef SLEIP_MAPPED_DYNAMIC_ARRAY_HPP_
+#define SLEIP_MAPPED_DYNAMIC_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "sleip::mapped_dynamic_array requires a POSIX platform"
+#endif
+
+namespace sleip
+{
+enum class map_mode
+{
+  read_only,     // the file can't be written through the mapping
+  copy_on_write, // writes are private to this mapping and never reach the file
+  read_write     // writes are shared with the file, see `sync()`
+};
+
+enum class map_advice
+{
+  normal,
+  sequential,
+  random,
+  willneed,
+  dontneed
+};
+
+struct map_options
+{
+  map_mode mode = map_mode::read_only;
+
+  // prefault the whole mapping up-front instead of on first access, Linux only
+  //
+  bool populate = false;
+
+  map_advice advice = map_advice::normal;
+};
+
+// a fixed-size array whose elements are the contents of a file mapped directly into memory
+//
+// this avoids copying the file through the page cache into anonymous memory, which pays the RSS
+// twice, at the cost of only supporting trivially copyable element types
+//
+template <class T>
+struct mapped_dynamic_array
+{
+public:
+  using value_type             = T;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = value_type&;
+  using const_reference        = value_type const&;
+  using pointer                = value_type*;
+  using const_pointer          = value_type const*;
+  using iterator               = value_type*;
+  using const_iterator         = value_type const*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable types can be read directly from a file");
+
+private:
+  pointer     data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t len_  = 0;
+  map_mode    mode_ = map_mode::read_only;
+
+  [[noreturn]] static auto
+  throw_errno(char const* what) -> void
+  {
+    boost::throw_exception(std::system_error(errno, std::generic_category(), what));
+  }
+
+  static auto
+  to_native(map_advice advice) noexcept -> int
+  {
+    switch (advice) {
+      case map_advice::sequential: return MADV_SEQUENTIAL;
+      case map_advice::random: return MADV_RANDOM;
+      case map_advice::willneed: return MADV_WILLNEED;
+      case map_advice::dontneed: return MADV_DONTNEED;
+      case map_advice::normal: break;
+    }
+    return MADV_NORMAL;
+  }
+
+  auto
+  map_(int fd, std::size_t len, map_options const& options) -> void
+  {
+    mode_ = options.mode;
+    if (len < sizeof(T)) { return; }
+
+    auto const prot = options.mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    auto       flags = options.mode == map_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) { flags |= MAP_POPULATE; }
+#endif
+
+    void* p = ::mmap(nullptr, len, prot, flags, fd, 0);
+    if (p == MAP_FAILED) { throw_errno("sleip::mapped_dynamic_array -> mmap"); }
+
+    if (options.advice != map_advice::normal) { ::madvise(p, len, to_native(options.advice)); }
+
+    data_ = static_cast<pointer>(p);
+    size_ = len / sizeof(T);
+    len_  = len;
+  }
+
+  static auto
+  open_(char const* path, map_mode mode, int extra_flags = 0) -> int
+  {
+    auto const flags = (mode == map_mode::read_write ? O_RDWR : O_RDONLY) | extra_flags;
+
+    int const fd = ::open(path, flags | O_CLOEXEC, 0644);
+    if (fd < 0) { throw_errno("sleip::mapped_dynamic_array -> open"); }
+    return fd;
+  }
+
+  // the mapping keeps the file alive on its own so the descriptor is only needed while mapping
+  //
+  struct fd_closer
+  {
+    int fd;
+    ~fd_closer() { ::close(fd); }
+  };
+
+public:
+  mapped_dynamic_array() noexcept = default;
+
+  // maps the whole of the file at `path`, any trailing bytes that don't make up a full `T` are
+  // not part of the array
+  //
+  explicit mapped_dynamic_array(char const* path, map_options const& options = map_options())
+  {
+    auto const fd = fd_closer{open_(path, options.mode)};
+
+    struct stat st;
+    if (::fstat(fd.fd, &st) != 0) { throw_errno("sleip::mapped_dynamic_array -> fstat"); }
+
+    map_(fd.fd, static_cast<std::size_t>(st.st_size), options);
+  }
+
+  explicit mapped_dynamic_array(std::string const& path, map_options const& options = map_options())
+    : mapped_dynamic_array(path.c_str(), options)
+  {
+  }
+
+  // creates the file at `path`, or truncates it if it already exists, so that it holds exactly
+  // `count` elements and maps it for writing
+  //
+  mapped_dynamic_array(char const* path, size_type count, map_options options = map_options())
+  {
+    options.mode = map_mode::read_write;
+
+    auto const fd  = fd_closer{open_(path, options.mode, O_CREAT | O_TRUNC)};
+    auto const len = count * sizeof(T);
+
+    if (::ftruncate(fd.fd, static_cast<off_t>(len)) != 0) {
+      throw_errno("sleip::mapped_dynamic_array -> ftruncate");
+    }
+
+    map_(fd.fd, len, options);
+  }
+
+  mapped_dynamic_array(std::string const& path, size_type count, map_options options = map_options())
+    : mapped_dynamic_array(path.c_str(), count, options)
+  {
+  }
+
+  mapped_dynamic_array(mapped_dynamic_array const&) = delete;
+
+  mapped_dynamic_array(mapped_dynamic_array&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+    , len_{std::exchange(other.len_, 0)}
+    , mode_{other.mode_}
+  {
+  }
+
+  ~mapped_dynamic_array()
+  {
+    if (data_ != nullptr) { ::munmap(data_, len_); }
+  }
+
+  auto
+  operator=(mapped_dynamic_array const&) -> mapped_dynamic_array& = delete;
+
+  auto
+  operator=(mapped_dynamic_array&& other) & noexcept -> mapped_dynamic_array&
+  {
+    auto tmp = std::move(other);
+    swap(tmp);
+    return *this;
+  }
+
+  auto
+  mode() const noexcept -> map_mode
+  {
+    return mode_;
+  }
+
+  // flushes writes to the underlying file, only meaningful for `map_mode::read_write`
+  //
+  auto
+  sync(bool async = false) -> void
+  {
+    if (data_ == nullptr || mode_ != map_mode::read_write) { return; }
+    if (::msync(data_, len_, async ? MS_ASYNC : MS_SYNC) != 0) {
+      throw_errno("sleip::mapped_dynamic_array -> msync");
+    }
+  }
+
+  auto
+  advise(map_advice advice) noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+    ::madvise(data_, len_, to_native(advice));
+  }
+
+  auto
+  size() const noexcept -> size_type
+  {
+    return size_;
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  auto
+  data() noexcept -> T*
+  {
+    return data_;
+  }
+
+  auto
+  data() const noexcept -> T const*
+  {
+    return data_;
+  }
+
+  auto
+  begin() noexcept -> iterator
+  {
+    return data_;
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return data_;
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return data_;
+  }
+
+  auto
+  end() noexcept -> iterator
+  {
+    return data_ + size_;
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return data_ + size_;
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return data_ + size_;
+  }
+
+  auto
+  rbegin() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(end());
+  }
+
+  auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  rend() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(begin());
+  }
+
+  auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  at(size_type pos) & -> reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::mapped_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data_[pos];
+  }
+
+  auto
+  at(size_type pos) const& -> const_reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::mapped_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data_[pos];
+  }
+
+  auto operator[](size_type pos) & -> reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data_[pos];
+  }
+
+  auto operator[](size_type pos) const& -> const_reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data_[pos];
+  }
+
+  auto
+  front() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *begin();
+  }
+
+  auto
+  front() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *cbegin();
+  }
+
+  auto
+  back() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(end() - 1);
+  }
+
+  auto
+  back() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(cend() - 1);
+  }
+
+  auto
+  swap(mapped_dynamic_array& other) & noexcept -> void
+  {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(len_, other.len_);
+    std::swap(mode_, other.mode_);
+  }
+};
+
+template <class T>
+auto
+swap(mapped_dynamic_array<T>& lhs, mapped_dynamic_array<T>& rhs) noexcept -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class T>
+auto
+operator==(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size()) { return false; }
+  return detail::elements_equal(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T>
+auto
+operator!=(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+template <class T>
+auto
+operator<(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  return detail::elements_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+template <class T>
+auto
+operator>(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  return rhs < lhs;
+}
+
+template <class T>
+auto
+operator<=(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  return !(rhs < lhs);
+}
+
+template <class T>
+auto
+operator>=(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs) -> bool
+{
+  return !(lhs < rhs);
+}
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T>
+auto
+operator<=>(mapped_dynamic_array<T> const& lhs, mapped_dynamic_array<T> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  return detail::elements_three_way(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+#endif
+} // namespace sleip
+
+#endif // SLEIP_MAPPED_DYNAMIC_ARRAY_HPP_
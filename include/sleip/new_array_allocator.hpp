@@ -0,0 +1,64 @@
+#ifndef SLEIP_NEW_ARRAY_ALLOCATOR_HPP_
+#define SLEIP_NEW_ARRAY_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace sleip
+{
+// an Allocator whose storage comes from `new T[n]` and goes back through `delete[]`, which is what
+// `std::unique_ptr<T[]>` expects, so buffers move between the two without being copied
+//
+// array new-expressions create the elements, so only types whose construction and destruction
+// are no-ops are supported
+//
+template <class T>
+struct new_array_allocator
+{
+  using value_type   = T;
+  using deleter_type = std::default_delete<T[]>;
+
+  using is_always_equal                        = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  static_assert(std::is_trivially_default_constructible_v<T> &&
+                  std::is_trivially_destructible_v<T>,
+                "new_array_allocator only supports trivially constructible and destructible types");
+
+  new_array_allocator() = default;
+
+  template <class U>
+  new_array_allocator(new_array_allocator<U> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    return new T[n];
+  }
+
+  auto
+  deallocate(T* p, std::size_t) noexcept -> void
+  {
+    delete[] p;
+  }
+};
+
+template <class T, class U>
+auto
+operator==(new_array_allocator<T> const&, new_array_allocator<U> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U>
+auto
+operator!=(new_array_allocator<T> const&, new_array_allocator<U> const&) noexcept -> bool
+{
+  return false;
+}
+} // namespace sleip
+
+#endif // SLEIP_NEW_ARRAY_ALLOCATOR_HPP_
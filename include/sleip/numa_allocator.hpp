@@ -0,0 +1,287 @@
+#ifndef SLEIP_NUMA_ALLOCATOR_HPP_
+#define SLEIP_NUMA_ALLOCATOR_HPP_
+
+#include <sleip/dynamic_array_fwd.hpp>
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__) && __has_include(<linux/mempolicy.h>)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SLEIP_HAS_NUMA
+#endif
+
+namespace sleip
+{
+// where the pages of an allocation are placed
+//
+// `local` places each page on the node of the thread that first touches it which makes it the
+// policy to pair with a parallel construction, `bind` restricts the pages to a single node and
+// `interleave` spreads them round-robin across every node the process is allowed to use
+//
+struct numa_policy
+{
+  enum class kind
+  {
+    local,
+    bind,
+    interleave
+  };
+
+  kind k    = kind::local;
+  int  node = 0;
+
+  static auto
+  local() noexcept -> numa_policy
+  {
+    return {kind::local, 0};
+  }
+
+  static auto
+  bind(int node) noexcept -> numa_policy
+  {
+    return {kind::bind, node};
+  }
+
+  static auto
+  interleave() noexcept -> numa_policy
+  {
+    return {kind::interleave, 0};
+  }
+
+  friend auto
+  operator==(numa_policy const& lhs, numa_policy const& rhs) noexcept -> bool
+  {
+    return lhs.k == rhs.k && lhs.node == rhs.node;
+  }
+
+  friend auto
+  operator!=(numa_policy const& lhs, numa_policy const& rhs) noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+};
+
+namespace detail
+{
+#ifdef SLEIP_HAS_NUMA
+
+// we only ever deal with the first 64 nodes which is plenty for the machines this targets
+//
+inline constexpr unsigned long const numa_max_node = 8 * sizeof(unsigned long);
+
+inline auto
+numa_allowed_nodes() noexcept -> unsigned long
+{
+  unsigned long mask = 0;
+
+  auto const r = ::syscall(SYS_get_mempolicy, nullptr, &mask, numa_max_node, nullptr,
+                           MPOL_F_MEMS_ALLOWED);
+
+  return (r == 0 && mask != 0) ? mask : 1ul;
+}
+
+inline auto
+numa_apply(void* p, std::size_t num_bytes, numa_policy const& policy) noexcept -> void
+{
+  auto mode = int{MPOL_LOCAL};
+  auto mask = 0ul;
+
+  switch (policy.k) {
+    case numa_policy::kind::bind:
+      mode = MPOL_BIND;
+      mask = 1ul << (static_cast<unsigned long>(policy.node) % numa_max_node);
+      break;
+
+    case numa_policy::kind::interleave:
+      mode = MPOL_INTERLEAVE;
+      mask = numa_allowed_nodes();
+      break;
+
+    case numa_policy::kind::local:
+      break;
+  }
+
+  // a kernel without NUMA support or a node we're not allowed to use leaves the default policy in
+  // place which is exactly the single node behavior we'd want anyway
+  //
+  ::syscall(SYS_mbind, p, num_bytes, mode, mode == MPOL_LOCAL ? nullptr : &mask,
+            mode == MPOL_LOCAL ? 0 : numa_max_node, 0);
+}
+
+inline auto
+numa_allocate(std::size_t num_bytes, numa_policy const& policy) -> void*
+{
+  void* p = ::mmap(nullptr, num_bytes == 0 ? 1 : num_bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) { boost::throw_exception(std::bad_alloc()); }
+
+  numa_apply(p, num_bytes, policy);
+  return p;
+}
+
+inline auto
+numa_deallocate(void* p, std::size_t num_bytes) noexcept -> void
+{
+  ::munmap(p, num_bytes == 0 ? 1 : num_bytes);
+}
+
+#else
+
+inline auto
+numa_allocate(std::size_t num_bytes, numa_policy const&) -> void*
+{
+  return ::operator new(num_bytes);
+}
+
+inline auto
+numa_deallocate(void* p, std::size_t) noexcept -> void
+{
+  ::operator delete(p);
+}
+
+#endif
+} // namespace detail
+
+// the number of NUMA nodes this process may allocate from, 1 on machines without NUMA
+//
+inline auto
+numa_num_nodes() noexcept -> int
+{
+#ifdef SLEIP_HAS_NUMA
+  auto mask = detail::numa_allowed_nodes();
+
+  auto n = 0;
+  for (; mask != 0; mask &= mask - 1) { ++n; }
+  return n;
+#else
+  return 1;
+#endif
+}
+
+// the node on which the page containing `p` currently resides or -1 if it can't be determined,
+// e.g. because the page hasn't been touched yet
+//
+inline auto
+numa_node_of(void const* p) noexcept -> int
+{
+#ifdef SLEIP_HAS_NUMA
+  int  node = -1;
+  auto r    = ::syscall(SYS_get_mempolicy, &node, nullptr, 0, p, MPOL_F_NODE | MPOL_F_ADDR);
+  return r == 0 ? node : -1;
+#else
+  static_cast<void>(p);
+  return 0;
+#endif
+}
+
+// an Allocator whose storage is mapped directly from the OS with the placement given by its
+// `numa_policy`
+//
+// every allocation is at least one page so this is meant for large, long-lived buffers
+//
+template <class T>
+struct numa_allocator
+{
+  using value_type = T;
+
+  // every instance returns its storage with `munmap` so any of them can free memory obtained by
+  // another, the policy only affects where new pages are placed
+  //
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= 4096, "numa_allocator does not support page over-aligned types");
+
+  numa_policy policy;
+
+  numa_allocator() = default;
+
+  numa_allocator(numa_policy policy_) noexcept
+    : policy{policy_}
+  {
+  }
+
+  template <class U>
+  numa_allocator(numa_allocator<U> const& other) noexcept
+    : policy{other.policy}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return static_cast<T*>(detail::numa_allocate(n * sizeof(T), policy));
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    detail::numa_deallocate(p, n * sizeof(T));
+  }
+};
+
+template <class T, class U>
+auto
+operator==(numa_allocator<T> const&, numa_allocator<U> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U>
+auto
+operator!=(numa_allocator<T> const&, numa_allocator<U> const&) noexcept -> bool
+{
+  return false;
+}
+
+#ifndef SLEIP_NO_CXX17_PMR
+
+// the same placement as `numa_allocator`, for use with `pmr::dynamic_array`
+//
+struct numa_resource : std::pmr::memory_resource
+{
+  numa_policy policy;
+
+  numa_resource() = default;
+
+  explicit numa_resource(numa_policy policy_) noexcept
+    : policy{policy_}
+  {
+  }
+
+private:
+  auto
+  do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+  {
+    if (alignment > 4096) { boost::throw_exception(std::bad_alloc()); }
+    return detail::numa_allocate(bytes, policy);
+  }
+
+  auto
+  do_deallocate(void* p, std::size_t bytes, std::size_t) -> void override
+  {
+    detail::numa_deallocate(p, bytes);
+  }
+
+  auto
+  do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+  {
+    return dynamic_cast<numa_resource const*>(&other) != nullptr;
+  }
+};
+
+#endif
+} // namespace sleip
+
+#endif // SLEIP_NUMA_ALLOCATOR_HPP_
@@ -0,0 +1,284 @@
+#ifndef SLEIP_RECYCLING_RESOURCE_HPP_
+#define SLEIP_RECYCLING_RESOURCE_HPP_
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace sleip
+{
+struct recycling_options
+{
+  // the most bytes kept for any one allocation size
+  //
+  std::size_t max_bucket_bytes = std::size_t{64} << 20;
+
+  // the most bytes kept across every size
+  //
+  std::size_t max_cached_bytes = std::size_t{256} << 20;
+
+  // the number of distinct sizes that are recycled, blocks of any other size go straight back
+  // upstream
+  //
+  std::size_t max_buckets = 32;
+};
+
+struct recycling_stats
+{
+  std::size_t hits      = 0; // allocations served from a bucket
+  std::size_t misses    = 0; // allocations that went upstream
+  std::size_t recycled  = 0; // deallocations kept in a bucket
+  std::size_t discarded = 0; // deallocations returned upstream because a limit was reached
+
+  std::size_t cached_bytes = 0;
+};
+
+// a cache of freed blocks kept in buckets keyed on their exact size and alignment
+//
+// workloads that churn through arrays of a handful of distinct sizes get their storage back
+// without a trip through malloc's free lists or an `munmap`/`mmap` pair for large blocks, and a
+// recycled block has already been faulted in which makes it a good match for `noinit` arrays
+//
+// the buckets are searched linearly as this is meant for a few dozen sizes at most
+//
+// every member function is thread-safe, the resource must outlive everything allocated from it
+//
+struct recycling_resource
+{
+private:
+  struct node
+  {
+    node* next;
+  };
+
+  struct bucket
+  {
+    std::size_t bytes;
+    std::size_t align;
+    node*       head;
+    std::size_t count;
+  };
+
+  recycling_options   options_;
+  recycling_stats     stats_;
+  std::vector<bucket> buckets_;
+  mutable std::mutex  mtx_;
+
+  static auto
+  upstream_allocate(std::size_t bytes, std::size_t align) -> void*
+  {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(bytes, std::align_val_t{align});
+    }
+    return ::operator new(bytes);
+  }
+
+  static auto
+  upstream_deallocate(void* p, std::size_t align) noexcept -> void
+  {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator delete(p, std::align_val_t{align});
+    }
+    ::operator delete(p);
+  }
+
+  // everything from `::operator new` is at least this aligned so smaller alignments share a bucket
+  //
+  static auto
+  normalize(std::size_t align) noexcept -> std::size_t
+  {
+    return align < __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? __STDCPP_DEFAULT_NEW_ALIGNMENT__ : align;
+  }
+
+  auto
+  find(std::size_t bytes, std::size_t align) noexcept -> bucket*
+  {
+    for (auto& b : buckets_) {
+      if (b.bytes == bytes && b.align == align) { return &b; }
+    }
+    return nullptr;
+  }
+
+public:
+  recycling_resource()
+    : recycling_resource(recycling_options())
+  {
+  }
+
+  explicit recycling_resource(recycling_options const& options)
+    : options_{options}
+  {
+    // reserved up-front so that adding a bucket on deallocation can never throw
+    //
+    buckets_.reserve(options_.max_buckets);
+  }
+
+  recycling_resource(recycling_resource const&) = delete;
+
+  auto
+  operator=(recycling_resource const&) -> recycling_resource& = delete;
+
+  ~recycling_resource() { release(); }
+
+  auto
+  allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) -> void*
+  {
+    align = normalize(align);
+
+    {
+      auto lock = std::lock_guard<std::mutex>(mtx_);
+
+      auto* const b = find(bytes, align);
+      if (b != nullptr && b->head != nullptr) {
+        auto* const n = b->head;
+        b->head       = n->next;
+        --b->count;
+
+        ++stats_.hits;
+        stats_.cached_bytes -= bytes;
+        return n;
+      }
+
+      ++stats_.misses;
+    }
+
+    return upstream_allocate(bytes, align);
+  }
+
+  auto
+  deallocate(void* p, std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept
+    -> void
+  {
+    align = normalize(align);
+
+    // too small to hold the free list link, these aren't what the cache is for anyway
+    //
+    if (bytes < sizeof(node)) { return upstream_deallocate(p, align); }
+
+    {
+      auto lock = std::lock_guard<std::mutex>(mtx_);
+
+      auto* b = find(bytes, align);
+      if (b == nullptr && buckets_.size() < options_.max_buckets) {
+        b = &buckets_.emplace_back(bucket{bytes, align, nullptr, 0});
+      }
+
+      if (b != nullptr && (b->count + 1) * bytes <= options_.max_bucket_bytes &&
+          stats_.cached_bytes + bytes <= options_.max_cached_bytes) {
+        auto* const n = static_cast<node*>(p);
+        n->next       = b->head;
+        b->head       = n;
+        ++b->count;
+
+        ++stats_.recycled;
+        stats_.cached_bytes += bytes;
+        return;
+      }
+
+      ++stats_.discarded;
+    }
+
+    upstream_deallocate(p, align);
+  }
+
+  // returns every cached block upstream, blocks that are still in use are unaffected
+  //
+  auto
+  release() noexcept -> void
+  {
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+
+    for (auto& b : buckets_) {
+      while (b.head != nullptr) {
+        auto* const n = b.head;
+        b.head        = n->next;
+        upstream_deallocate(n, b.align);
+      }
+      b.count = 0;
+    }
+
+    buckets_.clear();
+    stats_.cached_bytes = 0;
+  }
+
+  auto
+  stats() const -> recycling_stats
+  {
+    auto lock = std::lock_guard<std::mutex>(mtx_);
+    return stats_;
+  }
+
+  auto
+  options() const noexcept -> recycling_options const&
+  {
+    return options_;
+  }
+};
+
+// an Allocator that draws its storage from a `recycling_resource`
+//
+template <class T>
+struct recycling_allocator
+{
+  using value_type = T;
+
+  using is_always_equal                        = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  recycling_resource* resource_;
+
+  recycling_allocator(recycling_resource& r) noexcept
+    : resource_{&r}
+  {
+  }
+
+  template <class U>
+  recycling_allocator(recycling_allocator<U> const& other) noexcept
+    : resource_{other.resource_}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    resource_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  auto
+  resource() const noexcept -> recycling_resource&
+  {
+    return *resource_;
+  }
+};
+
+template <class T, class U>
+auto
+operator==(recycling_allocator<T> const& lhs, recycling_allocator<U> const& rhs) noexcept -> bool
+{
+  return lhs.resource_ == rhs.resource_;
+}
+
+template <class T, class U>
+auto
+operator!=(recycling_allocator<T> const& lhs, recycling_allocator<U> const& rhs) noexcept -> bool
+{
+  return !(lhs == rhs);
+}
+} // namespace sleip
+
+#endif // SLEIP_RECYCLING_RESOURCE_HPP_
@@ -0,0 +1,466 @@
+#ifndef SLEIP_SERIALIZATION_HPP_
+#define SLEIP_SERIALIZATION_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/config.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if (defined(BOOST_GCC) || defined(BOOST_CLANG)) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define SLEIP_HAS_X86_CRC32C
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SLEIP_HAS_ARM_CRC32C
+#endif
+
+namespace sleip
+{
+// thrown when loading input that isn't a well-formed serialized `dynamic_array<T>`
+//
+struct serialization_error : std::runtime_error
+{
+  using std::runtime_error::runtime_error;
+};
+
+// the serialized form of a `dynamic_array<T>` is
+//
+//   offset  size  field
+//   0       4     magic, "SLDA"
+//   4       2     format version
+//   6       1     byte order of the payload, 0 for little and 1 for big endian
+//   7       1     sizeof(std::remove_all_extents_t<T>), the unit a byte swap operates on
+//                 or 0 if that doesn't fit in a byte
+//   8       8     sizeof(T)
+//   16      8     size(), the number of elements
+//   24      8     detail::array_size_v<T>, the number of scalars in one element
+//   32      n     the elements exactly as they are laid out in memory
+//   32 + n  4     CRC32C of every preceding byte
+//
+// the header and trailer are always little endian, the payload is in the writer's byte order so
+// saving is a straight copy and only a reader of the opposite byte order pays for a swap
+//
+inline constexpr std::uint16_t const serialization_version = 1;
+
+namespace detail
+{
+inline constexpr std::size_t const serialization_header_size  = 32;
+inline constexpr std::size_t const serialization_trailer_size = 4;
+
+// the payload is moved in pieces of about 256 KiB so that each one is checksummed and
+// byte-swapped while it's still in cache, a whole number of elements keeps the swap from ever
+// straddling two pieces
+//
+template <class T>
+inline constexpr std::size_t const serialization_chunk_size =
+  std::max<std::size_t>((std::size_t{256} << 10) / sizeof(T), 1) * sizeof(T);
+
+inline constexpr unsigned char const serialization_magic[4] = {'S', 'L', 'D', 'A'};
+
+inline constexpr auto const native_byte_order = static_cast<std::uint8_t>(
+  boost::endian::order::native == boost::endian::order::little ? 0 : 1);
+
+inline auto
+crc32c_table() noexcept -> std::array<std::uint32_t, 256> const&
+{
+  static auto const table = [] {
+    auto t = std::array<std::uint32_t, 256>();
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      auto c = i;
+      for (auto k = 0; k < 8; ++k) { c = (c >> 1) ^ ((c & 1) ? 0x82F63B78u : 0u); }
+      t[i] = c;
+    }
+    return t;
+  }();
+  return table;
+}
+
+inline auto
+crc32c_sw(std::uint32_t crc, unsigned char const* p, std::size_t n) noexcept -> std::uint32_t
+{
+  auto const& t = crc32c_table();
+  for (std::size_t i = 0; i < n; ++i) { crc = t[(crc ^ p[i]) & 0xFF] ^ (crc >> 8); }
+  return crc;
+}
+
+#ifdef SLEIP_HAS_X86_CRC32C
+
+// built for SSE 4.2 regardless of the flags the rest of the program uses and only called once
+// the CPU has been checked, so the default x86-64 baseline still gets the hardware instruction
+//
+__attribute__((target("sse4.2"))) inline auto
+crc32c_hw(std::uint32_t crc, unsigned char const* p, std::size_t n) noexcept -> std::uint32_t
+{
+#ifdef __x86_64__
+  auto c = std::uint64_t{crc};
+  for (; n >= 8; n -= 8, p += 8) {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    c = _mm_crc32_u64(c, v);
+  }
+  crc = static_cast<std::uint32_t>(c);
+#endif
+  for (; n >= 4; n -= 4, p += 4) {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    crc = _mm_crc32_u32(crc, v);
+  }
+  for (; n > 0; --n, ++p) { crc = _mm_crc32_u8(crc, *p); }
+  return crc;
+}
+
+inline auto
+has_crc32c_hw() noexcept -> bool
+{
+  static bool const has = __builtin_cpu_supports("sse4.2");
+  return has;
+}
+
+#elif defined(SLEIP_HAS_ARM_CRC32C)
+
+inline auto
+crc32c_hw(std::uint32_t crc, unsigned char const* p, std::size_t n) noexcept -> std::uint32_t
+{
+  for (; n >= 8; n -= 8, p += 8) {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    crc = __crc32cd(crc, v);
+  }
+  for (; n > 0; --n, ++p) { crc = __crc32cb(crc, *p); }
+  return crc;
+}
+
+inline auto
+has_crc32c_hw() noexcept -> bool
+{
+  return true;
+}
+
+#endif
+
+// continues the CRC32C `crc` of some preceding bytes over `[p, p + n)`, start from 0
+//
+inline auto
+crc32c(std::uint32_t crc, void const* p, std::size_t n) noexcept -> std::uint32_t
+{
+  auto const* const bytes = static_cast<unsigned char const*>(p);
+
+  crc = ~crc;
+#if defined(SLEIP_HAS_X86_CRC32C) || defined(SLEIP_HAS_ARM_CRC32C)
+  if (has_crc32c_hw()) { return ~crc32c_hw(crc, bytes, n); }
+#endif
+  return ~crc32c_sw(crc, bytes, n);
+}
+
+// reverses the bytes of each of the `n` scalars of type `U` at `p`
+//
+// a plain loop over `endian_reverse` is what GCC and Clang vectorize into `pshufb` when SSSE3 or
+// better is enabled and into `rev` on ARM, anything cleverer would only get in their way
+//
+template <class U>
+auto
+byte_swap_as(unsigned char* p, std::size_t n) noexcept -> void
+{
+  for (std::size_t i = 0; i < n; ++i, p += sizeof(U)) {
+    U v;
+    std::memcpy(&v, p, sizeof(U));
+    v = boost::endian::endian_reverse(v);
+    std::memcpy(p, &v, sizeof(U));
+  }
+}
+
+inline auto
+byte_swap(unsigned char* p, std::size_t num_bytes, std::size_t scalar_size) noexcept -> void
+{
+  auto const n = num_bytes / scalar_size;
+  switch (scalar_size) {
+    case 1: return;
+    case 2: return byte_swap_as<std::uint16_t>(p, n);
+    case 4: return byte_swap_as<std::uint32_t>(p, n);
+    case 8: return byte_swap_as<std::uint64_t>(p, n);
+    default:
+      for (std::size_t i = 0; i < n; ++i, p += scalar_size) { std::reverse(p, p + scalar_size); }
+  }
+}
+
+template <class U>
+auto
+store_le(unsigned char* p, U v) noexcept -> void
+{
+  v = boost::endian::native_to_little(v);
+  std::memcpy(p, &v, sizeof(U));
+}
+
+template <class U>
+auto
+load_le(unsigned char const* p) noexcept -> U
+{
+  U v;
+  std::memcpy(&v, p, sizeof(U));
+  return boost::endian::little_to_native(v);
+}
+
+template <class T>
+using serialization_scalar_t = std::remove_all_extents_t<T>;
+
+// only scalars whose object representation is a single number can be fixed up by reversing bytes
+//
+template <class T>
+inline constexpr bool const is_byte_swappable_v =
+  std::is_arithmetic_v<serialization_scalar_t<T>> || std::is_enum_v<serialization_scalar_t<T>>;
+
+// the scalar size gets a single byte, a scalar too large for it records `0` instead, which loses
+// nothing since `sizeof(T)` and the extent pin it down and such a scalar is never byte-swapped
+//
+template <class T>
+inline constexpr unsigned char const serialization_scalar_size =
+  sizeof(serialization_scalar_t<T>) <= std::numeric_limits<unsigned char>::max()
+    ? static_cast<unsigned char>(sizeof(serialization_scalar_t<T>))
+    : 0;
+
+template <class T>
+auto
+make_header(std::size_t count) noexcept -> std::array<unsigned char, serialization_header_size>
+{
+  auto h = std::array<unsigned char, serialization_header_size>();
+  std::memcpy(h.data(), serialization_magic, 4);
+  store_le(h.data() + 4, serialization_version);
+  h[6] = native_byte_order;
+  h[7] = serialization_scalar_size<T>;
+  store_le(h.data() + 8, std::uint64_t{sizeof(T)});
+  store_le(h.data() + 16, std::uint64_t{count});
+  store_le(h.data() + 24, std::uint64_t{array_size_v<T>});
+  return h;
+}
+
+[[noreturn]] inline auto
+throw_serialization_error(char const* what) -> void
+{
+  boost::throw_exception(serialization_error(what));
+}
+
+// the number of bytes left in `is`, or `-1` if it can't seek
+//
+inline auto
+stream_remaining(std::istream& is) -> std::streamoff
+{
+  auto const pos = is.tellg();
+  if (pos == std::streampos(-1) || !is.seekg(0, std::ios_base::end)) {
+    is.clear();
+    return -1;
+  }
+
+  auto const end = is.tellg();
+  is.seekg(pos);
+  return end - pos;
+}
+
+// validates a header against `T`, returning the element count and whether the payload needs
+// byte-swapping
+//
+template <class T>
+auto
+parse_header(unsigned char const* h) -> std::pair<std::size_t, bool>
+{
+  if (std::memcmp(h, serialization_magic, 4) != 0) {
+    throw_serialization_error("sleip::load -> not a serialized dynamic_array");
+  }
+  if (load_le<std::uint16_t>(h + 4) != serialization_version) {
+    throw_serialization_error("sleip::load -> unsupported format version");
+  }
+  if (h[6] > 1) { throw_serialization_error("sleip::load -> invalid byte order"); }
+
+  if (h[7] != serialization_scalar_size<T> || load_le<std::uint64_t>(h + 8) != sizeof(T) ||
+      load_le<std::uint64_t>(h + 24) != array_size_v<T>) {
+    throw_serialization_error("sleip::load -> element type does not match");
+  }
+
+  auto const count = load_le<std::uint64_t>(h + 16);
+  if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+    throw_serialization_error("sleip::load -> element count is too large");
+  }
+
+  auto const swap = h[6] != native_byte_order;
+  if constexpr (!is_byte_swappable_v<T>) {
+    if (swap) { throw_serialization_error("sleip::load -> can't byte-swap this element type"); }
+  }
+
+  return {static_cast<std::size_t>(count), swap};
+}
+} // namespace detail
+
+// the number of bytes `save` produces for `a`
+//
+template <class T, class Allocator>
+auto
+serialized_size(dynamic_array<T, Allocator> const& a) noexcept -> std::size_t
+{
+  return detail::serialization_header_size + a.size() * sizeof(T) +
+         detail::serialization_trailer_size;
+}
+
+// writes `a` to `os`, failures are reported through the state of `os` like any other insertion
+//
+template <class T, class Allocator>
+auto
+save(std::ostream& os, dynamic_array<T, Allocator> const& a) -> void
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be saved");
+
+  auto const header = detail::make_header<T>(a.size());
+  auto const len    = a.size() * sizeof(T);
+
+  auto crc = detail::crc32c(0, header.data(), header.size());
+  crc      = detail::crc32c(crc, a.data(), len);
+
+  auto trailer = std::array<unsigned char, detail::serialization_trailer_size>();
+  detail::store_le(trailer.data(), crc);
+
+  os.write(reinterpret_cast<char const*>(header.data()), header.size());
+  os.write(reinterpret_cast<char const*>(a.data()), static_cast<std::streamsize>(len));
+  os.write(reinterpret_cast<char const*>(trailer.data()), trailer.size());
+}
+
+// writes `a` to the `buf_size` bytes at `buf`, returning the number of bytes written
+//
+// throws `std::length_error` if `buf_size` is smaller than `serialized_size(a)`
+//
+template <class T, class Allocator>
+auto
+save(void* buf, std::size_t buf_size, dynamic_array<T, Allocator> const& a) -> std::size_t
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be saved");
+
+  auto const total = serialized_size(a);
+  if (buf_size < total) {
+    boost::throw_exception(std::length_error("sleip::save -> buffer is too small"));
+  }
+
+  auto* const out    = static_cast<unsigned char*>(buf);
+  auto const  header = detail::make_header<T>(a.size());
+  auto const  len    = a.size() * sizeof(T);
+
+  std::memcpy(out, header.data(), header.size());
+  if (len > 0) { std::memcpy(out + header.size(), a.data(), len); }
+
+  detail::store_le(out + header.size() + len, detail::crc32c(0, out, header.size() + len));
+  return total;
+}
+
+// reads a `dynamic_array<T>` previously written by `save` from `is`
+//
+// the elements are read straight into `noinit` storage and byte-swapped only if the writer's byte
+// order differs from ours
+//
+template <class T, class Allocator = std::allocator<T>>
+auto
+load(std::istream& is, Allocator const& alloc = Allocator()) -> dynamic_array<T, Allocator>
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be loaded");
+
+  auto read = [&](void* p, std::size_t n) {
+    if (!is.read(static_cast<char*>(p), static_cast<std::streamsize>(n))) {
+      detail::throw_serialization_error("sleip::load -> unexpected end of input");
+    }
+  };
+
+  auto header = std::array<unsigned char, detail::serialization_header_size>();
+  read(header.data(), header.size());
+
+  auto const [count, swap] = detail::parse_header<T>(header.data());
+
+  constexpr auto const chunk_size = detail::serialization_chunk_size<T>;
+
+  // the count is whatever the input says, so it only sizes the array once the input is known to
+  // hold that many bytes, a stream that can't seek gets an array that grows as the bytes arrive
+  //
+  auto const len       = count * sizeof(T);
+  auto const remaining = detail::stream_remaining(is);
+  if (remaining >= 0 && static_cast<std::uint64_t>(remaining) <
+                          std::uint64_t{len} + detail::serialization_trailer_size) {
+    detail::throw_serialization_error("sleip::load -> unexpected end of input");
+  }
+
+  auto const initial = remaining >= 0 ? count : std::min(count, chunk_size / sizeof(T));
+  auto       a       = dynamic_array<T, Allocator>(initial, noinit, alloc);
+
+  auto crc = detail::crc32c(0, header.data(), header.size());
+
+  for (std::size_t off = 0; off < len; off += chunk_size) {
+    // both are whole chunks until the array reaches `count`, so doubling always makes room
+    //
+    if (off == a.size() * sizeof(T)) { a.reallocate(std::min(count, 2 * a.size()), noinit); }
+
+    auto* const p = reinterpret_cast<unsigned char*>(a.data());
+    auto const  n = std::min(chunk_size, len - off);
+    read(p + off, n);
+    crc = detail::crc32c(crc, p + off, n);
+    if (swap) { detail::byte_swap(p + off, n, sizeof(detail::serialization_scalar_t<T>)); }
+  }
+
+  auto trailer = std::array<unsigned char, detail::serialization_trailer_size>();
+  read(trailer.data(), trailer.size());
+  if (detail::load_le<std::uint32_t>(trailer.data()) != crc) {
+    detail::throw_serialization_error("sleip::load -> checksum mismatch");
+  }
+
+  return a;
+}
+
+// reads a `dynamic_array<T>` previously written by `save` from the `buf_size` bytes at `buf`
+//
+template <class T, class Allocator = std::allocator<T>>
+auto
+load(void const* buf, std::size_t buf_size, Allocator const& alloc = Allocator())
+  -> dynamic_array<T, Allocator>
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be loaded");
+
+  auto const* const in = static_cast<unsigned char const*>(buf);
+
+  if (buf_size < detail::serialization_header_size + detail::serialization_trailer_size) {
+    detail::throw_serialization_error("sleip::load -> unexpected end of input");
+  }
+
+  auto const [count, swap] = detail::parse_header<T>(in);
+
+  auto const len = count * sizeof(T);
+  if (len > buf_size - detail::serialization_header_size - detail::serialization_trailer_size) {
+    detail::throw_serialization_error("sleip::load -> unexpected end of input");
+  }
+
+  auto a = dynamic_array<T, Allocator>(count, noinit, alloc);
+
+  auto*       p   = reinterpret_cast<unsigned char*>(a.data());
+  auto const* src = in + detail::serialization_header_size;
+  auto        crc = detail::crc32c(0, in, detail::serialization_header_size);
+
+  for (std::size_t off = 0; off < len; off += detail::serialization_chunk_size<T>) {
+    auto const n = std::min(detail::serialization_chunk_size<T>, len - off);
+    crc          = detail::crc32c(crc, src + off, n);
+    std::memcpy(p + off, src + off, n);
+    if (swap) { detail::byte_swap(p + off, n, sizeof(detail::serialization_scalar_t<T>)); }
+  }
+
+  if (detail::load_le<std::uint32_t>(src + len) != crc) {
+    detail::throw_serialization_error("sleip::load -> checksum mismatch");
+  }
+
+  return a;
+}
+} // namespace sleip
+
+#endif // SLEIP_SERIALIZATION_HPP_
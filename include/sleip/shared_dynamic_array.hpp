@@ -0,0 +1,768 @@
+#ifndef SLEIP_SHARED_DYNAMIC_ARRAY_HPP_
+#define SLEIP_SHARED_DYNAMIC_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/alloc_construct.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/noinit_adaptor.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <boost/core/first_scalar.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+// an immutable array whose elements are shared between every copy of the handle, the reference
+// count lives in a header at the front of the same allocation so sharing costs neither a second
+// allocation nor a second indirection as `std::shared_ptr<dynamic_array<T>>` does
+//
+// copying bumps the count and `slice()` shares a sub-range of the same block, `unique_data()` and
+// `unshare()` get a mutable view back once no other handle can see the elements
+//
+// distinct handles may be copied and destroyed from different threads concurrently, as with
+// `std::shared_ptr`
+//
+template <class T, class Allocator = std::allocator<T>>
+struct shared_dynamic_array : boost::empty_value<Allocator>
+{
+public:
+  using value_type             = T;
+  using allocator_type         = Allocator;
+  using size_type              = typename std::allocator_traits<Allocator>::size_type;
+  using difference_type        = typename std::allocator_traits<Allocator>::difference_type;
+  using reference              = value_type const&;
+  using const_reference        = value_type const&;
+  using pointer                = typename std::allocator_traits<Allocator>::const_pointer;
+  using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+  using iterator               = value_type const*;
+  using const_iterator         = value_type const*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static_assert(
+    std::is_object_v<T> && (!std::is_array_v<T> || boost::is_bounded_array<T>::value),
+    "Only support object types, including bound array types. Unbound arrays are not supported");
+
+  static_assert(std::is_same_v<typename allocator_type::value_type, value_type>,
+                "Allocator's value type must match container's");
+
+private:
+  // the count of handles that share the block and the number of elements it was built with, which
+  // a slice no longer knows
+  //
+  struct header
+  {
+    std::atomic<std::size_t> refs;
+    std::size_t              size;
+
+    explicit header(std::size_t count) noexcept
+      : refs(1)
+      , size(count)
+    {
+    }
+  };
+
+  // laid out as `thin_dynamic_array` is, in units as aligned as the elements, the header and the
+  // allocator's over-alignment, with the header in the leading ones
+  //
+  static constexpr std::size_t const unit_align_ =
+    std::max({alignof(T), alignof(header), detail::allocator_alignment_v<Allocator>});
+
+  struct alignas(unit_align_) unit
+  {
+    unsigned char bytes[unit_align_];
+  };
+
+  static constexpr std::size_t const header_units_ =
+    (sizeof(header) + sizeof(unit) - 1) / sizeof(unit);
+
+  using unit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unit>;
+  using unit_traits    = std::allocator_traits<unit_allocator>;
+  using unit_pointer   = typename unit_traits::pointer;
+
+  // the view is kept as an offset into the block rather than a raw pointer so the handle stays
+  // valid wherever a fancy pointer's block happens to be mapped
+  //
+  unit_pointer block_  = nullptr;
+  size_type    offset_ = 0;
+  size_type    size_   = 0;
+
+  auto
+  alloc_() noexcept -> Allocator&
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  static auto
+  num_units_(std::size_t count) -> std::size_t
+  {
+    if (count > (std::numeric_limits<std::size_t>::max() - (header_units_ + 1) * sizeof(unit)) /
+                  sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return header_units_ + (count * sizeof(T) + sizeof(unit) - 1) / sizeof(unit);
+  }
+
+  static auto
+  header_(unit_pointer const& block) noexcept -> header*
+  {
+    return std::launder(reinterpret_cast<header*>(boost::to_address(block)));
+  }
+
+  static auto
+  elements_(unit_pointer const& block) noexcept -> T*
+  {
+    return detail::assume_aligned<unit_align_>(
+      reinterpret_cast<T*>(boost::to_address(block) + header_units_));
+  }
+
+  auto
+  deallocate_(unit_pointer block, std::size_t count) noexcept -> void
+  {
+    header_(block)->~header();
+
+    auto a = unit_allocator(alloc_());
+    unit_traits::deallocate(a, block, num_units_(count));
+  }
+
+  auto
+  destroy_elements_(T* first, std::size_t count) noexcept -> void
+  {
+    boost::alloc_destroy_n(alloc_(), boost::first_scalar(first), detail::num_elems<T>(count));
+  }
+
+  template <typename Allocator_, typename... Args>
+  auto
+  create_(Allocator_& alloc, std::size_t count, Args&&... args) -> unit_pointer
+  {
+    if (count == 0) { return nullptr; }
+
+    auto       a = unit_allocator(alloc_());
+    auto const n = num_units_(count);
+
+    unit_pointer block = nullptr;
+    if constexpr (sizeof...(Args) == 0 && std::is_same_v<Allocator_, Allocator> &&
+                  detail::is_zero_allocatable_v<T, Allocator> &&
+                  detail::has_allocate_zeroed<unit_allocator>::value) {
+      block = a.allocate_zeroed(n);
+    } else {
+      block = unit_traits::allocate(a, n);
+      try {
+        boost::alloc_construct_n(alloc, boost::first_scalar(elements_(block)),
+                                 detail::num_elems<T>(count), std::forward<Args>(args)...);
+      }
+      catch (...) {
+        unit_traits::deallocate(a, block, n);
+        throw;
+      }
+    }
+
+    ::new (static_cast<void*>(boost::to_address(block))) header(count);
+    return block;
+  }
+
+  template <typename Allocator_>
+  auto
+  copy_create_(Allocator_& alloc, std::size_t count, T const* src) -> unit_pointer
+  {
+    if constexpr (detail::is_bulk_copyable_v<T, Allocator_>) {
+      if (count == 0) { return nullptr; }
+
+      auto a     = unit_allocator(alloc_());
+      auto block = unit_traits::allocate(a, num_units_(count));
+
+      ::new (static_cast<void*>(boost::to_address(block))) header(count);
+      std::memcpy(elements_(block), src, count * sizeof(T));
+      return block;
+    } else {
+      return create_(alloc, count, boost::first_scalar(src));
+    }
+  }
+
+  auto
+  retain_() const noexcept -> void
+  {
+    if (block_ == nullptr) { return; }
+
+    // a new reference can only be made from an existing one so nothing has to be ordered here
+    //
+    header_(block_)->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // drops this handle's reference, the last one out destroys every element of the block and not
+  // just the ones its own slice can see
+  //
+  auto
+  release_() noexcept -> void
+  {
+    if (block_ != nullptr) {
+      auto* const h = header_(block_);
+      if (h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        auto const count = h->size;
+        destroy_elements_(elements_(block_), count);
+        deallocate_(block_, count);
+      }
+    }
+
+    block_  = nullptr;
+    offset_ = 0;
+    size_   = 0;
+  }
+
+  // rebinding to the block this handle already holds, e.g. to another slice of it, leaves the
+  // count alone
+  //
+  auto
+  share_(shared_dynamic_array const& other) noexcept -> void
+  {
+    if (block_ != other.block_) {
+      other.retain_();
+      release_();
+    }
+
+    block_  = other.block_;
+    offset_ = other.offset_;
+    size_   = other.size_;
+  }
+
+  auto
+  steal_(shared_dynamic_array& other) noexcept -> void
+  {
+    release_();
+
+    block_  = std::exchange(other.block_, nullptr);
+    offset_ = std::exchange(other.offset_, 0);
+    size_   = std::exchange(other.size_, 0);
+  }
+
+  auto
+  own_(unit_pointer block, std::size_t count) noexcept -> void
+  {
+    block_  = block;
+    offset_ = 0;
+    size_   = block == nullptr ? 0 : count;
+  }
+
+public:
+  shared_dynamic_array() noexcept(noexcept(Allocator()))
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+  }
+
+  explicit shared_dynamic_array(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+  }
+
+  shared_dynamic_array(size_type count, T const& value, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    own_(create_(alloc_(), count, boost::first_scalar(std::addressof(value)),
+                 detail::num_elems<T>(1)),
+         count);
+  }
+
+  explicit shared_dynamic_array(size_type count, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    own_(create_(alloc_(), count), count);
+  }
+
+  // for producers that fill the elements in place through `unique_data()` before handing out
+  // copies
+  //
+  explicit shared_dynamic_array(size_type count, noinit_t, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto a = boost::noinit_adapt(alloc_());
+    own_(create_(a, count), count);
+  }
+
+  template <class ForwardIterator,
+            std::enable_if_t<detail::is_forward_iterator_v<ForwardIterator>, int> = 0>
+  shared_dynamic_array(ForwardIterator  first,
+                       ForwardIterator  last,
+                       Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto const count = static_cast<size_type>(std::distance(first, last));
+
+    if constexpr (detail::is_contiguous_iterator_v<ForwardIterator, T>) {
+      own_(copy_create_(alloc_(), count, detail::to_address(first)), count);
+    } else {
+      own_(create_(alloc_(), count, detail::array_walker<ForwardIterator>{first}), count);
+    }
+  }
+
+  // publishes the elements of `other`, relocating them when the type allows it, and leaves
+  // `other` empty
+  //
+  explicit shared_dynamic_array(dynamic_array<T, Allocator>&& other)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, other.get_allocator())
+  {
+    auto const count = other.size();
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      if (count == 0) { return; }
+
+      auto a     = unit_allocator(alloc_());
+      auto block = unit_traits::allocate(a, num_units_(count));
+
+      ::new (static_cast<void*>(boost::to_address(block))) header(count);
+      std::memcpy(static_cast<void*>(elements_(block)), other.data(), count * sizeof(T));
+      own_(block, count);
+
+      // the bytes now live in the shared block so the old storage goes back without running any
+      // destructors
+      //
+      auto released = other.release();
+      std::allocator_traits<Allocator>::deallocate(released.allocator, released.data,
+                                                   released.size);
+    } else {
+      own_(create_(alloc_(), count,
+                   detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                     boost::first_scalar(other.data())}),
+           count);
+
+      auto const drop = std::move(other);
+    }
+  }
+
+  // the copy shares the block so it has to share the allocator that can free it, which is why
+  // `select_on_container_copy_construction` isn't consulted
+  //
+  shared_dynamic_array(shared_dynamic_array const& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, other.get_allocator())
+  {
+    share_(other);
+  }
+
+  // shares the block when `alloc` could free it and copies the elements otherwise
+  //
+  shared_dynamic_array(shared_dynamic_array const& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      share_(other);
+    } else {
+      own_(copy_create_(alloc_(), other.size(), other.data()), other.size());
+    }
+  }
+
+  shared_dynamic_array(shared_dynamic_array&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, std::move(other.get_allocator()))
+  {
+    steal_(other);
+  }
+
+  shared_dynamic_array(shared_dynamic_array&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      steal_(other);
+    } else {
+      own_(copy_create_(alloc_(), other.size(), other.data()), other.size());
+    }
+  }
+
+  shared_dynamic_array(std::initializer_list<T> init, Allocator const& alloc = Allocator())
+    : shared_dynamic_array(init.begin(), init.end(), alloc)
+  {
+  }
+
+  template <class Range, std::enable_if_t<detail::is_range_v<Range>, int> = 0>
+  shared_dynamic_array(Range const& range, Allocator const& alloc = Allocator())
+    : shared_dynamic_array(detail::sleip_begin(range), detail::sleip_end(range), alloc)
+  {
+  }
+
+  ~shared_dynamic_array() { release_(); }
+
+  // the elements are never assigned to, every assignment rebinds the handle
+  //
+  auto
+  operator=(shared_dynamic_array const& other) & -> shared_dynamic_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocca =
+      std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+    if (pocca || alloc_() == other.get_allocator()) {
+      share_(other);
+      if constexpr (pocca) {
+        alloc_() = static_cast<boost::empty_value<Allocator> const&>(other).get();
+      }
+      return *this;
+    }
+
+    auto tmp = shared_dynamic_array(other, alloc_());
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+    operator=(shared_dynamic_array&& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> shared_dynamic_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocma =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+    if (pocma || alloc_() == other.get_allocator()) {
+      release_();
+
+      if constexpr (pocma) {
+        alloc_() = std::move(static_cast<boost::empty_value<Allocator>&>(other).get());
+      }
+      steal_(other);
+
+      return *this;
+    }
+
+    auto tmp = shared_dynamic_array(std::move(other), alloc_());
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  auto
+  size() const noexcept -> size_type
+  {
+    return size_;
+  }
+
+  // null for an empty array, like `dynamic_array`
+  //
+  auto
+  data() const noexcept -> T const*
+  {
+    if (block_ == nullptr) { return nullptr; }
+    return elements_(block_) + offset_;
+  }
+
+  // the number of handles sharing the block, `0` for an empty array
+  //
+  auto
+  use_count() const noexcept -> std::size_t
+  {
+    if (block_ == nullptr) { return 0; }
+    return header_(block_)->refs.load(std::memory_order_relaxed);
+  }
+
+  // the acquire pairs with the release of every other handle's drop so their reads of the
+  // elements happen before whatever the caller writes next
+  //
+  auto
+  unique() const noexcept -> bool
+  {
+    return block_ != nullptr && header_(block_)->refs.load(std::memory_order_acquire) == 1;
+  }
+
+  // mutable access to the elements while this is the only handle to them and `nullptr` otherwise,
+  // only another handle could make a new reference so the answer can't go stale
+  //
+  auto
+  unique_data() noexcept -> T*
+  {
+    if (!unique()) { return nullptr; }
+    return elements_(block_) + offset_;
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  at(size_type pos) const -> const_reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::shared_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data()[pos];
+  }
+
+  auto operator[](size_type pos) const -> const_reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data()[pos];
+  }
+
+  auto
+  front() const -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *cbegin();
+  }
+
+  auto
+  back() const -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(cend() - 1);
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  auto
+  max_size() const noexcept -> size_type
+  {
+    return -1;
+  }
+
+  // `count` elements from `offset` on, sharing the block instead of copying them
+  //
+  auto
+  slice(size_type offset, size_type count) const& -> shared_dynamic_array
+  {
+    auto result = shared_dynamic_array(*this);
+    result.narrow_(offset, count);
+    return result;
+  }
+
+  auto
+  slice(size_type offset, size_type count) && -> shared_dynamic_array
+  {
+    narrow_(offset, count);
+    return std::move(*this);
+  }
+
+  // hands the elements back as a mutable `dynamic_array` and leaves `*this` empty
+  //
+  // the reference count shares the allocation so the block can't be adopted as is, a unique handle
+  // relocates or moves its elements into a fresh one instead, a shared handle copies them
+  //
+  auto
+  unshare() && -> dynamic_array<T, Allocator>
+  {
+    using array_type   = dynamic_array<T, Allocator>;
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    auto const count = size_;
+
+    if (count == 0) {
+      release_();
+      return array_type(alloc_());
+    }
+
+    if (!unique()) {
+      auto result = array_type(begin(), end(), alloc_());
+      release_();
+      return result;
+    }
+
+    auto& alloc = alloc_();
+    auto  data  = alloc_traits::allocate(alloc, count);
+    auto* first = elements_(block_) + offset_;
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      std::memcpy(static_cast<void*>(boost::to_address(data)), first, count * sizeof(T));
+
+      // the slice's elements now live in `data`, only those around it are left to destroy
+      //
+      auto const total = header_(block_)->size;
+      destroy_elements_(elements_(block_), offset_);
+      destroy_elements_(first + count, total - offset_ - count);
+      deallocate_(std::exchange(block_, nullptr), total);
+
+      offset_ = 0;
+      size_   = 0;
+    } else {
+      try {
+        boost::alloc_construct_n(alloc, boost::first_scalar(boost::to_address(data)),
+                                 detail::num_elems<T>(count),
+                                 detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                                   boost::first_scalar(first)});
+      }
+      catch (...) {
+        alloc_traits::deallocate(alloc, data, count);
+        throw;
+      }
+      release_();
+    }
+
+    return array_type(adopt, data, count, alloc);
+  }
+
+  auto
+    swap(shared_dynamic_array& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> void
+  {
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_(), other.alloc_());
+    } else {
+      BOOST_ASSERT(get_allocator() == other.get_allocator());
+    }
+
+    using std::swap;
+    swap(block_, other.block_);
+    swap(offset_, other.offset_);
+    swap(size_, other.size_);
+  }
+
+private:
+  auto
+  narrow_(size_type offset, size_type count) -> void
+  {
+    if (offset > size_ || count > size_ - offset) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::shared_dynamic_array::slice -> offset + count is larger than size()"));
+    }
+
+    if (count == 0) {
+      release_();
+      return;
+    }
+
+    offset_ += offset;
+    size_ = count;
+  }
+};
+
+template <class T, class Allocator>
+auto
+swap(shared_dynamic_array<T, Allocator>& lhs,
+     shared_dynamic_array<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class T, class Allocator>
+auto
+operator==(shared_dynamic_array<T, Allocator> const& lhs,
+           shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size()) { return false; }
+  return detail::elements_equal(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, class Allocator>
+auto
+operator!=(shared_dynamic_array<T, Allocator> const& lhs,
+           shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+template <class T, class Allocator>
+auto
+operator<(shared_dynamic_array<T, Allocator> const& lhs,
+          shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return detail::elements_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+template <class T, class Allocator>
+auto
+operator>(shared_dynamic_array<T, Allocator> const& lhs,
+          shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return rhs < lhs;
+}
+
+template <class T, class Allocator>
+auto
+operator<=(shared_dynamic_array<T, Allocator> const& lhs,
+           shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(rhs < lhs);
+}
+
+template <class T, class Allocator>
+auto
+operator>=(shared_dynamic_array<T, Allocator> const& lhs,
+           shared_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(lhs < rhs);
+}
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T, class Allocator>
+auto
+operator<=>(shared_dynamic_array<T, Allocator> const& lhs,
+            shared_dynamic_array<T, Allocator> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  return detail::elements_three_way(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+#endif
+} // namespace sleip
+
+#endif // SLEIP_SHARED_DYNAMIC_ARRAY_HPP_
@@ -0,0 +1,695 @@
+#ifndef SLEIP_SMALL_DYNAMIC_ARRAY_HPP_
+#define SLEIP_SMALL_DYNAMIC_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/alloc_construct.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/noinit_adaptor.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <boost/core/first_scalar.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+// a fixed-size array that keeps up to `N` elements inside the object itself and only goes to the
+// allocator for anything larger
+//
+// the inline buffer shares its storage with the heap pointer as the size alone, which never
+// changes, decides which of the two is live
+//
+// unlike `dynamic_array`, moving an array that's stored inline moves its elements one by one so
+// the move operations are only `noexcept` when `T`'s are
+//
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+struct small_dynamic_array : boost::empty_value<Allocator>
+{
+public:
+  using value_type             = T;
+  using allocator_type         = Allocator;
+  using size_type              = typename std::allocator_traits<Allocator>::size_type;
+  using difference_type        = typename std::allocator_traits<Allocator>::difference_type;
+  using reference              = value_type&;
+  using const_reference        = value_type const&;
+  using pointer                = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+  using iterator               = value_type*;
+  using const_iterator         = value_type const*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr std::size_t const inline_capacity = N;
+
+  static_assert(
+    std::is_object_v<T> && (!std::is_array_v<T> || boost::is_bounded_array<T>::value),
+    "Only support object types, including bound array types. Unbound arrays are not supported");
+
+  static_assert(std::is_same_v<typename allocator_type::value_type, value_type>,
+                "Allocator's value type must match container's");
+
+  static_assert(N > 0, "An inline capacity of 0 is a dynamic_array");
+
+private:
+  union storage
+  {
+    storage() noexcept {}
+    ~storage() {}
+
+    pointer heap;
+    alignas(T) unsigned char buf[N * sizeof(T)];
+  };
+
+  storage     s_;
+  std::size_t size_ = 0;
+
+  static constexpr bool const is_nothrow_movable_ =
+    std::is_nothrow_move_constructible_v<std::remove_all_extents_t<T>>;
+
+  auto
+  is_inline_() const noexcept -> bool
+  {
+    return size_ <= N;
+  }
+
+  auto
+  inline_data_() noexcept -> T*
+  {
+    return std::launder(reinterpret_cast<T*>(s_.buf));
+  }
+
+  auto
+  inline_data_() const noexcept -> T const*
+  {
+    return std::launder(reinterpret_cast<T const*>(s_.buf));
+  }
+
+  auto
+  alloc_() noexcept -> Allocator&
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  // builds `count` elements from `args` either inline or in a fresh allocation, `*this` must be
+  // empty
+  //
+  template <typename Allocator_, typename... Args>
+  auto
+  create_(Allocator_& alloc, std::size_t count, Args&&... args) -> void
+  {
+    BOOST_ASSERT(size_ == 0);
+
+    if (count <= N) {
+      auto* const p = boost::first_scalar(inline_data_());
+      boost::alloc_construct_n(alloc, p, detail::num_elems<T>(count), std::forward<Args>(args)...);
+      size_ = count;
+      return;
+    }
+
+    pointer data = nullptr;
+    if constexpr (sizeof...(Args) == 0 && std::is_same_v<Allocator_, Allocator> &&
+                  detail::is_zero_allocatable_v<T, Allocator>) {
+      data = alloc.allocate_zeroed(count);
+    } else {
+      data = std::allocator_traits<Allocator>::allocate(alloc, count);
+      try {
+        auto* const p = boost::first_scalar(boost::to_address(data));
+        boost::alloc_construct_n(alloc, p, detail::num_elems<T>(count),
+                                 std::forward<Args>(args)...);
+      }
+      catch (...) {
+        std::allocator_traits<Allocator>::deallocate(alloc, data, count);
+        throw;
+      }
+    }
+
+    ::new (static_cast<void*>(std::addressof(s_.heap))) pointer(data);
+    size_ = count;
+  }
+
+  template <typename Allocator_>
+  auto
+  copy_create_(Allocator_& alloc, std::size_t count, T const* src) -> void
+  {
+    if constexpr (detail::is_bulk_copyable_v<T, Allocator_>) {
+      BOOST_ASSERT(size_ == 0);
+
+      auto* dst = inline_data_();
+      if (count > N) {
+        pointer data = std::allocator_traits<Allocator>::allocate(alloc, count);
+        ::new (static_cast<void*>(std::addressof(s_.heap))) pointer(data);
+        dst = boost::to_address(data);
+      }
+
+      if (count > 0) { std::memcpy(dst, src, count * sizeof(T)); }
+      size_ = count;
+    } else {
+      create_(alloc, count, boost::first_scalar(src));
+    }
+  }
+
+  // destroys every element, releases any allocation and leaves `*this` empty
+  //
+  auto
+  destroy_() noexcept -> void
+  {
+    auto& alloc = alloc_();
+
+    boost::alloc_destroy_n(alloc, boost::first_scalar(data()), detail::num_elems<T>(size_));
+
+    if (!is_inline_()) {
+      std::allocator_traits<Allocator>::deallocate(alloc, s_.heap, size_);
+      s_.heap.~pointer();
+    }
+    size_ = 0;
+  }
+
+  // takes over the elements of `other`, which is left empty, either by adopting its allocation or
+  // by moving its inline elements across
+  //
+  // `*this` must be empty and its allocator must be able to free `other`'s storage
+  //
+  auto
+  steal_(small_dynamic_array& other) noexcept(is_nothrow_movable_) -> void
+  {
+    BOOST_ASSERT(size_ == 0);
+
+    if (!other.is_inline_()) {
+      ::new (static_cast<void*>(std::addressof(s_.heap))) pointer(std::move(other.s_.heap));
+      other.s_.heap.~pointer();
+      size_       = other.size_;
+      other.size_ = 0;
+      return;
+    }
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      if (other.size_ > 0) {
+        std::memcpy(static_cast<void*>(s_.buf), other.s_.buf, other.size_ * sizeof(T));
+      }
+      size_       = other.size_;
+      other.size_ = 0;
+    } else {
+      create_(alloc_(), other.size_, std::make_move_iterator(boost::first_scalar(other.data())));
+      other.destroy_();
+    }
+  }
+
+  auto
+  assign_in_place_(T const* src) noexcept -> void
+  {
+    static_assert(detail::is_nothrow_copy_assignable_v<T>);
+
+    if (size_ == 0 || data() == src) { return; }
+
+    auto const* const first = boost::first_scalar(src);
+    std::copy(first, first + detail::num_elems<T>(size_), boost::first_scalar(data()));
+  }
+
+public:
+  small_dynamic_array() noexcept(noexcept(Allocator()))
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+  }
+
+  explicit small_dynamic_array(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+  }
+
+  small_dynamic_array(size_type count, T const& value, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_(alloc_(), count, boost::first_scalar(std::addressof(value)), detail::num_elems<T>(1));
+  }
+
+  explicit small_dynamic_array(size_type count, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_(alloc_(), count);
+  }
+
+  explicit small_dynamic_array(size_type count, noinit_t, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto a = boost::noinit_adapt(alloc_());
+    create_(a, count);
+  }
+
+  template <class ForwardIterator,
+            std::enable_if_t<detail::is_forward_iterator_v<ForwardIterator>, int> = 0>
+  small_dynamic_array(ForwardIterator  first,
+                      ForwardIterator  last,
+                      Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto const count = static_cast<size_type>(std::distance(first, last));
+
+    if constexpr (detail::is_contiguous_iterator_v<ForwardIterator, T>) {
+      copy_create_(alloc_(), count, detail::to_address(first));
+    } else {
+      create_(alloc_(), count, detail::array_walker<ForwardIterator>{first});
+    }
+  }
+
+  small_dynamic_array(small_dynamic_array const& other)
+    : boost::empty_value<Allocator>(
+        boost::empty_init_t{},
+        std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+          other.get_allocator()))
+  {
+    copy_create_(alloc_(), other.size(), other.data());
+  }
+
+  small_dynamic_array(small_dynamic_array const& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    copy_create_(alloc_(), other.size(), other.data());
+  }
+
+  small_dynamic_array(small_dynamic_array&& other) noexcept(is_nothrow_movable_)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, other.get_allocator())
+  {
+    steal_(other);
+  }
+
+  small_dynamic_array(small_dynamic_array&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      steal_(other);
+      return;
+    }
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      auto* dst = inline_data_();
+      if (other.size_ > N) {
+        pointer data = std::allocator_traits<Allocator>::allocate(alloc_(), other.size_);
+        ::new (static_cast<void*>(std::addressof(s_.heap))) pointer(data);
+        dst = boost::to_address(data);
+      }
+
+      if (other.size_ > 0) {
+        std::memcpy(static_cast<void*>(dst), other.data(), other.size_ * sizeof(T));
+      }
+      size_ = other.size_;
+
+      // the bytes now live in `*this` so `other`'s storage is released without running any
+      // destructors
+      //
+      if (!other.is_inline_()) {
+        auto& other_alloc = static_cast<boost::empty_value<Allocator>&>(other).get();
+        std::allocator_traits<Allocator>::deallocate(other_alloc, other.s_.heap, other.size_);
+        other.s_.heap.~pointer();
+      }
+      other.size_ = 0;
+    } else {
+      create_(alloc_(), other.size(),
+              detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                boost::first_scalar(other.data())});
+    }
+  }
+
+  small_dynamic_array(std::initializer_list<T> init, Allocator const& alloc = Allocator())
+    : small_dynamic_array(init.begin(), init.end(), alloc)
+  {
+  }
+
+  template <class Range, std::enable_if_t<detail::is_range_v<Range>, int> = 0>
+  small_dynamic_array(Range const& range, Allocator const& alloc = Allocator())
+    : small_dynamic_array(detail::sleip_begin(range), detail::sleip_end(range), alloc)
+  {
+  }
+
+  ~small_dynamic_array() { destroy_(); }
+
+  // the new elements are built before the old ones are destroyed, but an inline result still has
+  // to be moved into place afterwards so the strong guarantee relies on `T`'s move not throwing
+  //
+  auto
+  operator=(small_dynamic_array const& other) & -> small_dynamic_array&
+  {
+    constexpr auto const pocca =
+      std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if ((!pocca || alloc_() == other.get_allocator()) && size_ == other.size_) {
+        assign_in_place_(other.data());
+        return *this;
+      }
+    }
+
+    auto tmp = small_dynamic_array(other, pocca ? other.get_allocator() : alloc_());
+    destroy_();
+
+    if constexpr (pocca) { alloc_() = other.get_allocator(); }
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+    operator=(small_dynamic_array&& other) &
+    noexcept((std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+              std::allocator_traits<Allocator>::is_always_equal::value) &&
+             is_nothrow_movable_) -> small_dynamic_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocma =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+    if (pocma || alloc_() == other.get_allocator()) {
+      destroy_();
+
+      if constexpr (pocma) {
+        alloc_() = std::move(static_cast<boost::empty_value<Allocator>&>(other).get());
+      }
+      steal_(other);
+
+      return *this;
+    }
+
+    auto tmp = small_dynamic_array(std::move(other), alloc_());
+    destroy_();
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+  operator=(std::initializer_list<T> ilist) & -> small_dynamic_array&
+  {
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if (size_ == ilist.size()) {
+        assign_in_place_(ilist.begin());
+        return *this;
+      }
+    }
+
+    auto tmp = small_dynamic_array(ilist, alloc_());
+    destroy_();
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  // whether the elements live inside the object rather than in an allocation
+  //
+  auto
+  is_inline() const noexcept -> bool
+  {
+    return is_inline_();
+  }
+
+  auto
+  size() const noexcept -> size_type
+  {
+    return size_;
+  }
+
+  auto
+  data() noexcept -> T*
+  {
+    return is_inline_() ? inline_data_() : boost::to_address(s_.heap);
+  }
+
+  auto
+  data() const noexcept -> T const*
+  {
+    return is_inline_() ? inline_data_() : boost::to_address(s_.heap);
+  }
+
+  auto
+  begin() noexcept -> iterator
+  {
+    return iterator{data()};
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  end() noexcept -> iterator
+  {
+    return iterator{data() + size()};
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  rbegin() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(end());
+  }
+
+  auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  rend() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(begin());
+  }
+
+  auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  at(size_type pos) & -> reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::small_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data()[pos];
+  }
+
+  auto
+  at(size_type pos) const& -> const_reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::small_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data()[pos];
+  }
+
+  auto operator[](size_type pos) & -> reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data()[pos];
+  }
+
+  auto operator[](size_type pos) const& -> const_reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data()[pos];
+  }
+
+  auto
+  front() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *begin();
+  }
+
+  auto
+  front() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *cbegin();
+  }
+
+  auto
+  back() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(end() - 1);
+  }
+
+  auto
+  back() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(cend() - 1);
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  auto
+  max_size() const noexcept -> size_type
+  {
+    return -1;
+  }
+
+  auto
+  fill(T const& value) -> void
+  {
+    detail::fill_elements(data(), size(), value, detail::is_streaming_fill<T>(size()));
+  }
+
+  // two heap-backed arrays trade pointers, otherwise the elements of whichever are inline have to
+  // be moved across
+  //
+  auto
+    swap(small_dynamic_array& other) &
+    noexcept((std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+              std::allocator_traits<Allocator>::is_always_equal::value) &&
+             is_nothrow_movable_) -> void
+  {
+    constexpr auto const pocs =
+      std::allocator_traits<allocator_type>::propagate_on_container_swap::value;
+
+    if constexpr (!pocs) { BOOST_ASSERT(get_allocator() == other.get_allocator()); }
+
+    if (this == std::addressof(other)) { return; }
+
+    if (!is_inline_() && !other.is_inline_()) {
+      using std::swap;
+      swap(s_.heap, other.s_.heap);
+      std::swap(size_, other.size_);
+    } else {
+      auto tmp = small_dynamic_array(std::move(other));
+      other.steal_(*this);
+      steal_(tmp);
+    }
+
+    if constexpr (pocs) {
+      using std::swap;
+      swap(alloc_(), other.alloc_());
+    }
+  }
+};
+
+template <class T, std::size_t N, class Allocator>
+auto
+swap(small_dynamic_array<T, N, Allocator>& lhs,
+     small_dynamic_array<T, N, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator==(small_dynamic_array<T, N, Allocator> const& lhs,
+           small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size()) { return false; }
+  return detail::elements_equal(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator!=(small_dynamic_array<T, N, Allocator> const& lhs,
+           small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator<(small_dynamic_array<T, N, Allocator> const& lhs,
+          small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  return detail::elements_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator>(small_dynamic_array<T, N, Allocator> const& lhs,
+          small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  return rhs < lhs;
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator<=(small_dynamic_array<T, N, Allocator> const& lhs,
+           small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  return !(rhs < lhs);
+}
+
+template <class T, std::size_t N, class Allocator>
+auto
+operator>=(small_dynamic_array<T, N, Allocator> const& lhs,
+           small_dynamic_array<T, N, Allocator> const& rhs) -> bool
+{
+  return !(lhs < rhs);
+}
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T, std::size_t N, class Allocator>
+auto
+operator<=>(small_dynamic_array<T, N, Allocator> const& lhs,
+            small_dynamic_array<T, N, Allocator> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  return detail::elements_three_way(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+#endif
+} // namespace sleip
+
+#endif // SLEIP_SMALL_DYNAMIC_ARRAY_HPP_
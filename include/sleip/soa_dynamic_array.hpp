@@ -0,0 +1,935 @@
+#ifndef SLEIP_SOA_DYNAMIC_ARRAY_HPP_
+#define SLEIP_SOA_DYNAMIC_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/alloc_construct.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/noinit_adaptor.hpp>
+#include <boost/core/pointer_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+namespace detail
+{
+// walks one member of a run of records, for constructing a column from an array of structures
+//
+template <class Record, class T>
+struct field_iterator
+{
+  Record const* it;
+  T Record::*   field;
+
+  auto operator*() const -> T const& { return it->*field; }
+
+  auto
+  operator++() & -> field_iterator&
+  {
+    ++it;
+    return *this;
+  }
+};
+
+// the number of records converted at a time between layouts, about 16 KiB of them so the block
+// stays in L1 while each of its columns is copied in turn
+//
+template <class Record>
+inline constexpr std::size_t const soa_block_rows_v =
+  std::max<std::size_t>(1, (std::size_t{16} << 10) / sizeof(Record));
+
+template <class Soa, std::size_t... Is>
+auto
+soa_equal(Soa const& lhs, Soa const& rhs, std::index_sequence<Is...>) -> bool
+{
+  return (std::equal(lhs.template data<Is>(), lhs.template data<Is>() + lhs.size(),
+                     rhs.template data<Is>()) &&
+          ...);
+}
+} // namespace detail
+
+// a fixed-size table of `sizeof...(Ts)` columns whose elements are laid out column after column in
+// a single allocation, each column starting on a cache line
+//
+// loops that only touch a few fields read only those columns instead of dragging every field of a
+// record through the cache, and each column is a plain contiguous array the compiler can vectorize
+// over
+//
+// rows are accessed through proxy references, `std::tuple<Ts&...>`, which is what `operator[]`
+// and the row iterators return
+//
+template <class Allocator, class... Ts>
+struct basic_soa_dynamic_array : boost::empty_value<Allocator>
+{
+public:
+  using value_type      = std::tuple<Ts...>;
+  using allocator_type  = Allocator;
+  using size_type       = typename std::allocator_traits<Allocator>::size_type;
+  using difference_type = typename std::allocator_traits<Allocator>::difference_type;
+  using reference       = std::tuple<Ts&...>;
+  using const_reference = std::tuple<Ts const&...>;
+
+  static constexpr std::size_t const num_columns = sizeof...(Ts);
+
+  template <std::size_t I>
+  using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  static_assert(num_columns > 0, "A structure of arrays needs at least one column");
+
+  static_assert((std::is_object_v<Ts> && ...) && (!std::is_array_v<Ts> && ...),
+                "Only support non-array object types as columns");
+
+  // every column begins on a boundary this aligned
+  //
+  static constexpr std::size_t const column_alignment =
+    std::max({std::size_t{64}, alignof(Ts)..., detail::allocator_alignment_v<Allocator>});
+
+private:
+  struct alignas(column_alignment) unit
+  {
+    unsigned char bytes[column_alignment];
+  };
+
+  using unit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unit>;
+  using unit_traits    = std::allocator_traits<unit_allocator>;
+  using unit_pointer   = typename unit_traits::pointer;
+
+  template <class T>
+  using column_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  using indices = std::index_sequence_for<Ts...>;
+
+  unit_pointer data_ = nullptr;
+  std::size_t  size_ = 0;
+
+  auto
+  alloc_() noexcept -> Allocator&
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  static constexpr auto
+  round_up_(std::size_t bytes) noexcept -> std::size_t
+  {
+    return (bytes + column_alignment - 1) / column_alignment * column_alignment;
+  }
+
+  // the byte size of a block holding `count` rows, this is where the overflow checks happen so
+  // the offsets of a block that was allocated can be recomputed unchecked on every access
+  //
+  static auto
+  block_size_(std::size_t count) -> std::size_t
+  {
+    constexpr std::size_t sizes[] = {sizeof(Ts)...};
+
+    auto size = std::size_t{0};
+    for (auto const column_size : sizes) {
+      if (count > (std::numeric_limits<std::size_t>::max() - column_alignment) / column_size) {
+        boost::throw_exception(std::bad_array_new_length());
+      }
+      auto const bytes = round_up_(count * column_size);
+      if (size > std::numeric_limits<std::size_t>::max() - bytes) {
+        boost::throw_exception(std::bad_array_new_length());
+      }
+      size += bytes;
+    }
+    return size;
+  }
+
+  // the byte offset of column `I` in a block holding `count` rows, column `num_columns` is the
+  // end of the block, `count` must be one that `block_size_` has accepted
+  //
+  template <std::size_t I>
+  static constexpr auto
+  offset_(std::size_t count) noexcept -> std::size_t
+  {
+    constexpr std::size_t sizes[] = {sizeof(Ts)...};
+
+    auto offset = std::size_t{0};
+    for (std::size_t c = 0; c < I; ++c) { offset += round_up_(count * sizes[c]); }
+    return offset;
+  }
+
+  template <std::size_t I>
+  static auto
+  column_ptr_(unit_pointer const& block, std::size_t count) noexcept -> column_type<I>*
+  {
+    auto* const base = reinterpret_cast<unsigned char*>(boost::to_address(block));
+    return reinterpret_cast<column_type<I>*>(base + offset_<I>(count));
+  }
+
+  template <std::size_t... Is>
+  auto
+  destroy_columns_(unit_pointer const& block,
+                   std::size_t         count,
+                   std::size_t         built,
+                   std::index_sequence<Is...>) noexcept -> void
+  {
+    auto destroy_column = [&](auto i) {
+      constexpr auto I = decltype(i)::value;
+      if (I >= built) { return; }
+
+      auto a = column_allocator<column_type<I>>(alloc_());
+      boost::alloc_destroy_n(a, column_ptr_<I>(block, count), count);
+    };
+    (destroy_column(std::integral_constant<std::size_t, Is>{}), ...);
+  }
+
+  // allocates a block for `count` rows and calls `construct(i, p)` to build column `i` at `p`, a
+  // throwing column unwinds the ones before it
+  //
+  template <class Construct, std::size_t... Is>
+  auto
+  create_(std::size_t count, Construct const& construct, std::index_sequence<Is...>) -> void
+  {
+    BOOST_ASSERT(data_ == nullptr);
+    if (count == 0) { return; }
+
+    auto       a     = unit_allocator(alloc_());
+    auto const n     = block_size_(count) / column_alignment;
+    auto       block = unit_traits::allocate(a, n);
+
+    auto built = std::size_t{0};
+    try {
+      ((construct(std::integral_constant<std::size_t, Is>{}, column_ptr_<Is>(block, count)),
+        ++built),
+       ...);
+    }
+    catch (...) {
+      destroy_columns_(block, count, built, indices{});
+      unit_traits::deallocate(a, block, n);
+      throw;
+    }
+
+    data_ = block;
+    size_ = count;
+  }
+
+  auto
+  deallocate_() noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+
+    auto a = unit_allocator(alloc_());
+    unit_traits::deallocate(a, data_, offset_<num_columns>(size_) / column_alignment);
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  auto
+  destroy_() noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+
+    destroy_columns_(data_, size_, num_columns, indices{});
+    deallocate_();
+  }
+
+  auto
+  steal_(basic_soa_dynamic_array& other) noexcept -> void
+  {
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  auto
+  copy_create_(basic_soa_dynamic_array const& other) -> void
+  {
+    create_(
+      other.size_,
+      [&](auto i, auto* p) {
+        constexpr auto I = decltype(i)::value;
+        using T          = column_type<I>;
+
+        auto        a   = column_allocator<T>(alloc_());
+        auto const* src = other.template data<I>();
+        if constexpr (detail::is_bulk_copyable_v<T, column_allocator<T>>) {
+          std::memcpy(p, src, other.size_ * sizeof(T));
+        } else {
+          boost::alloc_construct_n(a, p, other.size_, src);
+        }
+      },
+      indices{});
+  }
+
+  template <std::size_t... Is>
+  static constexpr auto
+  is_bulk_relocatable_(std::index_sequence<Is...>) noexcept -> bool
+  {
+    return (detail::is_bulk_relocatable_v<column_type<Is>, column_allocator<column_type<Is>>> &&
+            ...);
+  }
+
+  template <std::size_t... Is>
+  static constexpr auto
+  is_bulk_copyable_(std::index_sequence<Is...>) noexcept -> bool
+  {
+    return (detail::is_bulk_copyable_v<column_type<Is>, column_allocator<column_type<Is>>> && ...);
+  }
+
+  template <std::size_t... Is>
+  auto
+  assign_in_place_(basic_soa_dynamic_array const& other, std::index_sequence<Is...>) noexcept
+    -> void
+  {
+    (std::copy_n(other.template data<Is>(), size_, data<Is>()), ...);
+  }
+
+  template <class Record, class... Fields, std::size_t... Is>
+  auto
+  gather_(Record const* src, std::size_t count, std::tuple<Fields...> const& fields,
+          std::index_sequence<Is...>) -> void
+  {
+    if constexpr (is_bulk_copyable_(indices{})) {
+      // the plain copies are done a block of records at a time, column by column, so every
+      // column's loop is a contiguous store the compiler can vectorize while the block of records
+      // it reads from stays in L1 for the next column
+      //
+      create_(
+        count,
+        [&](auto i, auto* p) {
+          auto a = boost::noinit_adapt(column_allocator<column_type<decltype(i)::value>>(alloc_()));
+          boost::alloc_construct_n(a, p, count);
+        },
+        indices{});
+
+      constexpr auto const block = detail::soa_block_rows_v<Record>;
+
+      for (std::size_t b = 0; b < count; b += block) {
+        auto const e = std::min(count, b + block);
+        auto gather_column = [&](auto i) {
+          constexpr auto I     = decltype(i)::value;
+          auto* const    dst   = data<I>();
+          auto const     field = std::get<I>(fields);
+          for (std::size_t r = b; r < e; ++r) { dst[r] = src[r].*field; }
+        };
+        (gather_column(std::integral_constant<std::size_t, Is>{}), ...);
+      }
+    } else {
+      create_(
+        count,
+        [&](auto i, auto* p) {
+          constexpr auto I = decltype(i)::value;
+
+          auto a = column_allocator<column_type<I>>(alloc_());
+          boost::alloc_construct_n(a, p, count,
+                                   detail::field_iterator<Record, column_type<I>>{
+                                     src, std::get<I>(fields)});
+        },
+        indices{});
+    }
+  }
+
+public:
+  basic_soa_dynamic_array() noexcept(noexcept(Allocator()))
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+  }
+
+  explicit basic_soa_dynamic_array(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+  }
+
+  explicit basic_soa_dynamic_array(size_type count, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_(
+      count,
+      [&](auto i, auto* p) {
+        auto a = column_allocator<column_type<decltype(i)::value>>(alloc_());
+        boost::alloc_construct_n(a, p, count);
+      },
+      indices{});
+  }
+
+  basic_soa_dynamic_array(size_type count, noinit_t, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_(
+      count,
+      [&](auto i, auto* p) {
+        auto a = boost::noinit_adapt(column_allocator<column_type<decltype(i)::value>>(alloc_()));
+        boost::alloc_construct_n(a, p, count);
+      },
+      indices{});
+  }
+
+  basic_soa_dynamic_array(size_type          count,
+                          value_type const&  value,
+                          Allocator const&   alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    create_(
+      count,
+      [&](auto i, auto* p) {
+        constexpr auto I = decltype(i)::value;
+
+        auto a = column_allocator<column_type<I>>(alloc_());
+        boost::alloc_construct_n(a, p, count, std::addressof(std::get<I>(value)), 1);
+      },
+      indices{});
+  }
+
+  // gathers the `fields` of every record in `aos` into a column each, the AoS to SoA transform
+  //
+  template <class Record, class RecordAllocator>
+  basic_soa_dynamic_array(dynamic_array<Record, RecordAllocator> const& aos,
+                          Ts Record::*... fields)
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+    gather_(aos.data(), aos.size(), std::make_tuple(fields...), indices{});
+  }
+
+  template <class Record, class RecordAllocator>
+  basic_soa_dynamic_array(std::allocator_arg_t,
+                          Allocator const&                              alloc,
+                          dynamic_array<Record, RecordAllocator> const& aos,
+                          Ts Record::*... fields)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    gather_(aos.data(), aos.size(), std::make_tuple(fields...), indices{});
+  }
+
+  basic_soa_dynamic_array(basic_soa_dynamic_array const& other)
+    : boost::empty_value<Allocator>(
+        boost::empty_init_t{},
+        std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+          other.get_allocator()))
+  {
+    copy_create_(other);
+  }
+
+  basic_soa_dynamic_array(basic_soa_dynamic_array const& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    copy_create_(other);
+  }
+
+  basic_soa_dynamic_array(basic_soa_dynamic_array&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, std::move(other.get_allocator()))
+  {
+    steal_(other);
+  }
+
+  basic_soa_dynamic_array(basic_soa_dynamic_array&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      steal_(other);
+      return;
+    }
+
+    if constexpr (is_bulk_relocatable_(indices{})) {
+      // the bytes now live in `*this` so `other`'s storage is released without running any
+      // destructors
+      //
+      auto const n = offset_<num_columns>(other.size_);
+      create_(
+        other.size_, [](auto, auto*) {}, indices{});
+      if (n > 0) { std::memcpy(boost::to_address(data_), boost::to_address(other.data_), n); }
+      other.deallocate_();
+    } else {
+      create_(
+        other.size_,
+        [&](auto i, auto* p) {
+          constexpr auto I = decltype(i)::value;
+
+          auto a = column_allocator<column_type<I>>(alloc_());
+          boost::alloc_construct_n(
+            a, p, other.size_,
+            detail::move_if_noexcept_adaptor<column_type<I>*>{other.template data<I>()});
+        },
+        indices{});
+    }
+  }
+
+  ~basic_soa_dynamic_array() { destroy_(); }
+
+  auto
+  operator=(basic_soa_dynamic_array const& other) & -> basic_soa_dynamic_array&
+  {
+    constexpr auto const pocca =
+      std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+    if constexpr ((detail::is_nothrow_copy_assignable_v<Ts> && ...)) {
+      if ((!pocca || alloc_() == other.get_allocator()) && size_ == other.size_) {
+        if (this != std::addressof(other)) { assign_in_place_(other, indices{}); }
+        return *this;
+      }
+    }
+
+    auto tmp = basic_soa_dynamic_array(other, pocca ? other.get_allocator() : alloc_());
+    destroy_();
+
+    if constexpr (pocca) { alloc_() = other.get_allocator(); }
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+    operator=(basic_soa_dynamic_array&& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> basic_soa_dynamic_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocma =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+    if (pocma || alloc_() == other.get_allocator()) {
+      destroy_();
+
+      if constexpr (pocma) {
+        alloc_() = std::move(static_cast<boost::empty_value<Allocator>&>(other).get());
+      }
+      steal_(other);
+
+      return *this;
+    }
+
+    auto tmp = basic_soa_dynamic_array(std::move(other), alloc_());
+    destroy_();
+    steal_(tmp);
+
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  auto
+  size() const noexcept -> size_type
+  {
+    return size_;
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return size_ == 0;
+  }
+
+  auto
+  max_size() const noexcept -> size_type
+  {
+    return -1;
+  }
+
+  // the first element of column `I`, aligned to `column_alignment`
+  //
+  template <std::size_t I>
+  auto
+  data() noexcept -> column_type<I>*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<column_alignment>(column_ptr_<I>(data_, size_));
+  }
+
+  template <std::size_t I>
+  auto
+  data() const noexcept -> column_type<I> const*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<column_alignment>(column_ptr_<I>(data_, size_));
+  }
+
+  template <std::size_t I>
+  auto
+  column() noexcept -> column_span<column_type<I>>
+  {
+    return {data<I>(), size_};
+  }
+
+  template <std::size_t I>
+  auto
+  column() const noexcept -> column_span<column_type<I> const>
+  {
+    return {data<I>(), size_};
+  }
+
+  auto operator[](size_type pos) & noexcept -> reference
+  {
+    BOOST_ASSERT(pos < size_);
+    return row_(pos, indices{});
+  }
+
+  auto operator[](size_type pos) const& noexcept -> const_reference
+  {
+    BOOST_ASSERT(pos < size_);
+    return row_(pos, indices{});
+  }
+
+  auto
+  at(size_type pos) & -> reference
+  {
+    if (!(pos < size_)) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::soa_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+    return row_(pos, indices{});
+  }
+
+  auto
+  at(size_type pos) const& -> const_reference
+  {
+    if (!(pos < size_)) {
+      boost::throw_exception(std::out_of_range(
+        "sleip::soa_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+    return row_(pos, indices{});
+  }
+
+  auto
+  front() & noexcept -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[0];
+  }
+
+  auto
+  front() const& noexcept -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[0];
+  }
+
+  auto
+  back() & noexcept -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[size_ - 1];
+  }
+
+  auto
+  back() const& noexcept -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return (*this)[size_ - 1];
+  }
+
+  // writes the columns back into the `fields` of the records in `aos`, the SoA to AoS transform,
+  // leaving every other member of the records as it was
+  //
+  template <class Record, class RecordAllocator>
+  auto
+  scatter(dynamic_array<Record, RecordAllocator>& aos, Ts Record::*... fields) const -> void
+  {
+    if (aos.size() != size_) {
+      boost::throw_exception(std::invalid_argument(
+        "sleip::soa_dynamic_array::scatter -> the destination must have size() rows"));
+    }
+    scatter_(aos.data(), std::make_tuple(fields...), indices{});
+  }
+
+  auto
+  fill(value_type const& value) -> void
+  {
+    fill_(value, indices{});
+  }
+
+  auto
+    swap(basic_soa_dynamic_array& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> void
+  {
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_(), other.alloc_());
+    } else {
+      BOOST_ASSERT(get_allocator() == other.get_allocator());
+    }
+
+    using std::swap;
+    swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+
+private:
+  template <std::size_t... Is>
+  auto
+  row_(size_type pos, std::index_sequence<Is...>) noexcept -> reference
+  {
+    return reference(data<Is>()[pos]...);
+  }
+
+  template <std::size_t... Is>
+  auto
+  row_(size_type pos, std::index_sequence<Is...>) const noexcept -> const_reference
+  {
+    return const_reference(data<Is>()[pos]...);
+  }
+
+  template <class Record, class... Fields, std::size_t... Is>
+  auto
+  scatter_(Record* dst, std::tuple<Fields...> const& fields, std::index_sequence<Is...>) const
+    -> void
+  {
+    constexpr auto const block = detail::soa_block_rows_v<Record>;
+
+    for (std::size_t b = 0; b < size_; b += block) {
+      auto const e = std::min(size_, b + block);
+      auto scatter_column = [&](auto i) {
+        constexpr auto I     = decltype(i)::value;
+        auto const*    src   = data<I>();
+        auto const     field = std::get<I>(fields);
+        for (std::size_t r = b; r < e; ++r) { dst[r].*field = src[r]; }
+      };
+      (scatter_column(std::integral_constant<std::size_t, Is>{}), ...);
+    }
+  }
+
+  template <std::size_t... Is>
+  auto
+  fill_(value_type const& value, std::index_sequence<Is...>) -> void
+  {
+    (std::fill_n(data<Is>(), size_, std::get<Is>(value)), ...);
+  }
+
+public:
+  template <bool Const>
+  struct row_iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = std::tuple<Ts...>;
+    using difference_type   = std::ptrdiff_t;
+    using reference =
+      std::conditional_t<Const, std::tuple<Ts const&...>, std::tuple<Ts&...>>;
+    using pointer = void;
+
+  private:
+    using container =
+      std::conditional_t<Const, basic_soa_dynamic_array const, basic_soa_dynamic_array>;
+
+    container*  soa_ = nullptr;
+    std::size_t pos_ = 0;
+
+  public:
+    row_iterator() = default;
+
+    row_iterator(container* soa, std::size_t pos) noexcept
+      : soa_{soa}
+      , pos_{pos}
+    {
+    }
+
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    row_iterator(row_iterator<false> const& other) noexcept
+      : soa_{other.soa_}
+      , pos_{other.pos_}
+    {
+    }
+
+    auto operator*() const noexcept -> reference { return (*soa_)[pos_]; }
+
+    auto operator[](difference_type n) const noexcept -> reference { return (*soa_)[pos_ + n]; }
+
+    auto
+    operator++() noexcept -> row_iterator&
+    {
+      ++pos_;
+      return *this;
+    }
+
+    auto
+    operator++(int) noexcept -> row_iterator
+    {
+      auto tmp = *this;
+      ++pos_;
+      return tmp;
+    }
+
+    auto
+    operator--() noexcept -> row_iterator&
+    {
+      --pos_;
+      return *this;
+    }
+
+    auto
+    operator--(int) noexcept -> row_iterator
+    {
+      auto tmp = *this;
+      --pos_;
+      return tmp;
+    }
+
+    auto
+    operator+=(difference_type n) noexcept -> row_iterator&
+    {
+      pos_ += n;
+      return *this;
+    }
+
+    auto
+    operator-=(difference_type n) noexcept -> row_iterator&
+    {
+      pos_ -= n;
+      return *this;
+    }
+
+    friend auto
+    operator+(row_iterator it, difference_type n) noexcept -> row_iterator
+    {
+      return it += n;
+    }
+
+    friend auto
+    operator+(difference_type n, row_iterator it) noexcept -> row_iterator
+    {
+      return it += n;
+    }
+
+    friend auto
+    operator-(row_iterator it, difference_type n) noexcept -> row_iterator
+    {
+      return it -= n;
+    }
+
+    friend auto
+    operator-(row_iterator const& lhs, row_iterator const& rhs) noexcept -> difference_type
+    {
+      return static_cast<difference_type>(lhs.pos_) - static_cast<difference_type>(rhs.pos_);
+    }
+
+    friend auto
+    operator==(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ == rhs.pos_;
+    }
+
+    friend auto
+    operator!=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ != rhs.pos_;
+    }
+
+    friend auto
+    operator<(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ < rhs.pos_;
+    }
+
+    friend auto
+    operator>(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ > rhs.pos_;
+    }
+
+    friend auto
+    operator<=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ <= rhs.pos_;
+    }
+
+    friend auto
+    operator>=(row_iterator const& lhs, row_iterator const& rhs) noexcept -> bool
+    {
+      return lhs.pos_ >= rhs.pos_;
+    }
+
+    friend struct row_iterator<!Const>;
+  };
+
+  using iterator       = row_iterator<false>;
+  using const_iterator = row_iterator<true>;
+
+  auto
+  begin() noexcept -> iterator
+  {
+    return {this, 0};
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return {this, 0};
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return {this, 0};
+  }
+
+  auto
+  end() noexcept -> iterator
+  {
+    return {this, size_};
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return {this, size_};
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return {this, size_};
+  }
+};
+
+template <class... Ts>
+using soa_dynamic_array = basic_soa_dynamic_array<std::allocator<std::byte>, Ts...>;
+
+template <class Allocator, class... Ts>
+auto
+swap(basic_soa_dynamic_array<Allocator, Ts...>& lhs,
+     basic_soa_dynamic_array<Allocator, Ts...>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class Allocator, class... Ts>
+auto
+operator==(basic_soa_dynamic_array<Allocator, Ts...> const& lhs,
+           basic_soa_dynamic_array<Allocator, Ts...> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size()) { return false; }
+
+  return detail::soa_equal(lhs, rhs, std::index_sequence_for<Ts...>{});
+}
+
+template <class Allocator, class... Ts>
+auto
+operator!=(basic_soa_dynamic_array<Allocator, Ts...> const& lhs,
+           basic_soa_dynamic_array<Allocator, Ts...> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+// gathers the `fields` of every record in `aos` into a new `soa_dynamic_array`
+//
+template <class Record, class RecordAllocator, class... Ts>
+auto
+to_soa(dynamic_array<Record, RecordAllocator> const& aos, Ts Record::*... fields)
+  -> soa_dynamic_array<Ts...>
+{
+  return soa_dynamic_array<Ts...>(aos, fields...);
+}
+} // namespace sleip
+
+#endif // SLEIP_SOA_DYNAMIC_ARRAY_HPP_
@@ -0,0 +1,644 @@
+#ifndef SLEIP_THIN_DYNAMIC_ARRAY_HPP_
+#define SLEIP_THIN_DYNAMIC_ARRAY_HPP_
+
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/core/alloc_construct.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/noinit_adaptor.hpp>
+#include <boost/core/pointer_traits.hpp>
+#include <boost/core/first_scalar.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sleip
+{
+// a fixed-size array whose only member is a pointer, the element count lives in a header at the
+// front of the allocation
+//
+// this halves the size of the handle with a stateless allocator which matters when there are
+// millions of them, e.g. in a `dynamic_array<thin_dynamic_array<int>>`, in exchange `size()` has
+// to read from the allocation instead of the object
+//
+// an empty array holds a null pointer and owns no allocation
+//
+template <class T, class Allocator = std::allocator<T>>
+struct thin_dynamic_array : boost::empty_value<Allocator>
+{
+public:
+  using value_type             = T;
+  using allocator_type         = Allocator;
+  using size_type              = typename std::allocator_traits<Allocator>::size_type;
+  using difference_type        = typename std::allocator_traits<Allocator>::difference_type;
+  using reference              = value_type&;
+  using const_reference        = value_type const&;
+  using pointer                = typename std::allocator_traits<Allocator>::pointer;
+  using const_pointer          = typename std::allocator_traits<Allocator>::const_pointer;
+  using iterator               = value_type*;
+  using const_iterator         = value_type const*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static_assert(
+    std::is_object_v<T> && (!std::is_array_v<T> || boost::is_bounded_array<T>::value),
+    "Only support object types, including bound array types. Unbound arrays are not supported");
+
+  static_assert(std::is_same_v<typename allocator_type::value_type, value_type>,
+                "Allocator's value type must match container's");
+
+private:
+  // the allocation is counted in units that are as aligned as the elements, the header and any
+  // over-alignment the allocator advertises, the header takes up the first one so the elements
+  // that follow keep every one of those guarantees
+  //
+  static constexpr std::size_t const unit_align_ =
+    std::max({alignof(T), alignof(std::size_t), detail::allocator_alignment_v<Allocator>});
+
+  struct alignas(unit_align_) unit
+  {
+    unsigned char bytes[unit_align_];
+  };
+
+  static_assert(sizeof(unit) >= sizeof(std::size_t));
+
+  using unit_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<unit>;
+  using unit_traits    = std::allocator_traits<unit_allocator>;
+  using unit_pointer   = typename unit_traits::pointer;
+
+  unit_pointer data_ = nullptr;
+
+  auto
+  alloc_() noexcept -> Allocator&
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  static auto
+  num_units_(std::size_t count) -> std::size_t
+  {
+    if (count > (std::numeric_limits<std::size_t>::max() - 2 * sizeof(unit)) / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+    return 1 + (count * sizeof(T) + sizeof(unit) - 1) / sizeof(unit);
+  }
+
+  static auto
+  elements_(unit_pointer const& block) noexcept -> T*
+  {
+    return reinterpret_cast<T*>(boost::to_address(block) + 1);
+  }
+
+  auto
+  deallocate_(unit_pointer block, std::size_t count) noexcept -> void
+  {
+    auto a = unit_allocator(alloc_());
+    unit_traits::deallocate(a, block, num_units_(count));
+  }
+
+  // constructs the elements with `alloc`, which may be a `noinit_adaptor`, but always gets the
+  // storage from our own allocator
+  //
+  template <typename Allocator_, typename... Args>
+  auto
+  create_(Allocator_& alloc, std::size_t count, Args&&... args) -> unit_pointer
+  {
+    if (count == 0) { return nullptr; }
+
+    auto       a = unit_allocator(alloc_());
+    auto const n = num_units_(count);
+
+    unit_pointer block = nullptr;
+    if constexpr (sizeof...(Args) == 0 && std::is_same_v<Allocator_, Allocator> &&
+                  detail::is_zero_allocatable_v<T, Allocator> &&
+                  detail::has_allocate_zeroed<unit_allocator>::value) {
+      block = a.allocate_zeroed(n);
+    } else {
+      block = unit_traits::allocate(a, n);
+      try {
+        boost::alloc_construct_n(alloc, boost::first_scalar(elements_(block)),
+                                 detail::num_elems<T>(count), std::forward<Args>(args)...);
+      }
+      catch (...) {
+        unit_traits::deallocate(a, block, n);
+        throw;
+      }
+    }
+
+    ::new (static_cast<void*>(boost::to_address(block))) std::size_t(count);
+    return block;
+  }
+
+  template <typename Allocator_>
+  auto
+  copy_create_(Allocator_& alloc, std::size_t count, T const* src) -> unit_pointer
+  {
+    if constexpr (detail::is_bulk_copyable_v<T, Allocator_>) {
+      if (count == 0) { return nullptr; }
+
+      auto a     = unit_allocator(alloc_());
+      auto block = unit_traits::allocate(a, num_units_(count));
+
+      ::new (static_cast<void*>(boost::to_address(block))) std::size_t(count);
+      std::memcpy(elements_(block), src, count * sizeof(T));
+      return block;
+    } else {
+      return create_(alloc, count, boost::first_scalar(src));
+    }
+  }
+
+  // copies the bytes of `other`'s elements into a new block of ours, the elements now live in
+  // `*this` so `other`'s storage is released without running any destructors
+  //
+  auto
+  relocate_create_(thin_dynamic_array& other) -> unit_pointer
+  {
+    static_assert(detail::is_bulk_relocatable_v<T, Allocator>);
+
+    if (other.data_ == nullptr) { return nullptr; }
+
+    auto const count = other.size();
+
+    auto a     = unit_allocator(alloc_());
+    auto block = unit_traits::allocate(a, num_units_(count));
+
+    ::new (static_cast<void*>(boost::to_address(block))) std::size_t(count);
+    std::memcpy(static_cast<void*>(elements_(block)), other.data(), count * sizeof(T));
+
+    other.deallocate_(std::exchange(other.data_, nullptr), count);
+    return block;
+  }
+
+  auto
+  destroy_() noexcept -> void
+  {
+    if (data_ == nullptr) { return; }
+
+    auto const count = size();
+    boost::alloc_destroy_n(alloc_(), boost::first_scalar(elements_(data_)),
+                           detail::num_elems<T>(count));
+
+    deallocate_(data_, count);
+    data_ = nullptr;
+  }
+
+  auto
+  assign_in_place_(T const* src) noexcept -> void
+  {
+    static_assert(detail::is_nothrow_copy_assignable_v<T>);
+
+    if (empty() || data() == src) { return; }
+
+    auto const* const first = boost::first_scalar(src);
+    std::copy(first, first + detail::num_elems<T>(size()), boost::first_scalar(data()));
+  }
+
+public:
+  thin_dynamic_array() noexcept(noexcept(Allocator()))
+    : boost::empty_value<Allocator>(boost::empty_init_t{})
+  {
+  }
+
+  explicit thin_dynamic_array(Allocator const& alloc) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+  }
+
+  thin_dynamic_array(size_type count, T const& value, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    data_ = create_(alloc_(), count, boost::first_scalar(std::addressof(value)),
+                    detail::num_elems<T>(1));
+  }
+
+  explicit thin_dynamic_array(size_type count, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    data_ = create_(alloc_(), count);
+  }
+
+  explicit thin_dynamic_array(size_type count, noinit_t, Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto a = boost::noinit_adapt(alloc_());
+    data_  = create_(a, count);
+  }
+
+  template <class ForwardIterator,
+            std::enable_if_t<detail::is_forward_iterator_v<ForwardIterator>, int> = 0>
+  thin_dynamic_array(ForwardIterator  first,
+                     ForwardIterator  last,
+                     Allocator const& alloc = Allocator())
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    auto const count = static_cast<size_type>(std::distance(first, last));
+
+    if constexpr (detail::is_contiguous_iterator_v<ForwardIterator, T>) {
+      data_ = copy_create_(alloc_(), count, detail::to_address(first));
+    } else {
+      data_ = create_(alloc_(), count, detail::array_walker<ForwardIterator>{first});
+    }
+  }
+
+  thin_dynamic_array(thin_dynamic_array const& other)
+    : boost::empty_value<Allocator>(
+        boost::empty_init_t{},
+        std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+          other.get_allocator()))
+  {
+    data_ = copy_create_(alloc_(), other.size(), other.data());
+  }
+
+  thin_dynamic_array(thin_dynamic_array const& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    data_ = copy_create_(alloc_(), other.size(), other.data());
+  }
+
+  thin_dynamic_array(thin_dynamic_array&& other) noexcept
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, std::move(other.get_allocator()))
+  {
+    data_ = std::exchange(other.data_, nullptr);
+  }
+
+  thin_dynamic_array(thin_dynamic_array&& other, Allocator const& alloc)
+    : boost::empty_value<Allocator>(boost::empty_init_t{}, alloc)
+  {
+    if (alloc_() == other.get_allocator()) {
+      data_ = std::exchange(other.data_, nullptr);
+      return;
+    }
+
+    if constexpr (detail::is_bulk_relocatable_v<T, Allocator>) {
+      data_ = relocate_create_(other);
+    } else {
+      data_ = create_(alloc_(), other.size(),
+                      detail::move_if_noexcept_adaptor<std::remove_all_extents_t<T>*>{
+                        boost::first_scalar(other.data())});
+    }
+  }
+
+  thin_dynamic_array(std::initializer_list<T> init, Allocator const& alloc = Allocator())
+    : thin_dynamic_array(init.begin(), init.end(), alloc)
+  {
+  }
+
+  template <class Range, std::enable_if_t<detail::is_range_v<Range>, int> = 0>
+  thin_dynamic_array(Range const& range, Allocator const& alloc = Allocator())
+    : thin_dynamic_array(detail::sleip_begin(range), detail::sleip_end(range), alloc)
+  {
+  }
+
+  ~thin_dynamic_array() { destroy_(); }
+
+  auto
+  operator=(thin_dynamic_array const& other) & -> thin_dynamic_array&
+  {
+    constexpr auto const pocca =
+      std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if ((!pocca || alloc_() == other.get_allocator()) && size() == other.size()) {
+        assign_in_place_(other.data());
+        return *this;
+      }
+    }
+
+    auto tmp = thin_dynamic_array(other, pocca ? other.get_allocator() : alloc_());
+    destroy_();
+
+    if constexpr (pocca) { alloc_() = other.get_allocator(); }
+    data_ = std::exchange(tmp.data_, nullptr);
+
+    return *this;
+  }
+
+  auto
+    operator=(thin_dynamic_array&& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> thin_dynamic_array&
+  {
+    if (this == std::addressof(other)) { return *this; }
+
+    constexpr auto const pocma =
+      std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value;
+
+    if (pocma || alloc_() == other.get_allocator()) {
+      destroy_();
+
+      if constexpr (pocma) {
+        alloc_() = std::move(static_cast<boost::empty_value<Allocator>&>(other).get());
+      }
+      data_ = std::exchange(other.data_, nullptr);
+
+      return *this;
+    }
+
+    // the new buffer is fully built before the old one is released so that a throwing element move
+    // leaves `*this` untouched
+    //
+    auto tmp = thin_dynamic_array(std::move(other), alloc_());
+    destroy_();
+    data_ = std::exchange(tmp.data_, nullptr);
+
+    return *this;
+  }
+
+  auto
+  operator=(std::initializer_list<T> ilist) & -> thin_dynamic_array&
+  {
+    if constexpr (detail::is_nothrow_copy_assignable_v<T>) {
+      if (size() == ilist.size()) {
+        assign_in_place_(ilist.begin());
+        return *this;
+      }
+    }
+
+    auto tmp = thin_dynamic_array(ilist, alloc_());
+    destroy_();
+    data_ = std::exchange(tmp.data_, nullptr);
+
+    return *this;
+  }
+
+  auto
+  get_allocator() const -> allocator_type
+  {
+    return boost::empty_value<Allocator>::get();
+  }
+
+  auto
+  size() const noexcept -> size_type
+  {
+    if (data_ == nullptr) { return 0; }
+    return *reinterpret_cast<std::size_t const*>(boost::to_address(data_));
+  }
+
+  // null for an empty array, like `dynamic_array`
+  //
+  auto
+  data() noexcept -> T*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<unit_align_>(elements_(data_));
+  }
+
+  auto
+  data() const noexcept -> T const*
+  {
+    if (data_ == nullptr) { return nullptr; }
+    return detail::assume_aligned<unit_align_>(elements_(data_));
+  }
+
+  auto
+  begin() noexcept -> iterator
+  {
+    return iterator{data()};
+  }
+
+  auto
+  begin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return const_iterator{data()};
+  }
+
+  auto
+  end() noexcept -> iterator
+  {
+    return iterator{data() + size()};
+  }
+
+  auto
+  end() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  cend() const noexcept -> const_iterator
+  {
+    return const_iterator{data() + size()};
+  }
+
+  auto
+  rbegin() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(end());
+  }
+
+  auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cend());
+  }
+
+  auto
+  rend() noexcept -> reverse_iterator
+  {
+    return std::make_reverse_iterator(begin());
+  }
+
+  auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return std::make_reverse_iterator(cbegin());
+  }
+
+  auto
+  at(size_type pos) & -> reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(
+        std::out_of_range("sleip::thin_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data()[pos];
+  }
+
+  auto
+  at(size_type pos) const& -> const_reference
+  {
+    if (!(pos < size())) {
+      boost::throw_exception(
+        std::out_of_range("sleip::thin_dynamic_array::at -> size_type pos is larger than size()"));
+    }
+
+    return data()[pos];
+  }
+
+  auto operator[](size_type pos) & -> reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data()[pos];
+  }
+
+  auto operator[](size_type pos) const& -> const_reference
+  {
+    BOOST_ASSERT(pos < size());
+    return data()[pos];
+  }
+
+  auto
+  front() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *begin();
+  }
+
+  auto
+  front() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *cbegin();
+  }
+
+  auto
+  back() & -> reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(end() - 1);
+  }
+
+  auto
+  back() const& -> const_reference
+  {
+    BOOST_ASSERT(!empty());
+    return *(cend() - 1);
+  }
+
+  auto
+  empty() const noexcept -> bool
+  {
+    return data_ == nullptr;
+  }
+
+  auto
+  max_size() const noexcept -> size_type
+  {
+    return -1;
+  }
+
+  auto
+  fill(T const& value) -> void
+  {
+    detail::fill_elements(data(), size(), value, detail::is_streaming_fill<T>(size()));
+  }
+
+  auto
+    swap(thin_dynamic_array& other) &
+    noexcept(std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+             std::allocator_traits<Allocator>::is_always_equal::value) -> void
+  {
+    if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_(), other.alloc_());
+    } else {
+      BOOST_ASSERT(get_allocator() == other.get_allocator());
+    }
+
+    using std::swap;
+    swap(data_, other.data_);
+  }
+};
+
+template <class T, class Allocator>
+auto
+swap(thin_dynamic_array<T, Allocator>& lhs,
+     thin_dynamic_array<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) -> void
+{
+  lhs.swap(rhs);
+}
+
+template <class T, class Allocator>
+auto
+operator==(thin_dynamic_array<T, Allocator> const& lhs,
+           thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  if (lhs.size() != rhs.size()) { return false; }
+  return detail::elements_equal(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, class Allocator>
+auto
+operator!=(thin_dynamic_array<T, Allocator> const& lhs,
+           thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(lhs == rhs);
+}
+
+template <class T, class Allocator>
+auto
+operator<(thin_dynamic_array<T, Allocator> const& lhs,
+          thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return detail::elements_less(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+template <class T, class Allocator>
+auto
+operator>(thin_dynamic_array<T, Allocator> const& lhs,
+          thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return rhs < lhs;
+}
+
+template <class T, class Allocator>
+auto
+operator<=(thin_dynamic_array<T, Allocator> const& lhs,
+           thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(rhs < lhs);
+}
+
+template <class T, class Allocator>
+auto
+operator>=(thin_dynamic_array<T, Allocator> const& lhs,
+           thin_dynamic_array<T, Allocator> const& rhs) -> bool
+{
+  return !(lhs < rhs);
+}
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+template <class T, class Allocator>
+auto
+operator<=>(thin_dynamic_array<T, Allocator> const& lhs,
+            thin_dynamic_array<T, Allocator> const& rhs)
+  -> std::compare_three_way_result_t<std::remove_all_extents_t<T>>
+{
+  return detail::elements_three_way(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+#endif
+} // namespace sleip
+
+#endif // SLEIP_THIN_DYNAMIC_ARRAY_HPP_
@@ -0,0 +1,152 @@
+#ifndef SLEIP_ZERO_PAGE_ALLOCATOR_HPP_
+#define SLEIP_ZERO_PAGE_ALLOCATOR_HPP_
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SLEIP_HAS_MMAP
+#endif
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+#define SLEIP_HAS_MREMAP
+#endif
+
+namespace sleip
+{
+// an Allocator whose storage is always zero-filled by the OS
+//
+// small requests are served by `calloc`, requests of at least `mmap_threshold` bytes are served by
+// anonymous `mmap` so that pages are only committed on first write
+//
+// `dynamic_array` detects `allocate_zeroed` and skips its value-initialization loop for scalar
+// element types, and detects `reallocate` to resize `mmap` blocks without copying them
+//
+template <class T>
+struct zero_page_allocator
+{
+  using value_type = T;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "zero_page_allocator does not support over-aligned types");
+
+  using is_always_equal                        = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  static constexpr std::size_t const mmap_threshold = std::size_t{1} << 20;
+
+  zero_page_allocator() = default;
+
+  template <class U>
+  zero_page_allocator(zero_page_allocator<U> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    return allocate_zeroed(n);
+  }
+
+  auto
+  allocate_zeroed(std::size_t n) -> T*
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      boost::throw_exception(std::bad_array_new_length());
+    }
+
+    auto const num_bytes = n * sizeof(T);
+
+#ifdef SLEIP_HAS_MMAP
+    if (num_bytes >= mmap_threshold) {
+      void* p = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                       0);
+      if (p == MAP_FAILED) { boost::throw_exception(std::bad_alloc()); }
+      return static_cast<T*>(p);
+    }
+#endif
+
+    // `calloc` of zero bytes may return null which would be mistaken for an empty array so always
+    // request at least one
+    //
+    void* p = std::calloc(n == 0 ? 1 : n, sizeof(T));
+    if (p == nullptr) { boost::throw_exception(std::bad_alloc()); }
+    return static_cast<T*>(p);
+  }
+
+  // moves the pages of an `mmap` block with `mremap`, the pages it adds are zero like every other
+  // page we hand out
+  //
+  // `calloc` blocks on either side of `mmap_threshold` are left to the caller
+  //
+  auto
+  reallocate(T* p, std::size_t old_n, std::size_t new_n) noexcept -> T*
+  {
+#ifdef SLEIP_HAS_MREMAP
+    if (new_n > std::numeric_limits<std::size_t>::max() / sizeof(T)) { return nullptr; }
+
+    auto const old_bytes = old_n * sizeof(T);
+    auto const new_bytes = new_n * sizeof(T);
+    if (old_bytes < mmap_threshold || new_bytes < mmap_threshold) { return nullptr; }
+
+    // a shrink keeps the page that holds the new end, so the part of it that's dropped has to be
+    // zeroed for a later grow to find it that way
+    //
+    if (new_bytes < old_bytes) {
+      auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      auto const end  = std::min(old_bytes, (new_bytes + page - 1) / page * page);
+      std::memset(reinterpret_cast<unsigned char*>(p) + new_bytes, 0, end - new_bytes);
+    }
+
+    void* q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    return q == MAP_FAILED ? nullptr : static_cast<T*>(q);
+#else
+    static_cast<void>(p);
+    static_cast<void>(old_n);
+    static_cast<void>(new_n);
+    return nullptr;
+#endif
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+#ifdef SLEIP_HAS_MMAP
+    if (n * sizeof(T) >= mmap_threshold) {
+      ::munmap(p, n * sizeof(T));
+      return;
+    }
+#else
+    static_cast<void>(n);
+#endif
+
+    std::free(p);
+  }
+};
+
+template <class T, class U>
+auto
+operator==(zero_page_allocator<T> const&, zero_page_allocator<U> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U>
+auto
+operator!=(zero_page_allocator<T> const&, zero_page_allocator<U> const&) noexcept -> bool
+{
+  return false;
+}
+} // namespace sleip
+
+#endif // SLEIP_ZERO_PAGE_ALLOCATOR_HPP_
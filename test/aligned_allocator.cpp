@@ -0,0 +1,86 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+template <class T, std::size_t Align>
+using aligned_array = sleip::dynamic_array<T, sleip::aligned_allocator<T, Align>>;
+
+template <class T>
+auto
+is_aligned(T const* p, std::size_t align) -> bool
+{
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+static_assert(sleip::detail::allocator_alignment_v<std::allocator<double>> == alignof(double));
+static_assert(sleip::detail::allocator_alignment_v<sleip::aligned_allocator<float, 64>> == 64);
+
+static_assert(
+  std::is_same_v<
+    typename std::allocator_traits<sleip::aligned_allocator<float, 64>>::rebind_alloc<int>,
+    sleip::aligned_allocator<int, 64>>,
+  "rebinding must keep the alignment");
+
+static_assert(sleip::aligned_allocator<std::max_align_t, 1>::alignment == alignof(std::max_align_t),
+              "alignment is never weaker than the type's own");
+
+void
+test_cache_line_alignment()
+{
+  for (std::size_t count : {1, 3, 17, 1024}) {
+    auto a = aligned_array<float, 64>(count, 1.0f);
+
+    BOOST_TEST(is_aligned(a.data(), 64));
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](float x) { return x == 1.0f; }));
+
+    auto b = a;
+    BOOST_TEST(is_aligned(b.data(), 64));
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+  }
+}
+
+void
+test_page_alignment()
+{
+  auto a = sleip::dynamic_array<char, sleip::page_aligned_allocator<char>>(3 * 4096 + 1, 'a');
+
+  BOOST_TEST(is_aligned(a.data(), 4096));
+  BOOST_TEST_EQ(a.size(), 3 * 4096 + 1);
+
+  auto const& c = a;
+  BOOST_TEST(is_aligned(c.data(), 4096));
+}
+
+void
+test_array_element_type()
+{
+  auto a = aligned_array<float[4], 64>(33);
+
+  BOOST_TEST(is_aligned(a.data(), 64));
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& v) { return v[0] == 0.0f; }));
+}
+
+void
+test_empty()
+{
+  auto a = aligned_array<float, 64>();
+  BOOST_TEST_EQ(a.data(), nullptr);
+}
+
+int
+main()
+{
+  test_cache_line_alignment();
+  test_page_alignment();
+  test_array_element_type();
+  test_empty();
+
+  return boost::report_errors();
+}
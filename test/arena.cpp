@@ -0,0 +1,143 @@
+#include <sleip/arena.hpp>
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+static_assert(!std::allocator_traits<sleip::arena_allocator<int>>::is_always_equal::value);
+static_assert(std::allocator_traits<
+              sleip::arena_allocator<int>>::propagate_on_container_move_assignment::value);
+
+void
+test_arena()
+{
+  auto a = sleip::arena(256);
+
+  auto* p = static_cast<unsigned char*>(a.allocate(10, 1));
+  auto* q = static_cast<unsigned char*>(a.allocate(8, 8));
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(q) % 8, 0);
+  BOOST_TEST(q >= p + 10);
+
+  // only the most recent allocation is given back
+  //
+  auto const before = a.remaining();
+  a.deallocate(p, 10);
+  BOOST_TEST_EQ(a.remaining(), before);
+  a.deallocate(q, 8);
+  BOOST_TEST_EQ(a.remaining(), before + 8);
+  BOOST_TEST_EQ(a.allocate(8, 8), q);
+
+  // over-aligned and larger than a whole block
+  //
+  auto* r = a.allocate(64, 64);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(r) % 64, 0);
+
+  auto* s = static_cast<unsigned char*>(a.allocate(10'000, 16));
+  s[9'999] = 42;
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(s) % 16, 0);
+
+  a.release();
+  BOOST_TEST_EQ(a.remaining(), 0);
+  BOOST_TEST(a.allocate(1) != nullptr);
+}
+
+void
+test_initial_buffer()
+{
+  alignas(std::max_align_t) unsigned char buf[1024];
+
+  auto a = sleip::arena(buf, sizeof(buf));
+  BOOST_TEST_EQ(a.remaining(), sizeof(buf));
+
+  auto* p = static_cast<unsigned char*>(a.allocate(1000));
+  BOOST_TEST_EQ(p, buf);
+
+  auto* q = static_cast<unsigned char*>(a.allocate(100));
+  BOOST_TEST(q < buf || q >= buf + sizeof(buf));
+
+  a.release();
+  BOOST_TEST_EQ(a.remaining(), sizeof(buf));
+  BOOST_TEST_EQ(a.allocate(16), buf);
+}
+
+void
+test_dynamic_array()
+{
+  using alloc_type = sleip::arena_allocator<int>;
+
+  auto a = sleip::arena();
+
+  auto x = sleip::dynamic_array<int, alloc_type>(1000, 7, a);
+  BOOST_TEST(&x.get_allocator().get_arena() == &a);
+  BOOST_TEST_EQ(x[999], 7);
+
+  auto y = sleip::dynamic_array<int, alloc_type>(x.begin(), x.end(), a);
+  BOOST_TEST((x == y));
+
+  auto z = sleip::dynamic_array<int[3], sleip::arena_allocator<int[3]>>(10, {1, 2, 3}, a);
+  BOOST_TEST_EQ(z[9][2], 3);
+
+  // moving carries the arena along, and an array from another arena is re-homed on assignment
+  //
+  auto b = sleip::arena();
+  auto w = sleip::dynamic_array<int, alloc_type>(5, 1, b);
+
+  w = std::move(x);
+  BOOST_TEST(w.get_allocator() == alloc_type(a));
+  BOOST_TEST_EQ(w.size(), 1000);
+  BOOST_TEST(x.empty());
+
+  auto const u = std::move(w);
+  BOOST_TEST(u.get_allocator() == alloc_type(a));
+  BOOST_TEST(u.get_allocator() != alloc_type(b));
+  BOOST_TEST_EQ(u[0], 7);
+}
+
+void
+test_last_allocation_is_reclaimed()
+{
+  using alloc_type = sleip::arena_allocator<std::uint64_t>;
+
+  auto a = sleip::arena();
+
+  auto const keep = sleip::dynamic_array<std::uint64_t, alloc_type>(4, 0, a);
+
+  auto const remaining = a.remaining();
+  for (auto i = 0; i < 1000; ++i) {
+    auto tmp = sleip::dynamic_array<std::uint64_t, alloc_type>(128, sleip::noinit, a);
+    std::iota(tmp.begin(), tmp.end(), std::uint64_t{0});
+  }
+  BOOST_TEST_EQ(a.remaining(), remaining);
+}
+
+int
+main()
+{
+  test_arena();
+  test_initial_buffer();
+  test_dynamic_array();
+  test_last_allocation_is_reclaimed();
+
+  return boost::report_errors();
+}
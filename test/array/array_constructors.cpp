@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iterator>
 #include <list>
 #include <memory>
@@ -248,6 +249,31 @@ test_copy_constructible_allocator()
   BOOST_TEST_ALL_EQ(std::begin(arr), std::end(arr), std::begin(value), std::end(value));
 }
 
+void
+test_bulk_copy_constructible()
+{
+  static_assert(sleip::detail::is_bulk_copyable_v<std::uint8_t[3], std::allocator<std::uint8_t[3]>>);
+  static_assert(
+    !sleip::detail::is_bulk_copyable_v<int[3], pmr::polymorphic_allocator<int[3]>>,
+    "polymorphic_allocator supplies its own construct() so we can't bypass it");
+
+  std::uint8_t value[3]{0xde, 0xad, 0xbe};
+
+  sleip::dynamic_array<std::uint8_t[3]> const x(1024, value);
+  sleip::dynamic_array<std::uint8_t[3]> const y(x);
+  sleip::dynamic_array<std::uint8_t[3]> const z(x.begin(), x.end());
+
+  BOOST_TEST_EQ(y.size(), x.size());
+  BOOST_TEST_EQ(z.size(), x.size());
+
+  auto const* const p = boost::first_scalar(x.data());
+  auto const* const q = boost::first_scalar(y.data());
+  auto const* const r = boost::first_scalar(z.data());
+
+  BOOST_TEST_ALL_EQ(p, p + 3 * x.size(), q, q + 3 * y.size());
+  BOOST_TEST_ALL_EQ(p, p + 3 * x.size(), r, r + 3 * z.size());
+}
+
 void
 test_move_constructible()
 {
@@ -351,6 +377,7 @@ main()
   test_iterator_constructible();
   test_copy_constructible();
   test_copy_constructible_allocator();
+  test_bulk_copy_constructible();
   test_move_constructible();
   test_move_constructible_allocator();
   test_initializer_list_constructible();
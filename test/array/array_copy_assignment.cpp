@@ -47,8 +47,11 @@ test_copy_assignment_equal_allocators()
       BOOST_TEST(!std::equal(std::begin(arr), std::end(arr), std::begin(value), std::end(value)));
     }
 
+    auto const* const old_data = b.data();
+
     b = a;
 
+    BOOST_TEST_EQ(b.data(), old_data);
     for (auto const& arr : b) {
       BOOST_TEST(std::equal(std::begin(arr), std::end(arr), std::begin(value), std::end(value)));
     }
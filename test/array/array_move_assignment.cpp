@@ -83,8 +83,10 @@ test_move_assignment_non_equal_allocator()
     BOOST_TEST_EQ(a.size(), 2 * size);
     BOOST_TEST_NE(a.data(), old_data);
 
-    BOOST_TEST_EQ(b.data(), old_data);
-    BOOST_TEST_EQ(b.size(), 2 * size);
+    // `int[3]` is trivially relocatable so `b`'s buffer is handed back to its allocator
+    //
+    BOOST_TEST_EQ(b.data(), nullptr);
+    BOOST_TEST_EQ(b.size(), 0);
   }
 
   // non-empty
@@ -0,0 +1,272 @@
+#include <sleip/array_group.hpp>
+#include <sleip/dynamic_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+// forwards to `std::allocator` while counting the calls, every copy shares the counters
+//
+template <class T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  int* num_allocs   = nullptr;
+  int* num_deallocs = nullptr;
+
+  counting_allocator(int* a, int* d) noexcept
+    : num_allocs{a}
+    , num_deallocs{d}
+  {
+  }
+
+  template <class U>
+  counting_allocator(counting_allocator<U> const& other) noexcept
+    : num_allocs{other.num_allocs}
+    , num_deallocs{other.num_deallocs}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    ++*num_allocs;
+    return std::allocator<T>().allocate(n);
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    ++*num_deallocs;
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template <class T, class U>
+auto
+operator==(counting_allocator<T> const& lhs, counting_allocator<U> const& rhs) noexcept -> bool
+{
+  return lhs.num_allocs == rhs.num_allocs;
+}
+
+template <class T, class U>
+auto
+operator!=(counting_allocator<T> const& lhs, counting_allocator<U> const& rhs) noexcept -> bool
+{
+  return !(lhs == rhs);
+}
+
+using rgba = std::uint8_t[4];
+
+static_assert(std::is_same_v<decltype(sleip::make_dynamic_arrays<float, int>(1, 2)),
+                             std::tuple<sleip::grouped_dynamic_array<float>,
+                                        sleip::grouped_dynamic_array<int>>>);
+
+void
+test_one_allocation()
+{
+  auto num_allocs   = 0;
+  auto num_deallocs = 0;
+
+  auto const alloc = counting_allocator<std::byte>(&num_allocs, &num_deallocs);
+
+  {
+    auto [xs, ids, pixels] = sleip::make_dynamic_arrays<float, int, rgba>(
+      std::allocator_arg, alloc, std::size_t{100}, 7, 33);
+
+    BOOST_TEST_EQ(num_allocs, 1);
+
+    BOOST_TEST_EQ(xs.size(), 100);
+    BOOST_TEST_EQ(ids.size(), 7);
+    BOOST_TEST_EQ(pixels.size(), 33);
+
+    // value-initialized, and each on its own cache line
+    //
+    BOOST_TEST(std::all_of(xs.begin(), xs.end(), [](float x) { return x == 0; }));
+    BOOST_TEST_EQ(pixels[32][3], 0);
+
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(xs.data()) % 64, 0);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(ids.data()) % 64, 0);
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(pixels.data()) % 64, 0);
+
+    auto const* const first = reinterpret_cast<std::byte const*>(xs.data());
+    BOOST_TEST_EQ(reinterpret_cast<std::byte const*>(ids.data()) - first, 448);
+    BOOST_TEST_EQ(reinterpret_cast<std::byte const*>(pixels.data()) - first, 512);
+
+    ids[6]       = 42;
+    pixels[0][1] = 7;
+    BOOST_TEST_EQ(ids.back(), 42);
+
+    // the arrays can be released in any order, the block goes with the last one
+    //
+    auto gone = std::move(ids);
+    BOOST_TEST(ids.empty());
+    BOOST_TEST_EQ(gone[6], 42);
+
+    {
+      auto dropped = std::move(xs);
+    }
+    BOOST_TEST_EQ(num_deallocs, 0);
+  }
+
+  BOOST_TEST_EQ(num_allocs, 1);
+  BOOST_TEST_EQ(num_deallocs, 1);
+}
+
+void
+test_noinit()
+{
+  auto [a, b] = sleip::make_dynamic_arrays<double, std::uint16_t>(sleip::noinit, 10, 0);
+  BOOST_TEST_EQ(a.size(), 10);
+  BOOST_TEST(b.empty());
+
+  std::fill(a.begin(), a.end(), 1.5);
+  BOOST_TEST_EQ(a[9], 1.5);
+
+  auto [s] = sleip::make_dynamic_arrays<std::string>(3);
+  s[2]     = "grouped";
+  BOOST_TEST_EQ(s[2], "grouped");
+  BOOST_TEST(s[0].empty());
+}
+
+void
+test_copies_leave_the_group()
+{
+  auto num_allocs   = 0;
+  auto num_deallocs = 0;
+
+  auto const alloc = counting_allocator<std::byte>(&num_allocs, &num_deallocs);
+
+  auto copy = sleip::grouped_dynamic_array<int, counting_allocator<std::byte>>(
+    sleip::array_group_allocator<int, counting_allocator<std::byte>>(alloc));
+
+  {
+    auto [a, b] =
+      sleip::make_dynamic_arrays<int, int>(std::allocator_arg, alloc, sleip::noinit, 4, 4);
+    std::fill(a.begin(), a.end(), 3);
+
+    copy = a;
+    BOOST_TEST(copy == a);
+    BOOST_TEST_EQ(num_allocs, 2);
+
+    // a same-sized copy assignment reuses the slot in place
+    //
+    auto const* const old_data = b.data();
+
+    b = a;
+    BOOST_TEST_EQ(b.data(), old_data);
+    BOOST_TEST_EQ(b[3], 3);
+
+    auto c = a;
+    BOOST_TEST_EQ(num_allocs, 3);
+    BOOST_TEST_NE(c.data(), a.data());
+  }
+
+  // the group's block and `c` are gone, `copy` doesn't keep the group alive
+  //
+  BOOST_TEST_EQ(num_deallocs, 2);
+  BOOST_TEST_EQ(copy[0], 3);
+}
+
+void
+test_allocator()
+{
+  using alloc_type = sleip::array_group_allocator<int>;
+
+  auto [a, b] = sleip::make_dynamic_arrays<int, long>(1, 1);
+
+  auto const x = a.get_allocator();
+  auto const y = sleip::array_group_allocator<long>(b.get_allocator());
+  BOOST_TEST(x == y);
+  BOOST_TEST(x != alloc_type());
+  BOOST_TEST(alloc_type() == alloc_type());
+
+  // a rebound copy never hands out the group's slots
+  //
+  auto z = alloc_type(y);
+  auto* p = z.allocate(1);
+  BOOST_TEST_NE(p, a.data());
+  z.deallocate(p, 1);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+
+  throwing()
+  {
+    if (num_live == 5) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const&) = delete;
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  auto num_allocs   = 0;
+  auto num_deallocs = 0;
+
+  auto const alloc = counting_allocator<std::byte>(&num_allocs, &num_deallocs);
+
+  throwing::num_live = 0;
+  BOOST_TEST_THROWS(
+    (sleip::make_dynamic_arrays<throwing, throwing>(std::allocator_arg, alloc, 3, 3)), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+  BOOST_TEST_EQ(num_allocs, 1);
+  BOOST_TEST_EQ(num_deallocs, 1);
+
+  auto const huge = std::size_t(-1) / 2;
+  BOOST_TEST_THROWS((sleip::make_dynamic_arrays<int, int>(sleip::noinit, 1, huge)),
+                    std::bad_array_new_length);
+}
+
+#endif
+
+int
+main()
+{
+  test_one_allocation();
+  test_noinit();
+  test_copies_leave_the_group();
+  test_allocator();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -2,6 +2,15 @@
 
 #include <boost/core/lightweight_test.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 void
 test_equality()
 {
@@ -54,11 +63,150 @@ test_greater_than_less_than()
   BOOST_ASSERT((a >= c));
 }
 
+void
+test_different_lengths()
+{
+  // a shorter array with equal leading elements orders first, whatever the element type
+  //
+  auto const a = sleip::dynamic_array<int>{1, 2, 3};
+  auto const b = sleip::dynamic_array<int>{1, 2, 3, 0};
+  auto const c = sleip::dynamic_array<int>{1, 3};
+
+  BOOST_TEST(a != b);
+  BOOST_TEST(a < b);
+  BOOST_TEST(!(b < a));
+  BOOST_TEST(b < c);
+  BOOST_TEST(a < c);
+  BOOST_TEST(c > b);
+  BOOST_TEST(a <= b);
+  BOOST_TEST(c >= a);
+
+  auto const empty = sleip::dynamic_array<int>();
+  BOOST_TEST(empty < a);
+  BOOST_TEST(empty == sleip::dynamic_array<int>());
+  BOOST_TEST(!(empty < sleip::dynamic_array<int>()));
+}
+
+void
+test_bytes()
+{
+  using bytes = sleip::dynamic_array<std::uint8_t>;
+
+  // bytes above 127 have to order after the ones below it
+  //
+  auto const a = bytes{0x01, 0xff};
+  auto const b = bytes{0x01, 0x7f, 0x00};
+  auto const c = bytes{0x01, 0xff, 0x00};
+
+  BOOST_TEST(b < a);
+  BOOST_TEST(a < c);
+  BOOST_TEST(!(a == c));
+
+  // long enough to cover whole blocks and a tail
+  //
+  auto x = bytes(1000, 7);
+  auto y = x;
+  BOOST_TEST(x == y);
+
+  y[999] = 8;
+  BOOST_TEST(x != y);
+  BOOST_TEST(x < y);
+
+  auto const bs = sleip::dynamic_array<std::byte>{std::byte{0x80}};
+  BOOST_TEST(sleip::dynamic_array<std::byte>{std::byte{0x7f}} < bs);
+}
+
+void
+test_scalars()
+{
+  // multi-byte scalars compare by value, not by their little-endian bytes
+  //
+  using keys = sleip::dynamic_array<std::uint32_t[4]>;
+
+  auto a = keys(100, {1, 2, 3, 4});
+  auto b = a;
+  BOOST_TEST(a == b);
+
+  b[70][2] = 0x100;
+  a[70][2] = 0x0ff;
+  BOOST_TEST(a < b);
+  BOOST_TEST(!(b < a));
+
+  b[70][2] = 3;
+  a[70][2] = 3;
+  BOOST_TEST(a == b);
+
+  auto neg = sleip::dynamic_array<int>(300, 0);
+  auto pos = neg;
+  neg[260] = -1;
+  BOOST_TEST(neg < pos);
+
+  // `-0.0 == 0.0` even though their bytes differ
+  //
+  BOOST_TEST((sleip::dynamic_array<double>{-0.0} == sleip::dynamic_array<double>{0.0}));
+  BOOST_TEST(!(sleip::dynamic_array<double>{-1.0} > sleip::dynamic_array<double>{0.0}));
+
+  auto const s = sleip::dynamic_array<std::string>{"b", "a"};
+  BOOST_TEST(sleip::dynamic_array<std::string>{"b"} < s);
+}
+
+void
+test_sorted_keys()
+{
+  using key = sleip::dynamic_array<std::uint8_t>;
+
+  auto keys = std::vector<key>{key{3}, key{1, 2}, key{1}, key{3}, key{}, key{1, 2}};
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  BOOST_TEST_EQ(keys.size(), 4);
+  BOOST_TEST(keys[0].empty());
+  BOOST_TEST((keys[1] == key{1}));
+  BOOST_TEST((keys[2] == key{1, 2}));
+  BOOST_TEST((keys[3] == key{3}));
+
+  auto set = std::set<key>{key{1, 2}, key{1}, key{1, 2, 0}};
+  BOOST_TEST_EQ(set.size(), 3);
+  BOOST_TEST((*set.begin() == key{1}));
+}
+
+void
+test_three_way()
+{
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+  using bytes = sleip::dynamic_array<std::uint8_t>;
+  using keys  = sleip::dynamic_array<std::uint32_t[2]>;
+
+  static_assert(std::is_same_v<decltype(bytes() <=> bytes()), std::strong_ordering>);
+  static_assert(
+    std::is_same_v<decltype(sleip::dynamic_array<float>() <=> sleip::dynamic_array<float>()),
+                   std::partial_ordering>);
+
+  BOOST_TEST((bytes{1, 2} <=> bytes{1, 2}) == 0);
+  BOOST_TEST((bytes{1, 2} <=> bytes{1, 2, 3}) < 0);
+  BOOST_TEST((bytes{0x80} <=> bytes{0x7f, 0xff}) > 0);
+
+  BOOST_TEST((keys(3, {1, 0x100}) <=> keys(3, {1, 0xff})) > 0);
+  BOOST_TEST((keys(2, {1, 2}) <=> keys(3, {1, 2})) < 0);
+
+  BOOST_TEST((sleip::dynamic_array<std::string>{"a"} <=> sleip::dynamic_array<std::string>{"b"}) <
+             0);
+
+  auto const nan = sleip::dynamic_array<double>{std::numeric_limits<double>::quiet_NaN()};
+  BOOST_TEST((nan <=> nan) == std::partial_ordering::unordered);
+#endif
+}
+
 int
 main()
 {
   test_equality();
   test_greater_than_less_than();
+  test_different_lengths();
+  test_bytes();
+  test_scalars();
+  test_sorted_keys();
+  test_three_way();
 
   return boost::report_errors();
 }
@@ -2,6 +2,7 @@
 
 #include <boost/core/default_allocator.hpp>
 #include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/container/pmr/unsynchronized_pool_resource.hpp>
 
 #include <algorithm>
 #include <array>
@@ -217,6 +218,105 @@ test_copy_constructible_allocator()
   BOOST_TEST_ALL_EQ(buf2.begin(), buf2.end(), buf.begin(), buf.end());
 }
 
+template <class T>
+struct construct_counting_allocator
+{
+  using value_type = T;
+
+  std::size_t* count;
+
+  construct_counting_allocator(std::size_t* count_) noexcept
+    : count{count_}
+  {
+  }
+
+  template <class U>
+  construct_counting_allocator(construct_counting_allocator<U> const& other) noexcept
+    : count{other.count}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    return std::allocator<T>().allocate(n);
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) -> void
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <class U, class... Args>
+  auto
+  construct(U* p, Args&&... args) -> void
+  {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    ++*count;
+  }
+
+  template <class U>
+  auto
+  operator==(construct_counting_allocator<U> const& other) const noexcept -> bool
+  {
+    return count == other.count;
+  }
+
+  template <class U>
+  auto
+  operator!=(construct_counting_allocator<U> const& other) const noexcept -> bool
+  {
+    return !(*this == other);
+  }
+};
+
+void
+test_bulk_copy_constructible()
+{
+  static_assert(sleip::detail::is_bulk_copyable_v<int, std::allocator<int>>);
+  static_assert(sleip::detail::is_bulk_copyable_v<int, boost::default_allocator<int>>);
+  static_assert(!sleip::detail::is_bulk_copyable_v<std::string, std::allocator<std::string>>);
+  static_assert(!sleip::detail::is_bulk_copyable_v<int, construct_counting_allocator<int>>);
+
+  {
+    auto const a = sleip::dynamic_array<float>(1024, 1.5f);
+    auto const b = a;
+
+    BOOST_TEST_NE(a.data(), b.data());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+
+    auto const c = sleip::dynamic_array<float>(a.begin(), a.end());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), c.begin(), c.end());
+  }
+
+  {
+    auto const a = sleip::dynamic_array<int>();
+    auto const b = a;
+
+    BOOST_TEST(b.empty());
+  }
+
+  // an allocator with its own `construct` must still see every element
+  //
+  {
+    auto count = std::size_t{0};
+    auto alloc = construct_counting_allocator<int>(&count);
+
+    auto const a = sleip::dynamic_array<int, construct_counting_allocator<int>>(16, 7, alloc);
+    BOOST_TEST_EQ(count, 16);
+
+    auto const b = a;
+    BOOST_TEST_EQ(count, 32);
+
+    auto const c = sleip::dynamic_array<int, construct_counting_allocator<int>>(a, alloc);
+    BOOST_TEST_EQ(count, 48);
+
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), c.begin(), c.end());
+  }
+}
+
 void
 test_move_constructible()
 {
@@ -250,6 +350,28 @@ test_move_constructible_allocator()
   BOOST_TEST_ALL_EQ(buf2.begin(), buf2.end(), nums.begin(), nums.end());
 }
 
+void
+test_move_constructible_allocator_relocation()
+{
+  auto const nums = std::vector{1, 2, 3, 4, 5};
+
+  auto pool       = pmr::unsynchronized_pool_resource();
+  auto pool_alloc = pmr::polymorphic_allocator<int>(&pool);
+
+  BOOST_TEST(pool_alloc != pmr::polymorphic_allocator<int>());
+
+  sleip::dynamic_array<int, pmr::polymorphic_allocator<int>> buf(nums.begin(), nums.end(),
+                                                                  pool_alloc);
+
+  sleip::dynamic_array<int, pmr::polymorphic_allocator<int>> buf2(
+    std::move(buf), pmr::polymorphic_allocator<int>());
+
+  BOOST_TEST_EQ(buf.size(), 0);
+  BOOST_TEST_EQ(buf.data(), nullptr);
+  BOOST_TEST_EQ(buf2.size(), nums.size());
+  BOOST_TEST_ALL_EQ(buf2.begin(), buf2.end(), nums.begin(), nums.end());
+}
+
 void
 test_initializer_list_constructible()
 {
@@ -305,8 +427,10 @@ main()
   test_iterator_constructible();
   test_copy_constructible();
   test_copy_constructible_allocator();
+  test_bulk_copy_constructible();
   test_move_constructible();
   test_move_constructible_allocator();
+  test_move_constructible_allocator_relocation();
   test_initializer_list_constructible();
   test_range_constructible();
 
@@ -42,6 +42,52 @@ test_copy_assignment_equal_allocators()
   }
 }
 
+void
+test_copy_assignment_reuses_storage()
+{
+  // same size + equal allocators
+  {
+    auto a = sleip::dynamic_array<int>{1, 2, 3};
+    auto b = sleip::dynamic_array<int>{4, 5, 6};
+
+    auto const* const old_data = b.data();
+
+    b = a;
+
+    BOOST_TEST_EQ(b.data(), old_data);
+    BOOST_TEST_ALL_EQ(b.begin(), b.end(), a.begin(), a.end());
+
+    b = b;
+
+    BOOST_TEST_EQ(b.data(), old_data);
+    BOOST_TEST_ALL_EQ(b.begin(), b.end(), a.begin(), a.end());
+  }
+
+  // same size + non-equal allocators, polymorphic_allocator doesn't propagate so we keep our storage
+  {
+    auto mem           = std::array<std::byte, 4096>{};
+    auto buff_resource = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+    auto alloc1 = pmr::polymorphic_allocator<int>(&buff_resource);
+    auto alloc2 = pmr::polymorphic_allocator<int>();
+
+    auto const size = 256;
+
+    auto a = sleip::dynamic_array<int, pmr::polymorphic_allocator<int>>(size, -1, alloc1);
+    auto b = sleip::dynamic_array<int, pmr::polymorphic_allocator<int>>(size, 1, alloc2);
+
+    auto const* const old_data  = a.data();
+    auto const        remaining = buff_resource.remaining_storage();
+
+    a = b;
+
+    BOOST_TEST_EQ(a.data(), old_data);
+    BOOST_TEST(a.get_allocator() == alloc1);
+    BOOST_TEST_EQ(buff_resource.remaining_storage(), remaining);
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+  }
+}
+
 #ifdef BOOST_NO_EXCEPTIONS
 
 void
@@ -254,6 +300,7 @@ int
 main()
 {
   test_copy_assignment_equal_allocators();
+  test_copy_assignment_reuses_storage();
   test_copy_assignment_equal_allocators_throwing();
   test_copy_assignment_non_equal_allocators();
   test_copy_assignment_non_equal_allocators_throwing();
@@ -0,0 +1,242 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array_nd.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+static_assert(std::is_convertible_v<sleip::nd_view<int, 2>, sleip::nd_view<int const, 2>>);
+static_assert(!std::is_convertible_v<sleip::nd_view<int const, 2>, sleip::nd_view<int, 2>>);
+
+void
+test_layout()
+{
+  auto a = sleip::dynamic_array_nd<int, 3>({2, 3, 5}, 1);
+  BOOST_TEST_EQ(a.rank(), 3);
+  BOOST_TEST_EQ(a.size(), 30);
+  BOOST_TEST_EQ(a.storage_size(), 30);
+  BOOST_TEST_EQ(a.stride(0), 15);
+  BOOST_TEST_EQ(a.stride(1), 5);
+  BOOST_TEST_EQ(a.stride(2), 1);
+
+  a(1, 2, 4) = 7;
+  BOOST_TEST_EQ(a.data()[29], 7);
+  BOOST_TEST_EQ(a.at(1, 2, 4), 7);
+  BOOST_TEST_EQ(a(0, 0, 0), 1);
+
+  auto b = sleip::dynamic_array_nd<int, 2>({0, 4});
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(b.size(), 0);
+  BOOST_TEST_EQ(b.storage_size(), 0);
+}
+
+void
+test_padding()
+{
+  using alloc_type = sleip::cache_aligned_allocator<float>;
+
+  auto a = sleip::dynamic_array_nd<float, 2, alloc_type>({3, 20}, sleip::row_padding{64}, 0.0f);
+  BOOST_TEST_EQ(a.stride(0), 32);
+  BOOST_TEST_EQ(a.storage_size(), 96);
+  BOOST_TEST_EQ(a.size(), 60);
+
+  for (std::size_t i = 0; i < a.extent(0); ++i) {
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&a(i, 0)) % 64, 0);
+  }
+
+  // element sizes that don't divide the padding round up to a common multiple
+  //
+  using rgb = std::uint8_t[3];
+
+  auto b = sleip::dynamic_array_nd<rgb, 2>({4, 10}, sleip::row_padding{64}, sleip::noinit);
+  BOOST_TEST_EQ(b.stride(0), 64);
+  BOOST_TEST_EQ(b.stride(0) * sizeof(rgb) % 64, 0);
+
+  b(3, 9)[2] = 42;
+  BOOST_TEST_EQ(b.data()[3 * 64 + 9][2], 42);
+
+  // a single row isn't padded
+  //
+  auto c = sleip::dynamic_array_nd<float, 1>({20}, sleip::row_padding{64});
+  BOOST_TEST_EQ(c.storage_size(), 20);
+}
+
+void
+test_views()
+{
+  auto a = sleip::dynamic_array_nd<int, 2>({4, 6}, sleip::row_padding{32}, 0);
+  for (std::size_t i = 0; i < 4; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) { a(i, j) = static_cast<int>(10 * i + j); }
+  }
+
+  auto v = a.view();
+  BOOST_TEST_EQ(v(2, 3), 23);
+  BOOST_TEST_EQ(v.stride(0), a.stride(0));
+
+  auto const s = v.subview({1, 2}, {2, 3});
+  BOOST_TEST_EQ(s.extent(0), 2);
+  BOOST_TEST_EQ(s.extent(1), 3);
+  BOOST_TEST_EQ(s(0, 0), 12);
+  BOOST_TEST_EQ(s(1, 2), 24);
+
+  sleip::nd_view<int const, 2> c = s;
+  BOOST_TEST_EQ(c(1, 1), 23);
+
+  // a densely packed view over external storage
+  //
+  int raw[2][3] = {{1, 2, 3}, {4, 5, 6}};
+
+  auto r = sleip::nd_view<int, 2>(&raw[0][0], {2, 3});
+  BOOST_TEST_EQ(r.stride(0), 3);
+  BOOST_TEST_EQ(r(1, 0), 4);
+}
+
+void
+test_copy_rect()
+{
+  auto a = sleip::dynamic_array_nd<int, 2>({5, 7}, sleip::row_padding{64}, 0);
+  for (std::size_t i = 0; i < 5; ++i) {
+    for (std::size_t j = 0; j < 7; ++j) { a(i, j) = static_cast<int>(10 * i + j); }
+  }
+
+  auto b = sleip::dynamic_array_nd<int, 2>({3, 3}, -1);
+
+  sleip::copy_rect(a.cview().subview({1, 2}, {3, 3}), b.view());
+  BOOST_TEST_EQ(b(0, 0), 12);
+  BOOST_TEST_EQ(b(2, 2), 34);
+
+  // non-trivial elements and a strided innermost dimension both go element by element
+  //
+  auto s = sleip::dynamic_array_nd<std::string, 2>({2, 4}, std::string("x"));
+  auto t = sleip::dynamic_array_nd<std::string, 2>({2, 2});
+
+  s(1, 2) = "y";
+
+  auto const every_other = sleip::nd_view<std::string const, 2>(s.data(), {2, 2}, {4, 2});
+  sleip::copy_rect(every_other, t.view());
+  BOOST_TEST_EQ(t(0, 0), "x");
+  BOOST_TEST_EQ(t(1, 1), "y");
+
+  auto c = sleip::dynamic_array_nd<int, 3>({2, 2, 2}, 3);
+  auto d = sleip::dynamic_array_nd<int, 3>({2, 2, 2}, sleip::row_padding{16}, 0);
+  sleip::copy_rect(c.cview(), d.view());
+  BOOST_TEST_EQ(d(1, 1, 1), 3);
+}
+
+void
+test_transpose()
+{
+  // larger than a tile in both directions and not a multiple of one
+  //
+  auto const rows = std::size_t{70};
+  auto const cols = std::size_t{131};
+
+  auto a = sleip::dynamic_array_nd<double, 2>({rows, cols}, sleip::noinit);
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) { a(i, j) = static_cast<double>(i * cols + j); }
+  }
+
+  auto b = sleip::dynamic_array_nd<double, 2>({cols, rows}, sleip::row_padding{64}, 0.0);
+  sleip::transpose(a.cview(), b.view());
+
+  auto mismatches = 0;
+  for (std::size_t i = 0; i < rows; ++i) {
+    for (std::size_t j = 0; j < cols; ++j) { mismatches += b(j, i) != a(i, j) ? 1 : 0; }
+  }
+  BOOST_TEST_EQ(mismatches, 0);
+
+  using pair_type = int[2];
+
+  auto p = sleip::dynamic_array_nd<pair_type, 2>({2, 3}, {1, 2});
+  auto q = sleip::dynamic_array_nd<pair_type, 2>({3, 2});
+
+  p(0, 2)[1] = 9;
+  sleip::transpose(p.cview(), q.view());
+  BOOST_TEST_EQ(q(2, 0)[1], 9);
+  BOOST_TEST_EQ(q(1, 1)[0], 1);
+}
+
+void
+test_move()
+{
+  auto a = sleip::dynamic_array_nd<int, 2>({3, 4}, 1);
+  auto b = std::move(a);
+
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.size(), 0);
+  BOOST_TEST_EQ(b.size(), 12);
+
+  auto c = sleip::dynamic_array_nd<int, 2>();
+  c      = b;
+  BOOST_TEST_EQ(c.extent(1), 4);
+  BOOST_TEST_EQ(c(2, 3), 1);
+
+  swap(a, c);
+  BOOST_TEST(c.empty());
+  BOOST_TEST_EQ(a.size(), 12);
+
+  c = std::move(a);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.extent(0), 0);
+  BOOST_TEST_EQ(c.size(), 12);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+void
+test_throwing()
+{
+  auto a = sleip::dynamic_array_nd<int, 2>({3, 4});
+  BOOST_TEST_THROWS(a.at(3, 0), std::out_of_range);
+  BOOST_TEST_THROWS(a.at(0, 4), std::out_of_range);
+
+  auto b = sleip::dynamic_array_nd<int, 2>({4, 3});
+  BOOST_TEST_THROWS(sleip::copy_rect(a.cview(), b.view()), std::invalid_argument);
+  BOOST_TEST_THROWS(sleip::transpose(a.cview(), a.view()), std::invalid_argument);
+
+  auto const huge = std::size_t(1) << 40;
+  BOOST_TEST_THROWS((sleip::dynamic_array_nd<int, 2>({huge, huge})), std::bad_array_new_length);
+}
+
+#endif
+
+int
+main()
+{
+  test_layout();
+  test_padding();
+  test_views();
+  test_copy_rect();
+  test_transpose();
+  test_move();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,283 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/execution.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/container/pmr/string.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace pmr = boost::container::pmr;
+
+// large enough that `par` splits the work into several chunks
+//
+constexpr std::size_t const count = std::size_t{1} << 16;
+
+void
+test_chunk_bounds()
+{
+  auto covered = std::size_t{0};
+  for (std::size_t idx = 0; idx < 7; ++idx) {
+    auto const [first, last] = sleip::detail::chunk_bounds(100, 7, idx);
+
+    BOOST_TEST_EQ(first, covered);
+    BOOST_TEST(last - first == 14 || last - first == 15);
+    covered = last;
+  }
+  BOOST_TEST_EQ(covered, 100);
+
+  BOOST_TEST_EQ(sleip::detail::num_chunks<int>(64, 1), 1);
+  BOOST_TEST_EQ(sleip::detail::num_chunks<int>(4, count), 4);
+}
+
+void
+test_count_value_constructor()
+{
+  auto const policy = sleip::parallel_policy{4};
+
+  {
+    auto a = sleip::dynamic_array<double>(policy, count, 3.0);
+
+    BOOST_TEST_EQ(a.size(), count);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](double x) { return x == 3.0; }));
+  }
+
+  {
+    int value[3] = {1, 2, 3};
+
+    auto a = sleip::dynamic_array<int[3]>(policy, count, value);
+
+    BOOST_TEST_EQ(a.size(), count);
+    for (auto const& arr : a) { BOOST_TEST_ALL_EQ(arr, arr + 3, value, value + 3); }
+  }
+
+  {
+    auto a = sleip::dynamic_array<std::string>(sleip::seq, 16, std::string("sleip"));
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& s) { return s == "sleip"; }));
+  }
+}
+
+void
+test_iterator_constructor()
+{
+  auto const policy = sleip::parallel_policy{4};
+
+  auto nums = std::vector<int>(count);
+  std::iota(nums.begin(), nums.end(), 0);
+
+  // contiguous
+  //
+  {
+    auto a = sleip::dynamic_array<int>(policy, nums.data(), nums.data() + nums.size());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), nums.begin(), nums.end());
+  }
+
+  // contiguous with an allocator that has its own `construct`
+  //
+  {
+    auto a = sleip::dynamic_array<int, pmr::polymorphic_allocator<int>>(
+      policy, nums.data(), nums.data() + nums.size());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), nums.begin(), nums.end());
+  }
+
+  // forward only
+  //
+  {
+    auto const list = std::list<int>(nums.begin(), nums.end());
+
+    auto a = sleip::dynamic_array<int>(policy, list.begin(), list.end());
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), list.begin(), list.end());
+  }
+
+  // array element types
+  //
+  {
+    int value[2] = {-1, 1};
+
+    auto const a = sleip::dynamic_array<int[2]>(count, value);
+    auto const b = sleip::dynamic_array<int[2]>(policy, a.begin(), a.end());
+
+    auto const* p = boost::first_scalar(a.data());
+    auto const* q = boost::first_scalar(b.data());
+    BOOST_TEST_ALL_EQ(p, p + 2 * a.size(), q, q + 2 * b.size());
+  }
+}
+
+void
+test_fill()
+{
+  auto const policy = sleip::parallel_policy{4};
+
+  {
+    auto a = sleip::dynamic_array<int>(count, sleip::noinit);
+    a.fill(policy, 1337);
+
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1337; }));
+  }
+
+  {
+    int value[3] = {4, 5, 6};
+
+    auto a = sleip::dynamic_array<int[3]>(count);
+    a.fill(policy, value);
+
+    for (auto const& arr : a) { BOOST_TEST_ALL_EQ(arr, arr + 3, value, value + 3); }
+  }
+
+  {
+    // every chunk of a large fill streams, including the ones that start mid cache line
+    //
+    std::uint8_t value[3] = {7, 8, 9};
+
+    auto a = sleip::dynamic_array<std::uint8_t[3]>(sleip::detail::streaming_fill_bytes / 3 + 5);
+    a.fill(policy, value);
+
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& px) { return px[2] == 9; }));
+    BOOST_TEST_EQ(a.back()[0], 7);
+  }
+
+  {
+    auto a = sleip::dynamic_array<int>();
+    a.fill(policy, 1);
+
+    BOOST_TEST(a.empty());
+  }
+}
+
+// runs every chunk inline and records how many it was handed
+//
+struct counting_policy
+{
+  std::size_t* num_chunks;
+
+  auto
+  concurrency() const noexcept -> std::size_t
+  {
+    return 4;
+  }
+
+  template <class F>
+  auto
+  bulk(std::size_t const n, F const& f) const -> void
+  {
+    *num_chunks = n;
+    for (std::size_t i = 0; i < n; ++i) { f(i); }
+  }
+};
+
+template <>
+struct sleip::is_execution_policy<counting_policy> : std::true_type
+{
+};
+
+void
+test_unsynchronized_allocators()
+{
+  auto num_chunks = std::size_t{0};
+  auto policy     = counting_policy{&num_chunks};
+
+  auto a = sleip::dynamic_array<int>(policy, count, 1);
+  BOOST_TEST_EQ(num_chunks, 4);
+
+  a.fill(policy, 2);
+  BOOST_TEST_EQ(num_chunks, 4);
+
+  // the strings allocate from a `monotonic_buffer_resource`, which isn't safe to share between
+  // threads
+  //
+  using string_type = pmr::string;
+  using alloc_type  = pmr::polymorphic_allocator<string_type>;
+
+  auto buff = pmr::monotonic_buffer_resource();
+
+  auto const value = string_type("a string too long for the small buffer");
+
+  auto b = sleip::dynamic_array<string_type, alloc_type>(policy, count, value, alloc_type(&buff));
+  BOOST_TEST_EQ(num_chunks, 1);
+  BOOST_TEST(std::all_of(b.begin(), b.end(), [&](auto const& s) { return s == value; }));
+
+  b.fill(policy, string_type("another string too long for the small buffer"));
+  BOOST_TEST_EQ(num_chunks, 1);
+  BOOST_TEST_EQ(b.back().size(), 44);
+
+  auto c = sleip::dynamic_array<string_type, alloc_type>(policy, b.begin(), b.end(),
+                                                         alloc_type(&buff));
+  BOOST_TEST_EQ(num_chunks, 1);
+  BOOST_TEST(c == b);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline std::atomic<int> num_live{0};
+  static inline std::atomic<int> num_copies{0};
+
+  int x = 0;
+
+  throwing() = default;
+
+  throwing(int x_)
+    : x{x_}
+  {
+  }
+
+  throwing(throwing const& other)
+    : x{other.x}
+  {
+    if (++num_copies == static_cast<int>(count / 2)) { throw 42; }
+    ++num_live;
+  }
+
+  ~throwing()
+  {
+    if (x != 0) { --num_live; }
+  }
+};
+
+void
+test_throwing()
+{
+  auto const value = throwing{1};
+
+  throwing::num_copies = 0;
+  throwing::num_live   = 0;
+
+  BOOST_TEST_THROWS((sleip::dynamic_array<throwing>(sleip::parallel_policy{4}, count, value)), int);
+
+  // every chunk that finished and every partial chunk must have been unwound
+  //
+  BOOST_TEST_EQ(throwing::num_live.load(), 0);
+}
+
+#endif
+
+int
+main()
+{
+  test_chunk_bounds();
+  test_count_value_constructor();
+  test_iterator_constructor();
+  test_fill();
+  test_unsynchronized_allocators();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -66,6 +66,19 @@ test_shmem_allocator()
   a.fill(-1);
 
   BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+
+  // ownership moves between arrays as the segment's offset pointer
+  //
+  auto [data, size, alloc] = a.release();
+  BOOST_TEST(a.empty());
+  BOOST_TEST(data != nullptr);
+
+  using array_type =
+    sleip::dynamic_array<int, ipc::allocator<int, ipc::managed_shared_memory::segment_manager>>;
+
+  auto c = array_type(sleip::adopt, data, size, alloc);
+  BOOST_TEST_EQ(c.size(), 128);
+  BOOST_TEST_ALL_EQ(c.begin(), c.end(), b.begin(), b.end());
 }
 
 int
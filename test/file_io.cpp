@@ -0,0 +1,226 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array.hpp>
+#include <sleip/file_io.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/stat.h>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+// remove the file on construction and destruction
+//
+struct temp_file
+{
+  std::string path;
+
+  explicit temp_file(std::string path_)
+    : path{std::move(path_)}
+  {
+    std::remove(path.c_str());
+  }
+
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+// the directories to run every test against, the build directory is a regular disk backed file
+// system and /dev/shm is tmpfs which has its own `O_DIRECT` behavior
+//
+auto
+test_dirs() -> std::vector<std::string>
+{
+  auto dirs = std::vector<std::string>{"."};
+
+  struct stat st;
+  if (::stat("/dev/shm", &st) == 0 && S_ISDIR(st.st_mode)) { dirs.emplace_back("/dev/shm"); }
+  return dirs;
+}
+
+auto
+file_size(std::string const& path) -> std::size_t
+{
+  struct stat st;
+  return ::stat(path.c_str(), &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+}
+
+void
+test_round_trip(std::string const& dir, sleip::file_io_backend backend, bool direct)
+{
+  auto const tmp = temp_file(dir + "/sleip_file_io_round_trip.dat");
+
+  auto options        = sleip::file_io_options();
+  options.chunk_size  = 4096;
+  options.queue_depth = 4;
+  options.direct      = direct;
+  options.backend     = backend;
+
+  // not a multiple of the block size so that an `O_DIRECT` transfer has a buffered tail
+  //
+  auto const count = std::size_t{25'000};
+
+  auto src = sleip::dynamic_array<std::uint32_t, sleip::page_aligned_allocator<std::uint32_t>>(
+    count, sleip::noinit);
+  std::iota(src.begin(), src.end(), 0u);
+
+  auto const w = sleip::write_file(tmp.path, src, options);
+  BOOST_TEST_EQ(w.bytes, count * sizeof(std::uint32_t));
+  BOOST_TEST_EQ(file_size(tmp.path), count * sizeof(std::uint32_t));
+  if (backend != sleip::file_io_backend::automatic) { BOOST_TEST(w.backend == backend); }
+  if (!direct) { BOOST_TEST(!w.direct); }
+
+  auto dst = sleip::dynamic_array<std::uint32_t, sleip::page_aligned_allocator<std::uint32_t>>(
+    count, sleip::noinit);
+
+  auto const r = sleip::read_file(tmp.path, dst, options);
+  BOOST_TEST_EQ(r.bytes, count * sizeof(std::uint32_t));
+  BOOST_TEST_ALL_EQ(dst.begin(), dst.end(), src.begin(), src.end());
+  if (!direct) { BOOST_TEST(!r.direct); }
+}
+
+void
+test_round_trip()
+{
+  auto backends = std::vector<sleip::file_io_backend>{sleip::file_io_backend::automatic,
+                                                      sleip::file_io_backend::thread_pool};
+
+  // io_uring may be compiled out or disabled by the kernel in which case forcing it must fail
+  //
+#ifdef SLEIP_HAS_IO_URING
+  if (sleip::detail::io_ring(1)) { backends.push_back(sleip::file_io_backend::io_uring); }
+#endif
+
+  for (auto const& dir : test_dirs()) {
+    for (auto const backend : backends) {
+      test_round_trip(dir, backend, false);
+      test_round_trip(dir, backend, true);
+    }
+  }
+}
+
+void
+test_short_file()
+{
+  auto const tmp = temp_file("sleip_file_io_short.dat");
+
+  auto src = sleip::dynamic_array<std::uint8_t>(10'000, std::uint8_t{7});
+  sleip::write_file(tmp.path, src);
+
+  auto options        = sleip::file_io_options();
+  options.chunk_size  = 4096;
+  options.queue_depth = 2;
+
+  for (auto const backend :
+       {sleip::file_io_backend::automatic, sleip::file_io_backend::thread_pool}) {
+    options.backend = backend;
+
+    auto dst = sleip::dynamic_array<std::uint8_t>(20'000, std::uint8_t{0});
+
+    auto const r = sleip::read_file(tmp.path, dst, options);
+    BOOST_TEST_EQ(r.bytes, 10'000);
+    BOOST_TEST_EQ(dst[9'999], 7);
+    BOOST_TEST_EQ(dst[10'000], 0);
+  }
+}
+
+void
+test_whole_file()
+{
+  auto const tmp = temp_file("sleip_file_io_whole.dat");
+
+  using alloc_type = boost::container::pmr::polymorphic_allocator<std::uint16_t>;
+
+  auto mem = boost::container::pmr::monotonic_buffer_resource();
+
+  using pair_type = std::uint16_t[2];
+
+  auto src =
+    sleip::dynamic_array<pair_type, sleip::cache_aligned_allocator<pair_type>>(3'000, {1, 2});
+  sleip::write_file(tmp.path, src);
+
+  // one trailing byte that doesn't make up a full element
+  //
+  {
+    auto file = std::ofstream(tmp.path, std::ios::out | std::ios::binary | std::ios::app);
+    file.put('x');
+  }
+
+  auto const a = sleip::read_file<std::uint16_t>(tmp.path, sleip::file_io_options(),
+                                                 alloc_type(&mem));
+  BOOST_TEST_EQ(a.size(), 6'000);
+  BOOST_TEST_EQ(a[0], 1);
+  BOOST_TEST_EQ(a[5'999], 2);
+
+  auto const b = sleip::read_file<std::byte>(tmp.path);
+  BOOST_TEST_EQ(b.size(), 12'001);
+  BOOST_TEST(b[12'000] == std::byte{'x'});
+}
+
+void
+test_empty()
+{
+  auto const tmp = temp_file("sleip_file_io_empty.dat");
+
+  auto const a = sleip::dynamic_array<int>();
+  BOOST_TEST_EQ(sleip::write_file(tmp.path, a).bytes, 0);
+  BOOST_TEST_EQ(file_size(tmp.path), 0);
+
+  BOOST_TEST(sleip::read_file<int>(tmp.path).empty());
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+void
+test_throwing()
+{
+  auto a = sleip::dynamic_array<int>(16);
+  BOOST_TEST_THROWS(sleip::read_file("sleip_this_file_does_not_exist.dat", a), std::system_error);
+  BOOST_TEST_THROWS(sleip::read_file<int>("sleip_this_file_does_not_exist.dat"), std::system_error);
+  BOOST_TEST_THROWS(sleip::write_file("sleip_this_dir_does_not_exist/file.dat", a),
+                    std::system_error);
+}
+
+#endif
+
+int
+main()
+{
+  test_round_trip();
+  test_short_file();
+  test_whole_file();
+  test_empty();
+  test_throwing();
+
+  return boost::report_errors();
+}
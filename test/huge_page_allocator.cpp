@@ -0,0 +1,109 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/huge_page_allocator.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+template <class T>
+using huge_array = sleip::dynamic_array<T, sleip::huge_page_allocator<T>>;
+
+void
+test_below_threshold()
+{
+  auto a = huge_array<int>(16, 1);
+
+  BOOST_TEST_EQ(a.size(), 16);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1; }));
+  BOOST_TEST(sleip::huge_page_backing_of(a.data()) == sleip::huge_page_backing::normal);
+}
+
+void
+test_above_threshold()
+{
+  auto const count = 3 * (std::size_t{2} << 20) / sizeof(std::uint64_t) + 7;
+
+  auto a = huge_array<std::uint64_t>(count, 1);
+
+  BOOST_TEST_EQ(a.size(), count);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % (std::size_t{2} << 20), 0);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](std::uint64_t x) { return x == 1; }));
+
+  // whether the kernel hands out huge pages depends on its configuration, we can only check that
+  // the answer is coherent
+  //
+  auto const backing = sleip::huge_page_backing_of(a.data());
+  BOOST_TEST(backing == sleip::huge_page_backing::normal ||
+             backing == sleip::huge_page_backing::transparent);
+
+  auto b = a;
+  BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+}
+
+void
+test_hugetlb_fallback()
+{
+  // most machines don't reserve a hugetlbfs pool so this usually exercises the fallback
+  //
+  auto options        = sleip::huge_page_options();
+  options.use_hugetlb = true;
+
+  auto const count = (std::size_t{4} << 20) / sizeof(int);
+
+  auto a = huge_array<int>(count, 7, sleip::huge_page_allocator<int>(options));
+
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 7; }));
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % (std::size_t{2} << 20), 0);
+}
+
+void
+test_equality()
+{
+  auto options      = sleip::huge_page_options();
+  options.threshold = 4096;
+
+  auto a = sleip::huge_page_allocator<int>();
+  auto b = sleip::huge_page_allocator<int>(options);
+
+  BOOST_TEST(a == sleip::huge_page_allocator<float>());
+  BOOST_TEST(a != b);
+
+  auto x = huge_array<int>(8192, 1, a);
+  auto y = huge_array<int>(8192, 2, b);
+
+  x = std::move(y);
+
+  BOOST_TEST(x.get_allocator() == b);
+  BOOST_TEST(std::all_of(x.begin(), x.end(), [](int v) { return v == 2; }));
+}
+
+void
+test_huge_page_resource()
+{
+#ifndef SLEIP_NO_CXX17_PMR
+  auto resource = sleip::huge_page_resource();
+
+  auto const count = (std::size_t{2} << 20) / sizeof(int);
+
+  auto a = sleip::pmr::dynamic_array<int>(count, 1, &resource);
+  auto b = sleip::pmr::dynamic_array<int>(4, 1, &resource);
+
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % (std::size_t{2} << 20), 0);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1; }));
+  BOOST_TEST(std::all_of(b.begin(), b.end(), [](int x) { return x == 1; }));
+#endif
+}
+
+int
+main()
+{
+  test_below_threshold();
+  test_above_threshold();
+  test_hugetlb_fallback();
+  test_equality();
+  test_huge_page_resource();
+
+  return boost::report_errors();
+}
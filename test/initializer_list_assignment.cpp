@@ -30,6 +30,19 @@ test_initializer_list_assignment()
 
     BOOST_TEST_EQ(a.size(), 1);
   }
+
+  // same size reuses the existing storage
+  {
+    auto a    = sleip::dynamic_array<int>{4, 5, 6};
+    auto list = std::initializer_list<int>{1, 2, 3};
+
+    auto const* const old_data = a.data();
+
+    a = list;
+
+    BOOST_TEST_EQ(a.data(), old_data);
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), list.begin(), list.end());
+  }
 }
 
 int
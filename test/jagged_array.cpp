@@ -0,0 +1,300 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/jagged_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef SLEIP_NO_CXX17_PMR
+#include <memory_resource>
+#endif
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+static_assert(std::is_nothrow_move_constructible_v<sleip::jagged_array<int>>);
+static_assert(std::is_same_v<sleip::jagged_array<int>::row_type, sleip::column_span<int>>);
+
+// a range of integers is a list of row sizes, a range of ranges is a list of rows
+//
+static_assert(std::is_constructible_v<sleip::jagged_array<int>, std::vector<std::vector<int>>>);
+static_assert(!std::is_constructible_v<sleip::jagged_array<int>, std::vector<int>>);
+static_assert(
+  std::is_constructible_v<sleip::jagged_array<int>, std::vector<int>, sleip::noinit_t>);
+static_assert(
+  !std::is_constructible_v<sleip::jagged_array<std::string>, std::vector<std::string>>);
+
+void
+test_layout()
+{
+  auto a = sleip::jagged_array<int>({{1, 2, 3}, {}, {4}, {5, 6}});
+  BOOST_TEST_EQ(a.size(), 4);
+  BOOST_TEST_EQ(a.num_values(), 6);
+
+  auto const offsets = a.offsets();
+  BOOST_TEST_EQ(offsets.size(), 5);
+  BOOST_TEST_EQ(offsets[0], 0);
+  BOOST_TEST_EQ(offsets[2], 3);
+  BOOST_TEST_EQ(offsets[4], 6);
+
+  // the rows are contiguous with each other
+  //
+  BOOST_TEST_EQ(a[2].data(), a.data() + 3);
+  BOOST_TEST_EQ(a.row_size(0), 3);
+  BOOST_TEST(a[1].empty());
+  BOOST_TEST_EQ(a.values().size(), 6);
+  BOOST_TEST_EQ(a.values()[5], 6);
+  BOOST_TEST_EQ(a.back()[1], 6);
+  BOOST_TEST_EQ(a.front()[0], 1);
+
+  a[3][0] = 50;
+  BOOST_TEST_EQ(a.data()[4], 50);
+
+  auto b = sleip::jagged_array<int>();
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(b.data(), nullptr);
+  BOOST_TEST(b.offsets().empty());
+  BOOST_TEST(b.begin() == b.end());
+
+  // rows with nothing in them still have offsets
+  //
+  auto c = sleip::jagged_array<double>({{}, {}});
+  BOOST_TEST_EQ(c.size(), 2);
+  BOOST_TEST_EQ(c.num_values(), 0);
+  BOOST_TEST(c[1].empty());
+}
+
+void
+test_from_sizes()
+{
+  auto const sizes = std::vector<int>{2, 0, 3};
+
+  auto a = sleip::jagged_array<std::uint32_t>(sizes, sleip::noinit);
+  BOOST_TEST_EQ(a.size(), 3);
+  BOOST_TEST_EQ(a.num_values(), 5);
+  BOOST_TEST_EQ(a[2].size(), 3);
+
+  auto b = sleip::jagged_array<std::string>(std::array<std::size_t, 2>{1, 2}, std::string("s"));
+  BOOST_TEST_EQ(b[1][1], "s");
+
+  b.fill("t");
+  BOOST_TEST_EQ(b[0][0], "t");
+}
+
+void
+test_from_rows()
+{
+  // tokenized documents, rows of a non-trivial type from non-contiguous ranges
+  //
+  auto const docs = std::vector<std::list<std::string>>{{"a", "b"}, {"c"}, {}};
+
+  auto a = sleip::jagged_array<std::string>(docs);
+  BOOST_TEST_EQ(a.size(), 3);
+  BOOST_TEST_EQ(a[0][1], "b");
+  BOOST_TEST_EQ(a[1][0], "c");
+  BOOST_TEST(a[2].empty());
+
+  // strings are rows of characters
+  //
+  auto const words = std::vector<std::string>{"jagged", "", "array"};
+
+  auto b = sleip::jagged_array<char>(words);
+  BOOST_TEST_EQ(b.num_values(), 11);
+  BOOST_TEST_EQ(std::string(b[2].begin(), b[2].end()), "array");
+
+  // and a jagged array's own rows can rebuild it
+  //
+  auto const rows = std::vector<sleip::column_span<char const>>(b.cbegin(), b.cend());
+
+  auto c = sleip::jagged_array<char>(rows);
+  BOOST_TEST(c == b);
+}
+
+void
+test_rows()
+{
+  auto a = sleip::jagged_array<int>({{1, 2}, {3}, {4, 5, 6}});
+
+  auto sum = 0;
+  auto n   = 0;
+  for (auto row : a) {
+    sum = std::accumulate(row.begin(), row.end(), sum);
+    ++n;
+  }
+  BOOST_TEST_EQ(n, 3);
+  BOOST_TEST_EQ(sum, 21);
+
+  for (auto row : a) {
+    for (auto& x : row) { x *= 2; }
+  }
+  BOOST_TEST_EQ(a[2][2], 12);
+
+  auto const& c = a;
+
+  auto it = c.begin();
+  BOOST_TEST_EQ(c.end() - it, 3);
+  BOOST_TEST_EQ(it[1][0], 6);
+  it += 2;
+  BOOST_TEST_EQ((*it).size(), 3);
+  BOOST_TEST(it > c.begin());
+
+  sleip::jagged_array<int>::const_iterator cit = a.begin() + 1;
+  BOOST_TEST(cit == c.begin() + 1);
+}
+
+void
+test_copy_move()
+{
+  using jagged_type = sleip::jagged_array<std::string>;
+
+  auto a = jagged_type({{"a", "b"}, {"c"}});
+  auto b = a;
+  BOOST_TEST(a == b);
+  BOOST_TEST_NE(a.data(), b.data());
+
+  b[1][0] = "d";
+  BOOST_TEST(a != b);
+
+  // same shape copies in place
+  //
+  auto x = sleip::jagged_array<int>({{1}, {2, 3}});
+  auto y = sleip::jagged_array<int>({{4}, {5, 6}});
+
+  auto const* const old_data = y.data();
+
+  y = x;
+  BOOST_TEST(x == y);
+  BOOST_TEST_EQ(y.data(), old_data);
+
+  auto z = sleip::jagged_array<int>({{1, 2}, {3}});
+  BOOST_TEST(x != z);
+
+  y = z;
+  BOOST_TEST(y == z);
+
+  auto const* const moved_data = b.data();
+
+  auto c = std::move(b);
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(b.num_values(), 0);
+  BOOST_TEST_EQ(c.data(), moved_data);
+
+  a = std::move(c);
+  BOOST_TEST(c.empty());
+  BOOST_TEST_EQ(a[1][0], "d");
+
+  swap(a, c);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(c.size(), 2);
+}
+
+void
+test_non_equal_allocators()
+{
+#ifndef SLEIP_NO_CXX17_PMR
+  namespace pmr = std::pmr;
+
+  using alloc_type  = pmr::polymorphic_allocator<int>;
+  using jagged_type = sleip::jagged_array<int, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = alloc_type(&buff);
+  auto default_alloc = alloc_type();
+
+  auto a = jagged_type(buff_alloc);
+  auto b = jagged_type({{1, 2, 3}, {4}}, default_alloc);
+
+  auto const* const old_data = b.data();
+
+  a = std::move(b);
+  BOOST_TEST(a.get_allocator() == buff_alloc);
+  BOOST_TEST_NE(a.data(), old_data);
+  BOOST_TEST_EQ(a[0][2], 3);
+  BOOST_TEST(b.empty());
+
+  auto c = jagged_type(a, default_alloc);
+  BOOST_TEST(c == a);
+#endif
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+
+  throwing(int)
+  {
+    if (num_live == 3) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const&) = delete;
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  auto a = sleip::jagged_array<int>({{1}});
+  BOOST_TEST_THROWS(a.at(1), std::out_of_range);
+
+  // a later row fails part way through and the rows before it are unwound
+  //
+  throwing::num_live = 0;
+
+  auto const rows = std::vector<std::vector<int>>{{1, 2}, {3, 4}};
+  BOOST_TEST_THROWS((sleip::jagged_array<throwing>(rows)), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+
+  auto const huge = std::vector<std::size_t>{std::size_t(-1) / 2, std::size_t(-1) / 2};
+  BOOST_TEST_THROWS((sleip::jagged_array<int>(huge, sleip::noinit)), std::bad_array_new_length);
+}
+
+#endif
+
+int
+main()
+{
+  test_layout();
+  test_from_sizes();
+  test_from_rows();
+  test_rows();
+  test_copy_move();
+  test_non_equal_allocators();
+  test_throwing();
+
+  return boost::report_errors();
+}
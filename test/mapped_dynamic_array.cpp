@@ -0,0 +1,204 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/mapped_dynamic_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <system_error>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+// remove the file on construction and destruction
+//
+struct temp_file
+{
+  std::string path;
+
+  explicit temp_file(std::string path_)
+    : path{std::move(path_)}
+  {
+    std::remove(path.c_str());
+  }
+
+  ~temp_file() { std::remove(path.c_str()); }
+};
+
+template <class T, class Allocator>
+auto
+write_file(std::string const& path, sleip::dynamic_array<T, Allocator> const& a) -> void
+{
+  auto file = std::ofstream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<char const*>(a.data()),
+             static_cast<std::streamsize>(a.size() * sizeof(T)));
+}
+
+void
+test_read_only()
+{
+  auto const tmp = temp_file("sleip_mapped_read_only.dat");
+
+  auto nums = sleip::dynamic_array<std::uint32_t>(4096, sleip::noinit);
+  std::iota(nums.begin(), nums.end(), 0u);
+  write_file(tmp.path, nums);
+
+  auto options     = sleip::map_options();
+  options.populate = true;
+  options.advice   = sleip::map_advice::sequential;
+
+  auto const a = sleip::mapped_dynamic_array<std::uint32_t>(tmp.path, options);
+
+  BOOST_TEST(a.mode() == sleip::map_mode::read_only);
+  BOOST_TEST_EQ(a.size(), nums.size());
+  BOOST_TEST_ALL_EQ(a.begin(), a.end(), nums.begin(), nums.end());
+  BOOST_TEST_EQ(a.front(), 0u);
+  BOOST_TEST_EQ(a.back(), 4095u);
+  BOOST_TEST_EQ(a[17], 17u);
+  BOOST_TEST_EQ(a.at(42), 42u);
+
+  auto const b = sleip::mapped_dynamic_array<std::uint32_t>(tmp.path);
+  BOOST_TEST((a == b));
+  BOOST_TEST(!(a < b));
+}
+
+void
+test_comparison()
+{
+  auto const short_tmp = temp_file("sleip_mapped_comparison_short.dat");
+  auto const long_tmp  = temp_file("sleip_mapped_comparison_long.dat");
+
+  auto nums = sleip::dynamic_array<std::uint16_t[2]>(512, {7, 7});
+  write_file(long_tmp.path, nums);
+
+  nums.reallocate(511);
+  write_file(short_tmp.path, nums);
+
+  auto const a = sleip::mapped_dynamic_array<std::uint16_t[2]>(short_tmp.path);
+  auto const b = sleip::mapped_dynamic_array<std::uint16_t[2]>(long_tmp.path);
+
+  // equal leading elements, so the shorter array orders first
+  //
+  BOOST_TEST((a != b));
+  BOOST_TEST((a < b));
+  BOOST_TEST((b >= a));
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+  BOOST_TEST((a <=> b) < 0);
+#endif
+}
+
+void
+test_copy_on_write()
+{
+  auto const tmp = temp_file("sleip_mapped_copy_on_write.dat");
+
+  auto nums = sleip::dynamic_array<std::uint8_t[3]>(64, {1, 2, 3});
+  write_file(tmp.path, nums);
+
+  auto options = sleip::map_options();
+  options.mode = sleip::map_mode::copy_on_write;
+
+  {
+    auto a = sleip::mapped_dynamic_array<std::uint8_t[3]>(tmp.path, options);
+    BOOST_TEST_EQ(a.size(), 64);
+
+    a[0][0] = 42;
+    BOOST_TEST_EQ(a[0][0], 42);
+  }
+
+  auto const a = sleip::mapped_dynamic_array<std::uint8_t[3]>(tmp.path);
+  BOOST_TEST_EQ(a[0][0], 1);
+}
+
+void
+test_read_write()
+{
+  auto const tmp = temp_file("sleip_mapped_read_write.dat");
+
+  {
+    auto a = sleip::mapped_dynamic_array<double>(tmp.path, 1000);
+
+    BOOST_TEST(a.mode() == sleip::map_mode::read_write);
+    BOOST_TEST_EQ(a.size(), 1000);
+
+    std::iota(a.begin(), a.end(), 0.0);
+    a.sync();
+  }
+
+  auto const a = sleip::mapped_dynamic_array<double>(tmp.path);
+  BOOST_TEST_EQ(a.size(), 1000);
+  BOOST_TEST_EQ(a[999], 999.0);
+}
+
+void
+test_empty_and_move()
+{
+  auto const tmp = temp_file("sleip_mapped_empty.dat");
+  std::ofstream(tmp.path).close();
+
+  auto a = sleip::mapped_dynamic_array<int>(tmp.path);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.data(), nullptr);
+
+  auto b = sleip::mapped_dynamic_array<int>(tmp.path, 16);
+  auto c = std::move(b);
+
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(c.size(), 16);
+
+  a = std::move(c);
+  BOOST_TEST_EQ(a.size(), 16);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+void
+test_throwing()
+{
+  BOOST_TEST_THROWS(sleip::mapped_dynamic_array<int>("sleip_this_file_does_not_exist.dat"),
+                    std::system_error);
+
+  auto const tmp = temp_file("sleip_mapped_throwing.dat");
+
+  auto const a = sleip::mapped_dynamic_array<int>(tmp.path, 4);
+  BOOST_TEST_THROWS(a.at(4), std::out_of_range);
+}
+
+#endif
+
+int
+main()
+{
+  test_read_only();
+  test_comparison();
+  test_copy_on_write();
+  test_read_write();
+  test_empty_and_move();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -9,9 +9,41 @@
 #include <vector>
 #include <array>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace pmr = boost::container::pmr;
 
+struct relocatable
+{
+  static inline int num_dtors = 0;
+
+  int x = 0;
+
+  relocatable() = default;
+  relocatable(int x_)
+    : x{x_}
+  {
+  }
+
+  relocatable(relocatable const& other)
+    : x{other.x}
+  {
+  }
+
+  relocatable(relocatable&& other) noexcept
+    : x{std::exchange(other.x, 0)}
+  {
+  }
+
+  ~relocatable() { ++num_dtors; }
+};
+
+template <>
+struct sleip::is_trivially_relocatable<relocatable> : std::true_type
+{
+};
+
 void
 test_move_assignment_equal_allocators()
 {
@@ -80,9 +112,13 @@ test_move_assignment_non_equal_allocator()
     a = std::move(b);
 
     BOOST_TEST_EQ(a.size(), 2 * size);
+    BOOST_TEST_NE(a.data(), old_data);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1; }));
 
-    BOOST_TEST_EQ(b.data(), old_data);
-    BOOST_TEST_EQ(b.size(), 2 * size);
+    // `int` is trivially relocatable so `b`'s buffer is handed back to its allocator
+    //
+    BOOST_TEST_EQ(b.data(), nullptr);
+    BOOST_TEST_EQ(b.size(), 0);
   }
 
   // non-empty
@@ -115,10 +151,99 @@ test_move_assignment_non_equal_allocator()
   }
 }
 
+void
+test_move_assignment_relocation()
+{
+  static_assert(sleip::is_trivially_relocatable_v<int>);
+  static_assert(sleip::is_trivially_relocatable_v<int[4]>);
+  static_assert(sleip::is_trivially_relocatable_v<relocatable[4]>);
+  static_assert(!sleip::is_trivially_relocatable_v<std::vector<int>>);
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = pmr::polymorphic_allocator<relocatable>(&buff);
+  auto default_alloc = pmr::polymorphic_allocator<relocatable>();
+
+  auto const size = std::size_t{16};
+
+  auto a = sleip::dynamic_array<relocatable, pmr::polymorphic_allocator<relocatable>>(
+    size / 2, relocatable(1), buff_alloc);
+
+  auto b = sleip::dynamic_array<relocatable, pmr::polymorphic_allocator<relocatable>>(
+    size, relocatable(2), default_alloc);
+
+  relocatable::num_dtors = 0;
+
+  a = std::move(b);
+
+  // only `a`'s old elements are destroyed, `b`'s are relocated
+  //
+  BOOST_TEST_EQ(relocatable::num_dtors, size / 2);
+
+  BOOST_TEST(a.get_allocator() == buff_alloc);
+  BOOST_TEST_EQ(a.size(), size);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& r) { return r.x == 2; }));
+
+  BOOST_TEST_EQ(b.size(), 0);
+  BOOST_TEST_EQ(b.data(), nullptr);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_move_assignment_non_equal_allocator_throwing()
+{
+}
+
+#else
+
+void
+test_move_assignment_non_equal_allocator_throwing()
+{
+  struct throwing
+  {
+    int x = 0;
+
+    throwing() = default;
+    throwing(throwing const& other)
+      : x{other.x}
+    {
+      if (x == -1) { throw 42; }
+    }
+
+    throwing(throwing&&) = delete;
+  };
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = pmr::polymorphic_allocator<throwing>(&buff);
+  auto default_alloc = pmr::polymorphic_allocator<throwing>();
+
+  auto a = sleip::dynamic_array<throwing, pmr::polymorphic_allocator<throwing>>(8, buff_alloc);
+  auto b = sleip::dynamic_array<throwing, pmr::polymorphic_allocator<throwing>>(16, default_alloc);
+
+  for (auto& t : a) { t.x = 1; }
+  for (auto& t : b) { t.x = -1; }
+
+  auto const* const old_data = a.data();
+
+  BOOST_TEST_THROWS((a = std::move(b)), int);
+
+  BOOST_TEST_EQ(a.data(), old_data);
+  BOOST_TEST_EQ(a.size(), 8);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& t) { return t.x == 1; }));
+}
+
+#endif
+
 int
 main()
 {
   test_move_assignment_equal_allocators();
   test_move_assignment_non_equal_allocator();
+  test_move_assignment_relocation();
+  test_move_assignment_non_equal_allocator_throwing();
   return boost::report_errors();
 }
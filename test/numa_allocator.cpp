@@ -0,0 +1,95 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/execution.hpp>
+#include <sleip/numa_allocator.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+constexpr std::size_t const count = std::size_t{1} << 18;
+
+void
+test_num_nodes()
+{
+  BOOST_TEST_GE(sleip::numa_num_nodes(), 1);
+}
+
+void
+test_policies()
+{
+  auto const num_nodes = sleip::numa_num_nodes();
+
+  for (auto const policy : {sleip::numa_policy::local(), sleip::numa_policy::bind(0),
+                            sleip::numa_policy::bind(num_nodes - 1),
+                            sleip::numa_policy::interleave()}) {
+    auto alloc = sleip::numa_allocator<int>(policy);
+
+    auto a = sleip::dynamic_array<int, sleip::numa_allocator<int>>(count, 7, alloc);
+
+    BOOST_TEST_EQ(a.size(), count);
+    BOOST_TEST(a.get_allocator().policy == policy);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 7; }));
+
+    // the kernel may not tell us, e.g. when the syscall is filtered, but if it does the node must
+    // be one we're allowed to use
+    //
+    auto const node = sleip::numa_node_of(a.data());
+    BOOST_TEST(node == -1 || (node >= 0 && node < 64));
+
+    if (policy.k == sleip::numa_policy::kind::bind && num_nodes > 1 && node != -1) {
+      BOOST_TEST_EQ(node, policy.node);
+    }
+  }
+}
+
+void
+test_first_touch()
+{
+  auto alloc = sleip::numa_allocator<double>(sleip::numa_policy::local());
+
+  auto a = sleip::dynamic_array<double, sleip::numa_allocator<double>>(
+    sleip::parallel_policy{4}, count, 1.0, alloc);
+
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](double x) { return x == 1.0; }));
+
+  auto b = sleip::dynamic_array<double, sleip::numa_allocator<double>>(
+    a, sleip::numa_policy::interleave());
+
+  BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+
+  // allocators compare equal regardless of their policy so moves are always constant-time
+  //
+  auto const* const old_data = b.data();
+
+  a = std::move(b);
+  BOOST_TEST_EQ(a.data(), old_data);
+}
+
+void
+test_numa_resource()
+{
+#ifndef SLEIP_NO_CXX17_PMR
+  auto resource = sleip::numa_resource(sleip::numa_policy::interleave());
+
+  auto a = sleip::pmr::dynamic_array<int>(count, 1, &resource);
+  auto b = sleip::pmr::dynamic_array<int>(count, 1);
+
+  BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+
+  auto other = sleip::numa_resource(sleip::numa_policy::local());
+  BOOST_TEST(resource.is_equal(other));
+  BOOST_TEST(!resource.is_equal(*std::pmr::new_delete_resource()));
+#endif
+}
+
+int
+main()
+{
+  test_num_nodes();
+  test_policies();
+  test_first_touch();
+  test_numa_resource();
+
+  return boost::report_errors();
+}
@@ -3,6 +3,9 @@
 #include <boost/core/lightweight_test.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <utility>
 #include <type_traits>
@@ -26,6 +29,62 @@ test_fill()
   BOOST_TEST_ALL_EQ(a.begin(), a.end(), expected.begin(), expected.end());
 }
 
+using rgb = std::uint8_t[3];
+
+auto
+all_rgb(sleip::dynamic_array<rgb> const& a, rgb const& value) -> bool
+{
+  return std::all_of(a.begin(), a.end(), [&](auto const& px) {
+    return px[0] == value[0] && px[1] == value[1] && px[2] == value[2];
+  });
+}
+
+void
+test_fill_patterns()
+{
+  rgb const value = {1, 2, 3};
+
+  // a pattern that doesn't divide the block sizes, broadcast over sizes around them
+  //
+  for (auto const size : {0, 1, 2, 5, 5461, 5462, 100000}) {
+    auto a = sleip::dynamic_array<rgb>(size, {9, 9, 9});
+    a.fill(value);
+    BOOST_TEST(all_rgb(a, value));
+  }
+
+  // large enough for streaming stores, whatever the alignment of the first element
+  //
+  auto big = sleip::dynamic_array<rgb>(sleip::detail::streaming_fill_bytes / 3 + 1000);
+  big.fill(value);
+  BOOST_TEST(all_rgb(big, value));
+
+  auto ints = sleip::dynamic_array<std::uint32_t>(sleip::detail::streaming_fill_bytes / 4 + 3);
+  ints.fill(7);
+  BOOST_TEST(std::all_of(ints.begin(), ints.end(), [](std::uint32_t x) { return x == 7; }));
+
+  // the value can come from the array itself
+  //
+  auto b = sleip::dynamic_array<rgb>(100);
+  b[50][1] = 42;
+  b.fill(b[50]);
+  BOOST_TEST_EQ(b[0][1], 42);
+  BOOST_TEST_EQ(b[99][1], 42);
+  BOOST_TEST_EQ(b[99][2], 0);
+
+  struct point
+  {
+    float x, y, z;
+  };
+
+  auto c = sleip::dynamic_array<point>(777);
+  c.fill({1.f, 2.f, 3.f});
+  BOOST_TEST(std::all_of(c.begin(), c.end(), [](point p) { return p.z == 3.f; }));
+
+  auto s = sleip::dynamic_array<std::string[2]>(3);
+  s.fill({"a", "b"});
+  BOOST_TEST_EQ(s[2][1], "b");
+}
+
 void
 test_swap()
 {
@@ -86,6 +145,7 @@ int
 main()
 {
   test_fill();
+  test_fill_patterns();
   test_swap();
   test_member_swap();
 
@@ -0,0 +1,166 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/new_array_allocator.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+// `std::allocator` storage can't be freed with `delete[]` so it can't adopt a `unique_ptr<T[]>`
+//
+static_assert(!std::is_constructible_v<sleip::dynamic_array<int>, std::unique_ptr<int[]>,
+                                       std::size_t>);
+static_assert(std::is_nothrow_constructible_v<
+              sleip::dynamic_array<int, sleip::new_array_allocator<int>>, std::unique_ptr<int[]>,
+              std::size_t>);
+
+// hands buffers to and takes them back from a C library that frees them with `free`
+//
+template <class T>
+struct malloc_allocator
+{
+  using value_type = T;
+
+  malloc_allocator() = default;
+
+  template <class U>
+  malloc_allocator(malloc_allocator<U> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    auto* p = std::malloc(n == 0 ? 1 : n * sizeof(T));
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return static_cast<T*>(p);
+  }
+
+  auto
+  deallocate(T* p, std::size_t) noexcept -> void
+  {
+    std::free(p);
+  }
+
+  template <class U>
+  auto
+  operator==(malloc_allocator<U> const&) const noexcept -> bool
+  {
+    return true;
+  }
+
+  template <class U>
+  auto
+  operator!=(malloc_allocator<U> const&) const noexcept -> bool
+  {
+    return false;
+  }
+};
+
+auto
+c_library_fill(int* p, std::size_t n) -> void
+{
+  std::iota(p, p + n, 0);
+}
+
+void
+test_release_adopt()
+{
+  auto a = sleip::dynamic_array<std::string>{"release", "and", "adopt"};
+
+  auto const* const old_data = a.data();
+
+  auto [data, size, alloc] = a.release();
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.data(), nullptr);
+  BOOST_TEST_EQ(data, old_data);
+  BOOST_TEST_EQ(size, 3);
+
+  auto b = sleip::dynamic_array<std::string>(sleip::adopt, data, size, alloc);
+  BOOST_TEST_EQ(b.data(), old_data);
+  BOOST_TEST_EQ(b[2], "adopt");
+
+  // an empty array releases nothing
+  //
+  auto const r = sleip::dynamic_array<int>().release();
+  BOOST_TEST_EQ(r.data, nullptr);
+  BOOST_TEST_EQ(r.size, 0);
+
+  auto c = sleip::dynamic_array<int>(sleip::adopt, nullptr, 0);
+  BOOST_TEST(c.empty());
+}
+
+void
+test_c_interop()
+{
+  using array_type = sleip::dynamic_array<int, malloc_allocator<int>>;
+
+  auto* const p = static_cast<int*>(std::malloc(16 * sizeof(int)));
+  c_library_fill(p, 16);
+
+  auto a = array_type(sleip::adopt, p, 16);
+  BOOST_TEST_EQ(a.data(), p);
+  BOOST_TEST_EQ(a[15], 15);
+
+  auto const r = a.release();
+  BOOST_TEST_EQ(r.data, p);
+  std::free(r.data);
+}
+
+void
+test_unique_ptr()
+{
+  using rgb        = std::uint8_t[3];
+  using array_type = sleip::dynamic_array<rgb, sleip::new_array_allocator<rgb>>;
+
+  auto ptr = std::unique_ptr<rgb[]>(new rgb[4]());
+  ptr[3][2] = 7;
+
+  auto const* const old_data = ptr.get();
+
+  auto a = array_type(std::move(ptr), 4);
+  BOOST_TEST(!ptr);
+  BOOST_TEST_EQ(a.data(), old_data);
+  BOOST_TEST_EQ(a[3][2], 7);
+
+  auto b = sleip::dynamic_array<int, sleip::new_array_allocator<int>>(5, 1);
+  auto c = std::unique_ptr<int[]>(b.release().data);
+  BOOST_TEST_EQ(c[4], 1);
+
+  auto d = sleip::dynamic_array<int, sleip::new_array_allocator<int>>(std::move(c), 5);
+  BOOST_TEST_EQ(d.size(), 5);
+
+  auto e = d;
+  BOOST_TEST(e == d);
+}
+
+int
+main()
+{
+  test_release_adopt();
+  test_c_interop();
+  test_unique_ptr();
+
+  return boost::report_errors();
+}
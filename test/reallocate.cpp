@@ -0,0 +1,309 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/huge_page_allocator.hpp>
+#include <sleip/zero_page_allocator.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <string>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+// resizes with `std::realloc` and counts how often it was asked to, it refuses to shrink so the
+// fallback gets exercised too
+//
+template <class T>
+struct realloc_allocator
+{
+  using value_type = T;
+
+  int* num_reallocs;
+
+  realloc_allocator(int* num_reallocs_) noexcept
+    : num_reallocs{num_reallocs_}
+  {
+  }
+
+  template <class U>
+  realloc_allocator(realloc_allocator<U> const& other) noexcept
+    : num_reallocs{other.num_reallocs}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    auto* p = std::malloc(n == 0 ? 1 : n * sizeof(T));
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return static_cast<T*>(p);
+  }
+
+  auto
+  reallocate(T* p, std::size_t old_n, std::size_t new_n) noexcept -> T*
+  {
+    if (new_n < old_n) { return nullptr; }
+
+    ++*num_reallocs;
+    return static_cast<T*>(std::realloc(p, new_n * sizeof(T)));
+  }
+
+  auto
+  deallocate(T* p, std::size_t) noexcept -> void
+  {
+    std::free(p);
+  }
+
+  template <class U>
+  auto
+  operator==(realloc_allocator<U> const& other) const noexcept -> bool
+  {
+    return num_reallocs == other.num_reallocs;
+  }
+
+  template <class U>
+  auto
+  operator!=(realloc_allocator<U> const& other) const noexcept -> bool
+  {
+    return !(*this == other);
+  }
+};
+
+void
+test_grow_shrink()
+{
+  auto a = sleip::dynamic_array<int>{1, 2, 3};
+
+  a.reallocate(5);
+  BOOST_TEST_EQ(a.size(), 5);
+  BOOST_TEST_EQ(a[2], 3);
+  BOOST_TEST_EQ(a[3], 0);
+  BOOST_TEST_EQ(a[4], 0);
+
+  a.reallocate(2);
+  BOOST_TEST_EQ(a.size(), 2);
+  BOOST_TEST_EQ(a.back(), 2);
+
+  a.reallocate(4, sleip::noinit);
+  BOOST_TEST_EQ(a.size(), 4);
+  BOOST_TEST_EQ(a[1], 2);
+
+  a.reallocate(0);
+  BOOST_TEST(a.empty());
+
+  auto b = sleip::dynamic_array<std::uint8_t[3]>();
+  b.reallocate(2);
+  BOOST_TEST_EQ(b.size(), 2);
+  BOOST_TEST_EQ(b[1][2], 0);
+
+  auto const* const old_data = b.data();
+
+  b.reallocate(2);
+  BOOST_TEST_EQ(b.data(), old_data);
+}
+
+void
+test_non_relocatable()
+{
+  auto a = sleip::dynamic_array<std::string>{"grow", "this", "table"};
+
+  a.reallocate(4);
+  BOOST_TEST_EQ(a[0], "grow");
+  BOOST_TEST_EQ(a[2], "table");
+  BOOST_TEST(a[3].empty());
+
+  a.reallocate(1);
+  BOOST_TEST_EQ(a.size(), 1);
+  BOOST_TEST_EQ(a[0], "grow");
+}
+
+void
+test_allocator_reallocate()
+{
+  auto num_reallocs = 0;
+
+  using alloc_type = realloc_allocator<int>;
+
+  auto a = sleip::dynamic_array<int, alloc_type>(100, alloc_type(&num_reallocs));
+  std::iota(a.begin(), a.end(), 0);
+
+  a.reallocate(1000);
+  BOOST_TEST_EQ(num_reallocs, 1);
+  BOOST_TEST_EQ(a[99], 99);
+  BOOST_TEST_EQ(a[999], 0);
+
+  a.reallocate(1200, sleip::noinit);
+  BOOST_TEST_EQ(num_reallocs, 2);
+  BOOST_TEST_EQ(a[500], 0);
+
+  // the allocator declines and the elements are relocated instead
+  //
+  a.reallocate(50);
+  BOOST_TEST_EQ(num_reallocs, 2);
+  BOOST_TEST_EQ(a.size(), 50);
+  BOOST_TEST_EQ(a[49], 49);
+
+  // non-trivial elements never go through the allocator's `reallocate`
+  //
+  using string_alloc = realloc_allocator<std::string>;
+
+  auto s = sleip::dynamic_array<std::string, string_alloc>(3, "s", string_alloc(&num_reallocs));
+  s.reallocate(10);
+  BOOST_TEST_EQ(num_reallocs, 2);
+  BOOST_TEST_EQ(s[2], "s");
+}
+
+void
+test_zero_page()
+{
+  using alloc_type = sleip::zero_page_allocator<std::uint64_t>;
+
+  auto const count = alloc_type::mmap_threshold / sizeof(std::uint64_t) * 4;
+
+  auto a = sleip::dynamic_array<std::uint64_t, alloc_type>(count);
+  std::iota(a.begin(), a.end(), std::uint64_t{1});
+
+  a.reallocate(count * 2);
+  BOOST_TEST_EQ(a[count - 1], count);
+  BOOST_TEST(std::all_of(a.begin() + count, a.end(), [](std::uint64_t x) { return x == 0; }));
+
+  // the part of the last page dropped by a shrink comes back zeroed
+  //
+  a.reallocate(count + 3);
+  BOOST_TEST_EQ(a[count + 2], 0);
+
+  a.reallocate(count * 3, sleip::noinit);
+  BOOST_TEST_EQ(a[count], 0);
+  BOOST_TEST_EQ(a[count + 3], 0);
+  BOOST_TEST_EQ(a[count * 3 - 1], 0);
+  BOOST_TEST_EQ(a[0], 1);
+
+  // below the threshold the block came from `calloc` and is copied
+  //
+  a.reallocate(3);
+  BOOST_TEST_EQ(a[2], 3);
+
+  a.reallocate(count);
+  BOOST_TEST_EQ(a[2], 3);
+  BOOST_TEST_EQ(a[3], 0);
+}
+
+void
+test_huge_page()
+{
+  using alloc_type = sleip::huge_page_allocator<std::uint32_t>;
+
+  auto options      = sleip::huge_page_options();
+  options.threshold = std::size_t{1} << 20;
+
+  auto const count = (std::size_t{3} << 20) / sizeof(std::uint32_t);
+
+  auto a = sleip::dynamic_array<std::uint32_t, alloc_type>(count, alloc_type(options));
+  std::iota(a.begin(), a.end(), std::uint32_t{0});
+
+  a.reallocate(count * 4);
+  BOOST_TEST_EQ(a[count - 1], count - 1);
+  BOOST_TEST_EQ(a[count], 0);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % (std::size_t{2} << 20), 0);
+
+  a.reallocate(count / 2);
+  BOOST_TEST_EQ(a.back(), count / 2 - 1);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+  static inline int limit    = 100;
+
+  int value = 0;
+
+  throwing()
+  {
+    if (num_live == limit) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const& other)
+    : throwing()
+  {
+    value = other.value;
+  }
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  throwing::num_live = 0;
+  throwing::limit    = 100;
+
+  {
+    auto a = sleip::dynamic_array<throwing>(4);
+    a[3].value = 7;
+
+    // constructing the new elements fails
+    //
+    throwing::limit = 6;
+    BOOST_TEST_THROWS(a.reallocate(8), int);
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a[3].value, 7);
+    BOOST_TEST_EQ(throwing::num_live, 4);
+
+    // copying the old elements fails after the new ones were built
+    //
+    throwing::limit = 9;
+    BOOST_TEST_THROWS(a.reallocate(8), int);
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a[3].value, 7);
+    BOOST_TEST_EQ(throwing::num_live, 4);
+
+    throwing::limit = 100;
+    a.reallocate(8);
+    BOOST_TEST_EQ(a[3].value, 7);
+    BOOST_TEST_EQ(throwing::num_live, 8);
+  }
+  BOOST_TEST_EQ(throwing::num_live, 0);
+}
+
+#endif
+
+int
+main()
+{
+  test_grow_shrink();
+  test_non_relocatable();
+  test_allocator_reallocate();
+  test_zero_page();
+  test_huge_page();
+  test_throwing();
+
+  return boost::report_errors();
+}
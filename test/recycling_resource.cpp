@@ -0,0 +1,168 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/recycling_resource.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+static_assert(!std::allocator_traits<sleip::recycling_allocator<float>>::is_always_equal::value);
+
+void
+test_buckets()
+{
+  auto r = sleip::recycling_resource();
+
+  auto* p = r.allocate(1000);
+  auto* q = r.allocate(2000);
+  BOOST_TEST_EQ(r.stats().misses, 2);
+  BOOST_TEST_EQ(r.stats().hits, 0);
+
+  r.deallocate(p, 1000);
+  r.deallocate(q, 2000);
+  BOOST_TEST_EQ(r.stats().recycled, 2);
+  BOOST_TEST_EQ(r.stats().cached_bytes, 3000);
+
+  // exact sizes only, and the most recently freed block comes back first
+  //
+  auto* s = r.allocate(1500);
+  BOOST_TEST_EQ(r.stats().misses, 3);
+
+  BOOST_TEST_EQ(r.allocate(2000), q);
+  BOOST_TEST_EQ(r.allocate(1000), p);
+  BOOST_TEST_EQ(r.stats().hits, 2);
+  BOOST_TEST_EQ(r.stats().cached_bytes, 0);
+
+  // alignment is part of the key
+  //
+  r.deallocate(p, 1000);
+  auto* a = r.allocate(1000, 64);
+  BOOST_TEST(a != p);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a) % 64, 0);
+  r.deallocate(a, 1000, 64);
+  BOOST_TEST_EQ(r.allocate(1000, 64), a);
+
+  r.deallocate(a, 1000, 64);
+  r.deallocate(q, 2000);
+  r.deallocate(s, 1500);
+
+  r.release();
+  BOOST_TEST_EQ(r.stats().cached_bytes, 0);
+  BOOST_TEST_EQ(r.stats().hits, 3);
+}
+
+void
+test_limits()
+{
+  auto options             = sleip::recycling_options();
+  options.max_bucket_bytes = 2048;
+  options.max_cached_bytes = 3072;
+  options.max_buckets      = 2;
+
+  auto r = sleip::recycling_resource(options);
+
+  auto blocks = std::vector<void*>();
+  for (auto i = 0; i < 3; ++i) { blocks.push_back(r.allocate(1024)); }
+  for (auto* p : blocks) { r.deallocate(p, 1024); }
+
+  // the third block doesn't fit in its bucket
+  //
+  BOOST_TEST_EQ(r.stats().recycled, 2);
+  BOOST_TEST_EQ(r.stats().discarded, 1);
+
+  // nor a third one of this size in the overall limit
+  //
+  blocks.clear();
+  for (auto i = 0; i < 3; ++i) { blocks.push_back(r.allocate(512)); }
+  for (auto* p : blocks) { r.deallocate(p, 512); }
+  BOOST_TEST_EQ(r.stats().cached_bytes, 3072);
+  BOOST_TEST_EQ(r.stats().discarded, 2);
+
+  // and there's no room for a third size at all
+  //
+  r.deallocate(r.allocate(64), 64);
+  BOOST_TEST_EQ(r.stats().discarded, 3);
+}
+
+void
+test_dynamic_array()
+{
+  using alloc_type = sleip::recycling_allocator<float>;
+
+  auto r = sleip::recycling_resource();
+
+  float const* first = nullptr;
+  for (auto i = 0; i < 100; ++i) {
+    auto a = sleip::dynamic_array<float, alloc_type>(4096, sleip::noinit, r);
+    a[0]   = static_cast<float>(i);
+
+    if (first == nullptr) { first = a.data(); }
+    BOOST_TEST_EQ(a.data(), first);
+  }
+
+  BOOST_TEST_EQ(r.stats().misses, 1);
+  BOOST_TEST_EQ(r.stats().hits, 99);
+
+  auto a = sleip::dynamic_array<float, alloc_type>(16, 1.0f, r);
+  auto b = sleip::dynamic_array<float, alloc_type>(a, r);
+  BOOST_TEST((a == b));
+  BOOST_TEST(a.get_allocator() == b.get_allocator());
+  BOOST_TEST(&a.get_allocator().resource() == &r);
+
+  auto c = std::move(a);
+  BOOST_TEST_EQ(c.size(), 16);
+}
+
+void
+test_threads()
+{
+  auto r = sleip::recycling_resource();
+
+  auto work = [&r] {
+    for (auto i = 0; i < 10'000; ++i) {
+      auto a = sleip::dynamic_array<std::uint32_t, sleip::recycling_allocator<std::uint32_t>>(
+        64 + i % 4, sleip::noinit, r);
+      a[0] = 1;
+    }
+  };
+
+  auto threads = std::vector<std::thread>();
+  for (auto i = 0; i < 4; ++i) { threads.emplace_back(work); }
+  for (auto& t : threads) { t.join(); }
+
+  auto const stats = r.stats();
+  BOOST_TEST_EQ(stats.hits + stats.misses, 40'000);
+  BOOST_TEST_EQ(stats.recycled + stats.discarded, 40'000);
+  BOOST_TEST_LE(stats.misses, 16);
+}
+
+int
+main()
+{
+  test_buckets();
+  test_limits();
+  test_dynamic_array();
+  test_threads();
+
+  return boost::report_errors();
+}
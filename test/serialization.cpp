@@ -0,0 +1,316 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/serialization.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+template <class T, class Allocator>
+auto
+to_bytes(sleip::dynamic_array<T, Allocator> const& a) -> std::vector<unsigned char>
+{
+  auto buf = std::vector<unsigned char>(sleip::serialized_size(a));
+  BOOST_TEST_EQ(sleip::save(buf.data(), buf.size(), a), buf.size());
+  return buf;
+}
+
+// recomputes the trailer after the test has tampered with the header or payload
+//
+auto
+reseal(std::vector<unsigned char>& buf) -> void
+{
+  auto const n   = buf.size() - 4;
+  auto const crc = sleip::detail::crc32c(0, buf.data(), n);
+  sleip::detail::store_le(buf.data() + n, crc);
+}
+
+// a stream over `bytes` that can't seek, like a pipe or a socket
+//
+struct unseekable_buf : std::streambuf
+{
+  std::string bytes;
+
+  explicit unseekable_buf(std::string s) : bytes(std::move(s))
+  {
+    setg(bytes.data(), bytes.data(), bytes.data() + bytes.size());
+  }
+};
+
+void
+test_crc32c()
+{
+  auto const check = std::string("123456789");
+  BOOST_TEST_EQ(sleip::detail::crc32c(0, check.data(), check.size()), 0xE3069283u);
+
+  // incremental and one-shot agree, as do the hardware and table driven implementations
+  //
+  auto const crc = sleip::detail::crc32c(sleip::detail::crc32c(0, check.data(), 4),
+                                         check.data() + 4, check.size() - 4);
+  BOOST_TEST_EQ(crc, 0xE3069283u);
+
+  auto bytes = std::vector<unsigned char>(1000);
+  std::iota(bytes.begin(), bytes.end(), static_cast<unsigned char>(0));
+
+  auto const sw = ~sleip::detail::crc32c_sw(~0u, bytes.data() + 3, bytes.size() - 3);
+  BOOST_TEST_EQ(sleip::detail::crc32c(0, bytes.data() + 3, bytes.size() - 3), sw);
+}
+
+void
+test_stream_round_trip()
+{
+  {
+    auto a = sleip::dynamic_array<int>(100'000, sleip::noinit);
+    std::iota(a.begin(), a.end(), -50'000);
+
+    auto ss = std::stringstream();
+    sleip::save(ss, a);
+    BOOST_TEST_EQ(ss.str().size(), sleip::serialized_size(a));
+
+    auto const b = sleip::load<int>(ss);
+    BOOST_TEST((a == b));
+  }
+
+  {
+    auto const a = sleip::dynamic_array<double[3]>(1000, {1.5, -2.5, 3.5});
+
+    auto ss = std::stringstream();
+    sleip::save(ss, a);
+
+    auto const b = sleip::load<double[3]>(ss);
+    BOOST_TEST_EQ(b.size(), 1000);
+    BOOST_TEST_EQ(b[999][2], 3.5);
+    BOOST_TEST((a == b));
+  }
+
+  {
+    auto const a = sleip::dynamic_array<std::byte>();
+
+    auto ss = std::stringstream();
+    sleip::save(ss, a);
+
+    BOOST_TEST(sleip::load<std::byte>(ss).empty());
+  }
+
+  // a stream that can't seek grows the array as the payload arrives, several chunks here
+  //
+  {
+    auto a = sleip::dynamic_array<int>(300'000, sleip::noinit);
+    std::iota(a.begin(), a.end(), 0);
+
+    auto const buf = to_bytes(a);
+    auto       sb  = unseekable_buf(std::string(buf.begin(), buf.end()));
+    auto       is  = std::istream(&sb);
+
+    auto const b = sleip::load<int>(is);
+    BOOST_TEST_EQ(b.size(), a.size());
+    BOOST_TEST((a == b));
+  }
+}
+
+struct big_scalar
+{
+  char c[300];
+};
+
+void
+test_buffer_round_trip()
+{
+  using alloc_type = boost::container::pmr::polymorphic_allocator<std::uint16_t[2]>;
+
+  auto mem = boost::container::pmr::monotonic_buffer_resource();
+
+  auto const a   = sleip::dynamic_array<std::uint16_t[2]>(300'000, {0x0102, 0x0304});
+  auto const buf = to_bytes(a);
+  BOOST_TEST_EQ(buf.size(), 32 + 300'000 * 4 + 4);
+
+  auto const b = sleip::load<std::uint16_t[2]>(buf.data(), buf.size(), alloc_type(&mem));
+  BOOST_TEST(b.get_allocator().resource() == &mem);
+  BOOST_TEST(std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                        [](auto const& x, auto const& y) { return x[0] == y[0] && x[1] == y[1]; }));
+
+  // a scalar too large for the header's one byte scalar size still round-trips
+  //
+  {
+    auto const c = sleip::dynamic_array<big_scalar[2]>(3, {big_scalar{{'a'}}, big_scalar{{'b'}}});
+
+    auto const bytes = to_bytes(c);
+    auto const d     = sleip::load<big_scalar[2]>(bytes.data(), bytes.size());
+    BOOST_TEST_EQ(d.size(), 3);
+    BOOST_TEST_EQ(d[2][0].c[0], 'a');
+    BOOST_TEST_EQ(d[2][1].c[0], 'b');
+
+    auto ss = std::stringstream(std::string(bytes.begin(), bytes.end()));
+    BOOST_TEST_EQ(sleip::load<big_scalar[2]>(ss)[1][1].c[0], 'b');
+  }
+}
+
+void
+test_byte_swap()
+{
+  auto a = sleip::dynamic_array<std::uint32_t[2]>(70'000, {0x01020304u, 0xA0B0C0D0u});
+
+  // pretend the payload was written on a machine of the opposite byte order
+  //
+  auto buf = to_bytes(a);
+  buf[6] ^= 1;
+  sleip::detail::byte_swap(buf.data() + 32, buf.size() - 36, 4);
+  reseal(buf);
+
+  auto const b = sleip::load<std::uint32_t[2]>(buf.data(), buf.size());
+  BOOST_TEST_EQ(b[0][0], 0x01020304u);
+  BOOST_TEST_EQ(b[69'999][1], 0xA0B0C0D0u);
+
+  auto       ss = std::stringstream(std::string(buf.begin(), buf.end()));
+  auto const c  = sleip::load<std::uint32_t[2]>(ss);
+  BOOST_TEST((b == c));
+
+  auto d = sleip::dynamic_array<double>(3, 0.1);
+  buf    = to_bytes(d);
+  buf[6] ^= 1;
+  sleip::detail::byte_swap(buf.data() + 32, buf.size() - 36, 8);
+  reseal(buf);
+
+  BOOST_TEST((sleip::load<double>(buf.data(), buf.size()) == d));
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct point
+{
+  float x;
+  float y;
+};
+
+void
+test_throwing()
+{
+  auto const a   = sleip::dynamic_array<int>(1000, 7);
+  auto const buf = to_bytes(a);
+
+  {
+    auto small = std::vector<unsigned char>(buf.size() - 1);
+    BOOST_TEST_THROWS(sleip::save(small.data(), small.size(), a), std::length_error);
+  }
+
+  // truncated anywhere, including inside the header
+  //
+  for (auto const n : {std::size_t{0}, std::size_t{20}, buf.size() - 1}) {
+    BOOST_TEST_THROWS(sleip::load<int>(buf.data(), n), sleip::serialization_error);
+
+    auto ss = std::stringstream(std::string(buf.begin(), buf.begin() + n));
+    BOOST_TEST_THROWS(sleip::load<int>(ss), sleip::serialization_error);
+  }
+
+  // a count far past what the input holds fails on the missing bytes, not on the allocation
+  //
+  {
+    auto bad = buf;
+    sleip::detail::store_le(bad.data() + 16, std::uint64_t{1} << 40);
+    reseal(bad);
+
+    auto ss = std::stringstream(std::string(bad.begin(), bad.end()));
+    BOOST_TEST_THROWS(sleip::load<int>(ss), sleip::serialization_error);
+
+    auto sb = unseekable_buf(std::string(bad.begin(), bad.end()));
+    auto is = std::istream(&sb);
+    BOOST_TEST_THROWS(sleip::load<int>(is), sleip::serialization_error);
+  }
+
+  // a single flipped bit in the payload
+  //
+  {
+    auto bad = buf;
+    bad[100] ^= 0x10;
+    BOOST_TEST_THROWS(sleip::load<int>(bad.data(), bad.size()), sleip::serialization_error);
+  }
+
+  // wrong magic, element type, extent and version
+  //
+  {
+    auto bad = buf;
+    bad[0]   = 'X';
+    reseal(bad);
+    BOOST_TEST_THROWS(sleip::load<int>(bad.data(), bad.size()), sleip::serialization_error);
+  }
+
+  BOOST_TEST_THROWS(sleip::load<std::int16_t>(buf.data(), buf.size()), sleip::serialization_error);
+  BOOST_TEST_THROWS(sleip::load<std::int64_t>(buf.data(), buf.size()), sleip::serialization_error);
+  BOOST_TEST_THROWS(sleip::load<int[2]>(buf.data(), buf.size()), sleip::serialization_error);
+
+  {
+    auto bad = buf;
+    bad[4]   = 2;
+    reseal(bad);
+    BOOST_TEST_THROWS(sleip::load<int>(bad.data(), bad.size()), sleip::serialization_error);
+  }
+
+  // a count that claims more data than there is
+  //
+  {
+    auto bad = buf;
+    sleip::detail::store_le(bad.data() + 16, std::uint64_t{1} << 62);
+    reseal(bad);
+    BOOST_TEST_THROWS(sleip::load<int>(bad.data(), bad.size()), sleip::serialization_error);
+  }
+
+  // struct elements can't be fixed up by swapping bytes
+  //
+  {
+    auto const p = sleip::dynamic_array<point>(4, point{1.0f, 2.0f});
+
+    auto bad = to_bytes(p);
+    BOOST_TEST_EQ(sleip::load<point>(bad.data(), bad.size())[3].y, 2.0f);
+
+    bad[6] ^= 1;
+    reseal(bad);
+    BOOST_TEST_THROWS(sleip::load<point>(bad.data(), bad.size()), sleip::serialization_error);
+  }
+}
+
+#endif
+
+int
+main()
+{
+  test_crc32c();
+  test_stream_round_trip();
+  test_buffer_round_trip();
+  test_byte_swap();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,418 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array.hpp>
+#include <sleip/shared_dynamic_array.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+namespace ipc = boost::interprocess;
+namespace pmr = boost::container::pmr;
+
+static_assert(std::is_nothrow_copy_constructible_v<sleip::shared_dynamic_array<std::string>>);
+static_assert(std::is_nothrow_move_constructible_v<sleip::shared_dynamic_array<std::string>>);
+static_assert(std::is_nothrow_move_assignable_v<sleip::shared_dynamic_array<std::string>>);
+static_assert(std::is_same_v<sleip::shared_dynamic_array<int>::reference, int const&>);
+
+void
+test_construction()
+{
+  auto a = sleip::shared_dynamic_array<int>();
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.data(), nullptr);
+  BOOST_TEST_EQ(a.use_count(), 0);
+  BOOST_TEST_EQ(a.begin(), a.end());
+
+  auto b = sleip::shared_dynamic_array<int>(100, 7);
+  BOOST_TEST_EQ(b.size(), 100);
+  BOOST_TEST_EQ(b.use_count(), 1);
+  BOOST_TEST(std::all_of(b.begin(), b.end(), [](int x) { return x == 7; }));
+
+  auto c = sleip::shared_dynamic_array<int>(100);
+  BOOST_TEST(std::all_of(c.begin(), c.end(), [](int x) { return x == 0; }));
+
+  auto const v = std::vector<std::string>{"a", "b", "c"};
+
+  auto d = sleip::shared_dynamic_array<std::string>(v);
+  BOOST_TEST_ALL_EQ(d.begin(), d.end(), v.begin(), v.end());
+
+  auto e = sleip::shared_dynamic_array<std::string>{"a", "b", "c"};
+  BOOST_TEST(d == e);
+  BOOST_TEST_EQ(e.at(2), "c");
+  BOOST_TEST_THROWS(e.at(3), std::out_of_range);
+
+  using vec4 = double[4];
+
+  auto f = sleip::shared_dynamic_array<vec4>(3, {1.0, 2.0, 3.0, 4.0});
+  BOOST_TEST_EQ(f[2][3], 4.0);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(f.data()) % alignof(vec4), 0);
+
+  auto g = sleip::shared_dynamic_array<float, sleip::cache_aligned_allocator<float>>(33, 1.0f);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(g.data()) % 64, 0);
+}
+
+void
+test_sharing()
+{
+  auto a = sleip::shared_dynamic_array<std::string>(4, "payload");
+
+  auto b = a;
+  BOOST_TEST_EQ(b.data(), a.data());
+  BOOST_TEST_EQ(a.use_count(), 2);
+
+  auto c = sleip::shared_dynamic_array<std::string>(1, "other");
+  c      = b;
+  BOOST_TEST_EQ(c.data(), a.data());
+  BOOST_TEST_EQ(a.use_count(), 3);
+
+  auto d = std::move(c);
+  BOOST_TEST(c.empty());
+  BOOST_TEST_EQ(a.use_count(), 3);
+
+  b = sleip::shared_dynamic_array<std::string>();
+  d = d;
+  BOOST_TEST_EQ(a.use_count(), 2);
+  BOOST_TEST_EQ(d[3], "payload");
+
+  swap(a, c);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(c.use_count(), 2);
+}
+
+void
+test_slice()
+{
+  auto a = sleip::shared_dynamic_array<std::string>{"a", "b", "c", "d", "e"};
+
+  auto b = a.slice(1, 3);
+  BOOST_TEST_EQ(b.size(), 3);
+  BOOST_TEST_EQ(b.data(), a.data() + 1);
+  BOOST_TEST_EQ(b.front(), "b");
+  BOOST_TEST_EQ(b.back(), "d");
+  BOOST_TEST_EQ(a.use_count(), 2);
+
+  auto c = b.slice(2, 1);
+  BOOST_TEST_EQ(c[0], "d");
+  BOOST_TEST_EQ(a.use_count(), 3);
+
+  auto d = std::move(b).slice(0, 1);
+  BOOST_TEST_EQ(d[0], "b");
+  BOOST_TEST_EQ(a.use_count(), 3);
+
+  BOOST_TEST(a.slice(5, 0).empty());
+  BOOST_TEST_THROWS(a.slice(4, 2), std::out_of_range);
+  BOOST_TEST_THROWS(a.slice(6, 0), std::out_of_range);
+
+  // the slice outlives the array it was cut from and still frees every element
+  //
+  a = {};
+  d = {};
+  BOOST_TEST_EQ(c.use_count(), 1);
+  BOOST_TEST_EQ(c[0], "d");
+}
+
+void
+test_unique_data()
+{
+  auto a = sleip::shared_dynamic_array<std::uint32_t>(8, sleip::noinit);
+
+  auto* const p = a.unique_data();
+  BOOST_TEST_EQ(p, a.data());
+  std::iota(p, p + a.size(), 0u);
+
+  auto b = a;
+  BOOST_TEST_EQ(a.unique_data(), nullptr);
+
+  b = {};
+  BOOST_TEST_EQ(a.unique_data(), p);
+  BOOST_TEST_EQ(a[7], 7);
+
+  BOOST_TEST_EQ(sleip::shared_dynamic_array<int>().unique_data(), nullptr);
+}
+
+void
+test_unshare()
+{
+  auto a = sleip::shared_dynamic_array<std::string>{"a", "b", "c"};
+  auto b = a;
+
+  // shared, so the elements are copied and `a` keeps its own
+  //
+  auto c = std::move(b).unshare();
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(c.size(), 3);
+  BOOST_TEST_EQ(c[1], "b");
+  BOOST_TEST_EQ(a.use_count(), 1);
+
+  c[1] = "mutable";
+  BOOST_TEST_EQ(a[1], "b");
+
+  // unique, so the strings are moved out
+  //
+  auto d = std::move(a).unshare();
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(d.size(), 3);
+  BOOST_TEST_EQ(d[2], "c");
+
+  auto e = sleip::shared_dynamic_array<int>(10);
+  std::iota(e.unique_data(), e.unique_data() + e.size(), 0);
+
+  auto f = std::move(e).slice(2, 5).unshare();
+  BOOST_TEST_EQ(f.size(), 5);
+  BOOST_TEST_EQ(f.front(), 2);
+  BOOST_TEST_EQ(f.back(), 6);
+
+  BOOST_TEST(sleip::shared_dynamic_array<int>().unshare().empty());
+}
+
+void
+test_from_dynamic_array()
+{
+  auto a = sleip::dynamic_array<int>{1, 2, 3};
+
+  auto b = sleip::shared_dynamic_array<int>(std::move(a));
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(b.size(), 3);
+  BOOST_TEST_EQ(b[2], 3);
+
+  auto c = sleip::dynamic_array<std::string>{"x", "y"};
+
+  auto d = sleip::shared_dynamic_array<std::string>(std::move(c));
+  BOOST_TEST(c.empty());
+  BOOST_TEST_EQ(d[1], "y");
+
+  auto e = d.slice(1, 1);
+  BOOST_TEST_EQ(e.use_count(), 2);
+
+  auto const f = sleip::dynamic_array<int>{1, 2, 3};
+  BOOST_TEST(sleip::shared_dynamic_array<int>(f) == b);
+}
+
+void
+test_comparison()
+{
+  auto a = sleip::shared_dynamic_array<std::uint8_t>{1, 2, 3, 4};
+  auto b = a.slice(0, 3);
+
+  BOOST_TEST(a != b);
+  BOOST_TEST(b < a);
+  BOOST_TEST(a.slice(1, 2) > b);
+  BOOST_TEST(a.slice(0, 3) == b);
+
+#ifndef SLEIP_NO_CXX20_THREE_WAY_COMPARISON
+  BOOST_TEST((b <=> a) < 0);
+#endif
+}
+
+void
+test_non_equal_allocators()
+{
+  using alloc_type = pmr::polymorphic_allocator<int>;
+  using array_type = sleip::shared_dynamic_array<int, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = alloc_type(&buff);
+  auto default_alloc = alloc_type();
+
+  auto a = array_type(16, 1, default_alloc);
+
+  // a copy shares the block along with the allocator that can free it
+  //
+  auto b = a;
+  BOOST_TEST_EQ(b.data(), a.data());
+  BOOST_TEST(b.get_allocator() == default_alloc);
+
+  // but an array bound to another resource has to keep its own copy
+  //
+  auto c = array_type(buff_alloc);
+  c      = a;
+  BOOST_TEST(c.get_allocator() == buff_alloc);
+  BOOST_TEST_NE(c.data(), a.data());
+  BOOST_TEST(c == a);
+  BOOST_TEST_EQ(a.use_count(), 2);
+
+  auto d = array_type(std::move(b), buff_alloc);
+  BOOST_TEST_NE(d.data(), a.data());
+  BOOST_TEST(d == a);
+
+  auto e = std::move(d).unshare();
+  BOOST_TEST(e.get_allocator() == buff_alloc);
+  BOOST_TEST_EQ(e.size(), 16);
+}
+
+void
+test_fancy_pointer()
+{
+  struct shm_remove
+  {
+    shm_remove() { ipc::shared_memory_object::remove("SleipSharedDynamicArray"); }
+    ~shm_remove() { ipc::shared_memory_object::remove("SleipSharedDynamicArray"); }
+  } remover;
+
+  auto segment = ipc::managed_shared_memory(ipc::create_only, "SleipSharedDynamicArray", 65536);
+
+  using alloc_type = ipc::allocator<int, ipc::managed_shared_memory::segment_manager>;
+
+  auto alloc = alloc_type(segment.get_segment_manager());
+
+  auto a = sleip::shared_dynamic_array<int, alloc_type>(std::size_t{128}, 1, alloc);
+  auto b = a.slice(64, 64);
+  BOOST_TEST_EQ(b.size(), 64);
+  BOOST_TEST_EQ(b[0], 1);
+
+  auto c = std::move(a).unshare();
+  BOOST_TEST_EQ(c.size(), 128);
+  BOOST_TEST_EQ(b.use_count(), 1);
+}
+
+void
+test_threads()
+{
+  static std::atomic<int> num_live{0};
+
+  struct counted
+  {
+    int value = 1;
+
+    counted() { ++num_live; }
+    counted(counted const& other)
+      : value{other.value}
+    {
+      ++num_live;
+    }
+    ~counted() { --num_live; }
+  };
+
+  {
+    auto payload = sleip::shared_dynamic_array<counted>(256);
+
+    auto sum  = std::atomic<long>{0};
+    auto work = [&sum](sleip::shared_dynamic_array<counted> a) {
+      for (auto i = 0; i < 10'000; ++i) {
+        auto copy  = a;
+        auto slice = copy.slice(static_cast<std::size_t>(i % 128), 64);
+        sum += slice.front().value;
+      }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < 4; ++i) { threads.emplace_back(work, payload); }
+    for (auto& t : threads) { t.join(); }
+
+    BOOST_TEST_EQ(sum.load(), 40'000);
+    BOOST_TEST_EQ(payload.use_count(), 1);
+    BOOST_TEST_EQ(num_live.load(), 256);
+  }
+  BOOST_TEST_EQ(num_live.load(), 0);
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+  static inline int limit    = 100;
+
+  int value = 0;
+
+  throwing()
+  {
+    if (num_live == limit) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const& other)
+    : throwing()
+  {
+    value = other.value;
+  }
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  throwing::num_live = 0;
+  throwing::limit    = 100;
+
+  {
+    auto a = sleip::shared_dynamic_array<throwing>(4);
+    auto b = a;
+
+    throwing::limit = 6;
+    BOOST_TEST_THROWS(sleip::shared_dynamic_array<throwing>(4), int);
+    BOOST_TEST_EQ(throwing::num_live, 4);
+
+    // copying out of a shared block fails and leaves the handle as it was
+    //
+    BOOST_TEST_THROWS(std::move(b).unshare(), int);
+    BOOST_TEST_EQ(b.size(), 4);
+    BOOST_TEST_EQ(a.use_count(), 2);
+    BOOST_TEST_EQ(throwing::num_live, 4);
+
+    throwing::limit = 100;
+  }
+  BOOST_TEST_EQ(throwing::num_live, 0);
+}
+
+#endif
+
+int
+main()
+{
+  test_construction();
+  test_sharing();
+  test_slice();
+  test_unique_data();
+  test_unshare();
+  test_from_dynamic_array();
+  test_comparison();
+  test_non_equal_allocators();
+  test_fancy_pointer();
+  test_threads();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,456 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/small_dynamic_array.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+namespace pmr = boost::container::pmr;
+
+// counts every call to `allocate` so the tests can tell inline storage apart from the heap
+//
+template <class T>
+struct counting_allocator
+{
+  using value_type = T;
+
+  static inline int num_allocs = 0;
+
+  counting_allocator() = default;
+
+  template <class U>
+  counting_allocator(counting_allocator<U> const&) noexcept
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    ++num_allocs;
+    return std::allocator<T>().allocate(n);
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template <class T, class U>
+auto
+operator==(counting_allocator<T> const&, counting_allocator<U> const&) noexcept -> bool
+{
+  return true;
+}
+
+template <class T, class U>
+auto
+operator!=(counting_allocator<T> const&, counting_allocator<U> const&) noexcept -> bool
+{
+  return false;
+}
+
+static_assert(std::is_nothrow_move_constructible_v<sleip::small_dynamic_array<int, 8>>);
+static_assert(std::is_nothrow_move_assignable_v<sleip::small_dynamic_array<int, 8>>);
+static_assert(std::is_nothrow_swappable_v<sleip::small_dynamic_array<std::string, 8>>);
+
+void
+test_inline_storage()
+{
+  using array_type = sleip::small_dynamic_array<int, 8, counting_allocator<int>>;
+
+  counting_allocator<int>::num_allocs = 0;
+
+  auto a = array_type(8, 1);
+  BOOST_TEST(a.is_inline());
+  BOOST_TEST_EQ(a.size(), 8);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1; }));
+
+  auto b = array_type(9, 2);
+  BOOST_TEST(!b.is_inline());
+  BOOST_TEST_EQ(b.size(), 9);
+  BOOST_TEST(std::all_of(b.begin(), b.end(), [](int x) { return x == 2; }));
+
+  auto c = array_type();
+  BOOST_TEST(c.empty());
+  BOOST_TEST(c.is_inline());
+  BOOST_TEST_EQ(c.begin(), c.end());
+
+  BOOST_TEST_EQ(counting_allocator<int>::num_allocs, 1);
+
+  auto d = array_type(8, sleip::noinit);
+  BOOST_TEST(d.is_inline());
+  BOOST_TEST_EQ(array_type::inline_capacity, 8);
+  BOOST_TEST_EQ(counting_allocator<int>::num_allocs, 1);
+}
+
+void
+test_constructors()
+{
+  auto const v = std::vector<int>{1, 2, 3, 4, 5};
+
+  auto a = sleip::small_dynamic_array<int, 4>(v.begin(), v.end());
+  BOOST_TEST(!a.is_inline());
+  BOOST_TEST_ALL_EQ(a.begin(), a.end(), v.begin(), v.end());
+
+  auto b = sleip::small_dynamic_array<int, 8>(v);
+  BOOST_TEST(b.is_inline());
+  BOOST_TEST_ALL_EQ(b.begin(), b.end(), v.begin(), v.end());
+
+  auto c = sleip::small_dynamic_array<std::string, 2>{"a", "b"};
+  BOOST_TEST(c.is_inline());
+  BOOST_TEST_EQ(c[0], "a");
+  BOOST_TEST_EQ(c[1], "b");
+
+  auto d = sleip::small_dynamic_array<std::string, 2>(3);
+  BOOST_TEST(std::all_of(d.begin(), d.end(), [](auto const& s) { return s.empty(); }));
+
+  auto e = c;
+  BOOST_TEST(e == c);
+
+  auto f = sleip::small_dynamic_array<int, 4>(a);
+  BOOST_TEST(f == a);
+  BOOST_TEST_NE(f.data(), a.data());
+}
+
+void
+test_arrays()
+{
+  using triple = int[3];
+
+  auto a = sleip::small_dynamic_array<triple, 2>(2, {1, 2, 3});
+  BOOST_TEST(a.is_inline());
+  BOOST_TEST_EQ(a[1][2], 3);
+
+  auto b = sleip::small_dynamic_array<triple, 2>(4, {1, 2, 3});
+  BOOST_TEST(!b.is_inline());
+  BOOST_TEST_EQ(b[3][0], 1);
+
+  triple const t = {7, 8, 9};
+  a.fill(t);
+  BOOST_TEST_EQ(a[0][0], 7);
+  BOOST_TEST_EQ(a[1][2], 9);
+
+  auto c = std::move(a);
+  BOOST_TEST_EQ(c[1][1], 8);
+  BOOST_TEST(a.empty());
+}
+
+void
+test_move()
+{
+  // inline elements are moved across and the source is left empty
+  //
+  {
+    auto a = sleip::small_dynamic_array<std::string, 4>(3, std::string(32, 'x'));
+    auto b = std::move(a);
+
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(b.size(), 3);
+    BOOST_TEST_EQ(b[2], std::string(32, 'x'));
+  }
+
+  // heap storage is handed over as is
+  //
+  {
+    auto a = sleip::small_dynamic_array<std::string, 2>(3, "x");
+
+    auto const* const old_data = a.data();
+
+    auto b = std::move(a);
+    BOOST_TEST_EQ(b.data(), old_data);
+    BOOST_TEST(a.empty());
+
+    auto c = sleip::small_dynamic_array<std::string, 2>(1, "y");
+    c      = std::move(b);
+    BOOST_TEST_EQ(c.data(), old_data);
+    BOOST_TEST(b.empty());
+
+    auto d = sleip::small_dynamic_array<std::string, 2>(2, "z");
+    c      = std::move(d);
+    BOOST_TEST(c.is_inline());
+    BOOST_TEST_EQ(c[1], "z");
+  }
+}
+
+void
+test_non_equal_allocators()
+{
+  using alloc_type = pmr::polymorphic_allocator<int>;
+  using array_type = sleip::small_dynamic_array<int, 4, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = alloc_type(&buff);
+  auto default_alloc = alloc_type();
+
+  auto a = array_type(buff_alloc);
+  auto b = array_type(16, 1, default_alloc);
+
+  auto const* const old_data = b.data();
+
+  a = std::move(b);
+  BOOST_TEST(a.get_allocator() == buff_alloc);
+  BOOST_TEST_NE(a.data(), old_data);
+  BOOST_TEST_EQ(a.size(), 16);
+  BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 1; }));
+  BOOST_TEST(b.empty());
+
+  auto c = array_type(std::move(a), default_alloc);
+  BOOST_TEST(c.get_allocator() == default_alloc);
+  BOOST_TEST_EQ(c.size(), 16);
+  BOOST_TEST(a.empty());
+
+  auto d = array_type(2, 3, buff_alloc);
+  d      = c;
+  BOOST_TEST(d.get_allocator() == buff_alloc);
+  BOOST_TEST(d == c);
+}
+
+// move-only so the relocation can't fall back to a copy, and counted so a leak of the source
+// elements shows up
+//
+struct relocatable
+{
+  static inline int num_live = 0;
+
+  int x = 1;
+
+  relocatable() { ++num_live; }
+  relocatable(relocatable&& other) noexcept
+    : x{std::exchange(other.x, 0)}
+  {
+    ++num_live;
+  }
+  ~relocatable() { --num_live; }
+};
+
+template <>
+struct sleip::is_trivially_relocatable<relocatable> : std::true_type
+{
+};
+
+void
+test_relocation()
+{
+  // `polymorphic_allocator` has its own `construct` so the elements aren't bulk copyable, but they
+  // are still bulk relocatable, both from the inline buffer and from the heap
+  //
+  using alloc_type = pmr::polymorphic_allocator<relocatable>;
+  using array_type = sleip::small_dynamic_array<relocatable, 4, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  relocatable::num_live = 0;
+  {
+    auto a = array_type(3, alloc_type());
+    a[2].x = 7;
+
+    auto b = array_type(std::move(a), alloc_type(&buff));
+    BOOST_TEST(a.empty());
+    BOOST_TEST(b.is_inline());
+    BOOST_TEST_EQ(b[2].x, 7);
+    BOOST_TEST_EQ(relocatable::num_live, 3);
+
+    auto c = array_type(16, alloc_type());
+    c[15].x = 9;
+
+    auto d = array_type(std::move(c), alloc_type(&buff));
+    BOOST_TEST(c.empty());
+    BOOST_TEST(!d.is_inline());
+    BOOST_TEST_EQ(d[15].x, 9);
+    BOOST_TEST_EQ(relocatable::num_live, 19);
+
+    auto e = array_type(alloc_type());
+    e      = std::move(d);
+    BOOST_TEST(d.empty());
+    BOOST_TEST_EQ(e[15].x, 9);
+    BOOST_TEST_EQ(relocatable::num_live, 19);
+  }
+  BOOST_TEST_EQ(relocatable::num_live, 0);
+}
+
+void
+test_copy_assignment()
+{
+  auto a = sleip::small_dynamic_array<std::string, 2>(2, "a");
+  auto b = sleip::small_dynamic_array<std::string, 2>(5, "b");
+
+  a = b;
+  BOOST_TEST(!a.is_inline());
+  BOOST_TEST(a == b);
+
+  b = sleip::small_dynamic_array<std::string, 2>(1, "c");
+  a = b;
+  BOOST_TEST(a.is_inline());
+  BOOST_TEST_EQ(a.size(), 1);
+  BOOST_TEST_EQ(a[0], "c");
+
+  // same size assigns in place
+  //
+  auto c = sleip::small_dynamic_array<int, 2>(5, 1);
+  auto d = sleip::small_dynamic_array<int, 2>(5, 2);
+
+  auto const* const old_data = c.data();
+
+  c = d;
+  BOOST_TEST_EQ(c.data(), old_data);
+  BOOST_TEST(c == d);
+
+  c = {1, 2};
+  BOOST_TEST(c.is_inline());
+  BOOST_TEST_EQ(c[1], 2);
+}
+
+void
+test_swap()
+{
+  auto a = sleip::small_dynamic_array<std::string, 2>(1, "a");
+  auto b = sleip::small_dynamic_array<std::string, 2>(5, "b");
+  auto c = sleip::small_dynamic_array<std::string, 2>(6, "c");
+
+  swap(a, b);
+  BOOST_TEST_EQ(a.size(), 5);
+  BOOST_TEST_EQ(a[4], "b");
+  BOOST_TEST_EQ(b.size(), 1);
+  BOOST_TEST_EQ(b[0], "a");
+
+  auto const* const a_data = a.data();
+  auto const* const c_data = c.data();
+
+  a.swap(c);
+  BOOST_TEST_EQ(a.data(), c_data);
+  BOOST_TEST_EQ(c.data(), a_data);
+
+  auto d = sleip::small_dynamic_array<std::string, 2>(2, "d");
+  b.swap(d);
+  BOOST_TEST_EQ(b.size(), 2);
+  BOOST_TEST_EQ(b[1], "d");
+  BOOST_TEST_EQ(d.size(), 1);
+  BOOST_TEST_EQ(d[0], "a");
+}
+
+void
+test_comparison()
+{
+  using array_type = sleip::small_dynamic_array<int, 4>;
+
+  auto const a = array_type{1, 2, 3};
+  auto const b = array_type{1, 2, 3, 4, 5};
+  auto const c = array_type{1, 3};
+
+  BOOST_TEST(a == a);
+  BOOST_TEST(a != b);
+  BOOST_TEST(a < b);
+  BOOST_TEST(b < c);
+  BOOST_TEST(c > a);
+  BOOST_TEST(a <= b);
+  BOOST_TEST(c >= b);
+}
+
+void
+test_element_access()
+{
+  auto a = sleip::small_dynamic_array<int, 4>{1, 2, 3};
+  BOOST_TEST_EQ(a.front(), 1);
+  BOOST_TEST_EQ(a.back(), 3);
+  BOOST_TEST_EQ(*a.rbegin(), 3);
+  BOOST_TEST_EQ(a.at(1), 2);
+
+  a.fill(5);
+  BOOST_TEST(std::all_of(a.cbegin(), a.cend(), [](int x) { return x == 5; }));
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+
+  int x = 0;
+
+  throwing(int x_)
+    : x{x_}
+  {
+    if (x == -1) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const& other)
+    : throwing(other.x)
+  {
+  }
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  auto a = sleip::small_dynamic_array<int, 4>{1, 2, 3};
+  BOOST_TEST_THROWS(a.at(3), std::out_of_range);
+
+  auto const v = std::vector<int>{1, 2, -1};
+
+  throwing::num_live = 0;
+  BOOST_TEST_THROWS((sleip::small_dynamic_array<throwing, 4>(v.begin(), v.end())), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+
+  BOOST_TEST_THROWS((sleip::small_dynamic_array<throwing, 2>(v.begin(), v.end())), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+}
+
+#endif
+
+int
+main()
+{
+  test_inline_storage();
+  test_constructors();
+  test_arrays();
+  test_move();
+  test_non_equal_allocators();
+  test_relocation();
+  test_copy_assignment();
+  test_swap();
+  test_comparison();
+  test_element_access();
+  test_throwing();
+
+  return boost::report_errors();
+}
@@ -0,0 +1,301 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/soa_dynamic_array.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef SLEIP_NO_CXX17_PMR
+#include <memory_resource>
+#endif
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+struct particle
+{
+  double       x    = 0;
+  double       y    = 0;
+  float        mass = 0;
+  std::int32_t id   = 0;
+};
+
+static_assert(std::is_nothrow_move_constructible_v<sleip::soa_dynamic_array<float, int>>);
+static_assert(std::is_same_v<sleip::soa_dynamic_array<float, int>::reference,
+                             std::tuple<float&, int&>>);
+
+void
+test_layout()
+{
+  using soa_type = sleip::soa_dynamic_array<std::uint8_t, double, float>;
+
+  auto a = soa_type(37);
+  BOOST_TEST_EQ(a.size(), 37);
+
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data<0>()) % soa_type::column_alignment, 0);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data<1>()) % soa_type::column_alignment, 0);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data<2>()) % soa_type::column_alignment, 0);
+
+  // one allocation with the columns back to back
+  //
+  auto const* const base = reinterpret_cast<std::byte const*>(a.data<0>());
+  BOOST_TEST_EQ(reinterpret_cast<std::byte const*>(a.data<1>()) - base, 64);
+  BOOST_TEST_EQ(reinterpret_cast<std::byte const*>(a.data<2>()) - base, 64 + 320);
+
+  // value-initialized
+  //
+  auto const col = a.column<1>();
+  BOOST_TEST(std::all_of(col.begin(), col.end(), [](double d) { return d == 0; }));
+
+  auto b = soa_type();
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(b.data<0>(), nullptr);
+  BOOST_TEST(b.column<2>().empty());
+  BOOST_TEST(b.begin() == b.end());
+
+  auto c = soa_type(10, sleip::noinit);
+  BOOST_TEST_EQ(c.size(), 10);
+}
+
+void
+test_rows()
+{
+  auto a = sleip::soa_dynamic_array<float, std::string>(3, {1.5f, "x"});
+  BOOST_TEST_EQ(std::get<0>(a[2]), 1.5f);
+  BOOST_TEST_EQ(std::get<1>(a[2]), "x");
+
+  // proxy references write through to the columns
+  //
+  a[1]                 = std::make_tuple(2.5f, std::string("y"));
+  std::get<0>(a.at(0)) = 3.5f;
+
+  BOOST_TEST_EQ(a.column<0>()[1], 2.5f);
+  BOOST_TEST_EQ(a.column<1>()[1], "y");
+  BOOST_TEST_EQ(a.data<0>()[0], 3.5f);
+
+  auto n = 0;
+  for (auto [f, s] : a) {
+    f += 1;
+    s += "!";
+    ++n;
+  }
+  BOOST_TEST_EQ(n, 3);
+  BOOST_TEST_EQ(std::get<0>(a.front()), 4.5f);
+  BOOST_TEST_EQ(std::get<1>(a.back()), "x!");
+
+  auto const& c = a;
+  BOOST_TEST_EQ(c.end() - c.begin(), 3);
+  BOOST_TEST_EQ(std::get<1>(c.begin()[1]), "y!");
+
+  a.fill({0.0f, "z"});
+  BOOST_TEST_EQ(std::get<1>(a[0]), "z");
+
+  auto it = a.begin();
+  it += 2;
+  BOOST_TEST(it > a.begin());
+  BOOST_TEST_EQ(it - a.begin(), 2);
+
+  sleip::soa_dynamic_array<float, std::string>::const_iterator cit = it;
+  BOOST_TEST(cit == a.cbegin() + 2);
+}
+
+void
+test_aos_conversion()
+{
+  auto const count = std::size_t{5000};
+
+  auto aos = sleip::dynamic_array<particle>(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    aos[i] = particle{static_cast<double>(i), 2.0 * i, 0.5f, static_cast<std::int32_t>(i)};
+  }
+
+  auto soa = sleip::to_soa(aos, &particle::x, &particle::y, &particle::id);
+  static_assert(
+    std::is_same_v<decltype(soa), sleip::soa_dynamic_array<double, double, std::int32_t>>);
+
+  BOOST_TEST_EQ(soa.size(), count);
+  BOOST_TEST_EQ(soa.column<0>()[4999], 4999.0);
+  BOOST_TEST_EQ(soa.column<1>()[10], 20.0);
+  BOOST_TEST_EQ(soa.column<2>()[123], 123);
+
+  for (auto& x : soa.column<0>()) { x = -x; }
+
+  soa.scatter(aos, &particle::x, &particle::y, &particle::id);
+  BOOST_TEST_EQ(aos[7].x, -7.0);
+  BOOST_TEST_EQ(aos[7].y, 14.0);
+  BOOST_TEST_EQ(aos[7].mass, 0.5f);
+
+  // columns that can't be bulk copied are built element by element
+  //
+  struct named
+  {
+    std::string name;
+    int         rank = 0;
+  };
+
+  auto people = sleip::dynamic_array<named>(2);
+  people[0]   = named{"a", 1};
+  people[1]   = named{"b", 2};
+
+  auto cols = sleip::soa_dynamic_array<std::string, int>(people, &named::name, &named::rank);
+  BOOST_TEST_EQ(cols.column<0>()[1], "b");
+  BOOST_TEST_EQ(cols.column<1>()[1], 2);
+}
+
+void
+test_copy_move()
+{
+  using soa_type = sleip::soa_dynamic_array<int, std::string>;
+
+  auto a = soa_type(4, {1, "a"});
+  auto b = a;
+  BOOST_TEST(a == b);
+  BOOST_TEST_NE(a.data<0>(), b.data<0>());
+
+  std::get<1>(b[3]) = "b";
+  BOOST_TEST(a != b);
+
+  auto const* const old_data = b.data<1>();
+
+  auto c = std::move(b);
+  BOOST_TEST(b.empty());
+  BOOST_TEST_EQ(c.data<1>(), old_data);
+
+  a = c;
+  BOOST_TEST(a == c);
+
+  auto d = soa_type(1);
+  d      = std::move(c);
+  BOOST_TEST_EQ(d.size(), 4);
+  BOOST_TEST(c.empty());
+
+  swap(a, c);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(c.size(), 4);
+}
+
+// the columns are over-aligned which Boost.Container's memory resources don't support
+//
+void
+test_non_equal_allocators()
+{
+#ifndef SLEIP_NO_CXX17_PMR
+  namespace pmr = std::pmr;
+
+  using alloc_type = pmr::polymorphic_allocator<std::byte>;
+  using soa_type   = sleip::basic_soa_dynamic_array<alloc_type, float, std::int32_t>;
+
+  auto mem  = std::array<std::byte, 8192>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = alloc_type(&buff);
+  auto default_alloc = alloc_type();
+
+  auto a = soa_type(buff_alloc);
+  auto b = soa_type(100, {1.0f, 2}, default_alloc);
+
+  auto const* const old_data = b.data<0>();
+
+  a = std::move(b);
+  BOOST_TEST(a.get_allocator() == buff_alloc);
+  BOOST_TEST_NE(a.data<0>(), old_data);
+  BOOST_TEST_EQ(a.size(), 100);
+  BOOST_TEST_EQ(std::get<1>(a[99]), 2);
+  BOOST_TEST(b.empty());
+
+  auto c = soa_type(a, default_alloc);
+  BOOST_TEST(c == a);
+
+  auto aos = sleip::dynamic_array<particle>(3);
+  auto d   = soa_type(std::allocator_arg, buff_alloc, aos, &particle::mass, &particle::id);
+  BOOST_TEST(d.get_allocator() == buff_alloc);
+  BOOST_TEST_EQ(d.size(), 3);
+#endif
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+
+  throwing()
+  {
+    if (num_live == 3) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const&) = delete;
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  auto a = sleip::soa_dynamic_array<int, float>(3);
+  BOOST_TEST_THROWS(a.at(3), std::out_of_range);
+
+  auto aos = sleip::dynamic_array<particle>(4);
+  BOOST_TEST_THROWS(a.scatter(aos, &particle::id, &particle::mass), std::invalid_argument);
+
+  // the second column fails part way through and the first is unwound with it
+  //
+  throwing::num_live = 0;
+  BOOST_TEST_THROWS((sleip::soa_dynamic_array<std::string, throwing>(5)), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+
+  // a row count whose block size overflows, in one column and only once the columns are summed
+  //
+  constexpr auto const max = std::numeric_limits<std::size_t>::max();
+  BOOST_TEST_THROWS((sleip::soa_dynamic_array<int, float>(max / 4)), std::bad_array_new_length);
+  BOOST_TEST_THROWS((sleip::soa_dynamic_array<double, double>(max / 16)),
+                    std::bad_array_new_length);
+}
+
+#endif
+
+int
+main()
+{
+  test_layout();
+  test_rows();
+  test_aos_conversion();
+  test_copy_move();
+  test_non_equal_allocators();
+  test_throwing();
+
+  return boost::report_errors();
+}
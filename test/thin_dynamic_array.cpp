@@ -0,0 +1,339 @@
+#include <sleip/aligned_allocator.hpp>
+#include <sleip/dynamic_array.hpp>
+#include <sleip/thin_dynamic_array.hpp>
+#include <sleip/zero_page_allocator.hpp>
+
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+#include <iostream>
+#include <exception>
+
+namespace boost
+{
+void
+throw_exception(std::exception const& e)
+{
+  std::cerr << "Exception generated in noexcept code\nError: " << e.what() << "\n\n";
+  std::terminate();
+}
+} // namespace boost
+#endif
+
+namespace ipc = boost::interprocess;
+namespace pmr = boost::container::pmr;
+
+static_assert(sizeof(sleip::thin_dynamic_array<int>) == sizeof(void*));
+static_assert(sizeof(sleip::thin_dynamic_array<std::string>) == sizeof(void*));
+static_assert(std::is_nothrow_move_constructible_v<sleip::thin_dynamic_array<std::string>>);
+static_assert(std::is_nothrow_move_assignable_v<sleip::thin_dynamic_array<std::string>>);
+
+void
+test_construction()
+{
+  auto a = sleip::thin_dynamic_array<int>();
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(a.size(), 0);
+  BOOST_TEST_EQ(a.data(), nullptr);
+  BOOST_TEST_EQ(a.begin(), a.end());
+
+  auto b = sleip::thin_dynamic_array<int>(0, 1);
+  BOOST_TEST_EQ(b.data(), nullptr);
+
+  auto c = sleip::thin_dynamic_array<int>(100, 7);
+  BOOST_TEST_EQ(c.size(), 100);
+  BOOST_TEST(std::all_of(c.begin(), c.end(), [](int x) { return x == 7; }));
+
+  auto d = sleip::thin_dynamic_array<int>(100);
+  BOOST_TEST(std::all_of(d.begin(), d.end(), [](int x) { return x == 0; }));
+
+  auto e = sleip::thin_dynamic_array<int>(100, sleip::noinit);
+  BOOST_TEST_EQ(e.size(), 100);
+
+  auto const v = std::vector<std::string>{"a", "b", "c"};
+
+  auto f = sleip::thin_dynamic_array<std::string>(v);
+  BOOST_TEST_ALL_EQ(f.begin(), f.end(), v.begin(), v.end());
+
+  auto g = sleip::thin_dynamic_array<std::string>{"a", "b", "c"};
+  BOOST_TEST(f == g);
+
+  auto h = f;
+  BOOST_TEST(h == f);
+  BOOST_TEST_NE(h.data(), f.data());
+}
+
+void
+test_alignment()
+{
+  using vec4 = double[4];
+
+  auto a = sleip::thin_dynamic_array<vec4>(3, {1.0, 2.0, 3.0, 4.0});
+  BOOST_TEST_EQ(a.size(), 3);
+  BOOST_TEST_EQ(a[2][3], 4.0);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % alignof(vec4), 0);
+
+  struct alignas(32) wide
+  {
+    float x[8];
+  };
+
+  auto b = sleip::thin_dynamic_array<wide>(5);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 32, 0);
+
+  // the allocator's advertised alignment carries over to the elements, not just the header
+  //
+  auto c = sleip::thin_dynamic_array<float, sleip::cache_aligned_allocator<float>>(33, 1.0f);
+  BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(c.data()) % 64, 0);
+  BOOST_TEST_EQ(c.size(), 33);
+
+  auto d = sleip::thin_dynamic_array<int, sleip::zero_page_allocator<int>>(1 << 20);
+  BOOST_TEST_EQ(d.size(), 1 << 20);
+  BOOST_TEST(std::all_of(d.begin(), d.end(), [](int x) { return x == 0; }));
+}
+
+void
+test_nested()
+{
+  using inner_type = sleip::thin_dynamic_array<int>;
+
+  auto a = sleip::dynamic_array<inner_type>(4);
+  for (std::size_t i = 0; i < a.size(); ++i) { a[i] = inner_type(i, static_cast<int>(i)); }
+
+  BOOST_TEST(a[0].empty());
+  BOOST_TEST_EQ(a[3].size(), 3);
+  BOOST_TEST_EQ(a[3][2], 3);
+
+  auto b = a;
+  BOOST_TEST(b == a);
+}
+
+void
+test_move()
+{
+  auto a = sleip::thin_dynamic_array<std::string>(3, "x");
+
+  auto const* const old_data = a.data();
+
+  auto b = std::move(a);
+  BOOST_TEST(a.empty());
+  BOOST_TEST_EQ(b.data(), old_data);
+
+  auto c = sleip::thin_dynamic_array<std::string>(1, "y");
+  c      = std::move(b);
+  BOOST_TEST_EQ(c.data(), old_data);
+  BOOST_TEST(b.empty());
+
+  swap(b, c);
+  BOOST_TEST_EQ(b.data(), old_data);
+  BOOST_TEST(c.empty());
+}
+
+void
+test_non_equal_allocators()
+{
+  using alloc_type = pmr::polymorphic_allocator<int>;
+  using array_type = sleip::thin_dynamic_array<int, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  auto buff_alloc    = alloc_type(&buff);
+  auto default_alloc = alloc_type();
+
+  auto a = array_type(buff_alloc);
+  auto b = array_type(16, 1, default_alloc);
+
+  auto const* const old_data = b.data();
+
+  a = std::move(b);
+  BOOST_TEST(a.get_allocator() == buff_alloc);
+  BOOST_TEST_NE(a.data(), old_data);
+  BOOST_TEST_EQ(a.size(), 16);
+  BOOST_TEST(b.empty());
+
+  auto c = array_type(3, 2, default_alloc);
+  c      = a;
+  BOOST_TEST(c.get_allocator() == default_alloc);
+  BOOST_TEST(c == a);
+}
+
+// move-only so the relocation can't fall back to a copy, and counted so a leak of the source
+// elements shows up
+//
+struct relocatable
+{
+  static inline int num_live = 0;
+
+  int x = 1;
+
+  relocatable() { ++num_live; }
+  relocatable(relocatable&& other) noexcept
+    : x{std::exchange(other.x, 0)}
+  {
+    ++num_live;
+  }
+  ~relocatable() { --num_live; }
+};
+
+template <>
+struct sleip::is_trivially_relocatable<relocatable> : std::true_type
+{
+};
+
+void
+test_relocation()
+{
+  // `polymorphic_allocator` has its own `construct` so the elements aren't bulk copyable, but they
+  // are still bulk relocatable
+  //
+  using alloc_type = pmr::polymorphic_allocator<relocatable>;
+  using array_type = sleip::thin_dynamic_array<relocatable, alloc_type>;
+
+  auto mem  = std::array<std::byte, 4096>{};
+  auto buff = pmr::monotonic_buffer_resource(mem.data(), mem.size());
+
+  relocatable::num_live = 0;
+  {
+    auto a = array_type(4, alloc_type());
+    a[3].x = 7;
+
+    auto b = array_type(std::move(a), alloc_type(&buff));
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(b.size(), 4);
+    BOOST_TEST_EQ(b[3].x, 7);
+    BOOST_TEST_EQ(relocatable::num_live, 4);
+
+    auto c = array_type(alloc_type());
+    c      = std::move(b);
+    BOOST_TEST(b.empty());
+    BOOST_TEST_EQ(c[3].x, 7);
+    BOOST_TEST_EQ(relocatable::num_live, 4);
+  }
+  BOOST_TEST_EQ(relocatable::num_live, 0);
+}
+
+void
+test_fancy_pointer()
+{
+  struct shm_remove
+  {
+    shm_remove() { ipc::shared_memory_object::remove("SleipThinDynamicArray"); }
+    ~shm_remove() { ipc::shared_memory_object::remove("SleipThinDynamicArray"); }
+  } remover;
+
+  auto segment = ipc::managed_shared_memory(ipc::create_only, "SleipThinDynamicArray", 65536);
+
+  using alloc_type = ipc::allocator<int, ipc::managed_shared_memory::segment_manager>;
+
+  auto alloc = alloc_type(segment.get_segment_manager());
+
+  auto a = sleip::thin_dynamic_array<int, alloc_type>(std::size_t{128}, 1, alloc);
+  auto b = sleip::thin_dynamic_array<int, alloc_type>(std::size_t{128}, sleip::noinit, alloc);
+
+  BOOST_TEST_EQ(a.size(), 128);
+  BOOST_TEST_EQ(b.size(), 128);
+
+  b.fill(1);
+  BOOST_TEST(a == b);
+
+  auto c = std::move(a);
+  BOOST_TEST(a.empty());
+  BOOST_TEST(c == b);
+}
+
+void
+test_comparison()
+{
+  using array_type = sleip::thin_dynamic_array<int>;
+
+  auto const a = array_type{1, 2, 3};
+  auto const b = array_type{1, 2, 3, 4};
+  auto const c = array_type{1, 3};
+  auto const e = array_type();
+
+  BOOST_TEST(a == a);
+  BOOST_TEST(a != b);
+  BOOST_TEST(a < b);
+  BOOST_TEST(b < c);
+  BOOST_TEST(e < a);
+  BOOST_TEST(c >= b);
+  BOOST_TEST(e == array_type());
+}
+
+#ifdef BOOST_NO_EXCEPTIONS
+
+void
+test_throwing()
+{
+}
+
+#else
+
+struct throwing
+{
+  static inline int num_live = 0;
+
+  int x = 0;
+
+  throwing(int x_)
+    : x{x_}
+  {
+    if (x == -1) { throw 42; }
+    ++num_live;
+  }
+
+  throwing(throwing const& other)
+    : throwing(other.x)
+  {
+  }
+
+  ~throwing() { --num_live; }
+};
+
+void
+test_throwing()
+{
+  auto a = sleip::thin_dynamic_array<int>{1, 2, 3};
+  BOOST_TEST_THROWS(a.at(3), std::out_of_range);
+
+  BOOST_TEST_THROWS(sleip::thin_dynamic_array<int>(std::size_t(-1) / 2), std::bad_array_new_length);
+
+  auto const v = std::vector<int>{1, 2, -1};
+
+  throwing::num_live = 0;
+  BOOST_TEST_THROWS((sleip::thin_dynamic_array<throwing>(v.begin(), v.end())), int);
+  BOOST_TEST_EQ(throwing::num_live, 0);
+}
+
+#endif
+
+int
+main()
+{
+  test_construction();
+  test_alignment();
+  test_nested();
+  test_move();
+  test_non_equal_allocators();
+  test_relocation();
+  test_fancy_pointer();
+  test_comparison();
+  test_throwing();
+
+  return boost::report_errors();
+}
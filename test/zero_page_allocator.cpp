@@ -0,0 +1,155 @@
+#include <sleip/dynamic_array.hpp>
+#include <sleip/zero_page_allocator.hpp>
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+template <class T>
+struct zero_tracking_allocator
+{
+  using value_type = T;
+
+  int* num_zeroed;
+
+  zero_tracking_allocator(int* num_zeroed_) noexcept
+    : num_zeroed{num_zeroed_}
+  {
+  }
+
+  template <class U>
+  zero_tracking_allocator(zero_tracking_allocator<U> const& other) noexcept
+    : num_zeroed{other.num_zeroed}
+  {
+  }
+
+  auto
+  allocate(std::size_t n) -> T*
+  {
+    return std::allocator<T>().allocate(n);
+  }
+
+  auto
+  allocate_zeroed(std::size_t n) -> T*
+  {
+    ++*num_zeroed;
+
+    auto* p = allocate(n);
+    std::fill_n(reinterpret_cast<unsigned char*>(p), n * sizeof(T), 0);
+    return p;
+  }
+
+  auto
+  deallocate(T* p, std::size_t n) -> void
+  {
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <class U>
+  auto
+  operator==(zero_tracking_allocator<U> const& other) const noexcept -> bool
+  {
+    return num_zeroed == other.num_zeroed;
+  }
+
+  template <class U>
+  auto
+  operator!=(zero_tracking_allocator<U> const& other) const noexcept -> bool
+  {
+    return !(*this == other);
+  }
+};
+
+void
+test_allocate_zeroed_detection()
+{
+  static_assert(sleip::detail::is_zero_allocatable_v<int, sleip::zero_page_allocator<int>>);
+  static_assert(sleip::detail::is_zero_allocatable_v<int[3], sleip::zero_page_allocator<int[3]>>);
+  static_assert(!sleip::detail::is_zero_allocatable_v<int, std::allocator<int>>);
+  static_assert(
+    !sleip::detail::is_zero_allocatable_v<std::string, sleip::zero_page_allocator<std::string>>);
+
+  auto num_zeroed = 0;
+  auto alloc      = zero_tracking_allocator<int>(&num_zeroed);
+
+  // value-initialization goes through allocate_zeroed
+  //
+  {
+    auto a = sleip::dynamic_array<int, zero_tracking_allocator<int>>(128, alloc);
+
+    BOOST_TEST_EQ(num_zeroed, 1);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 0; }));
+  }
+
+  // but value and noinit construction do not
+  //
+  {
+    auto a = sleip::dynamic_array<int, zero_tracking_allocator<int>>(128, 7, alloc);
+    auto b = sleip::dynamic_array<int, zero_tracking_allocator<int>>(128, sleip::noinit, alloc);
+
+    BOOST_TEST_EQ(num_zeroed, 1);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](int x) { return x == 7; }));
+  }
+}
+
+void
+test_zero_page_allocator()
+{
+  using alloc_type = sleip::zero_page_allocator<double>;
+
+  // small, served by calloc
+  //
+  {
+    auto a = sleip::dynamic_array<double, alloc_type>(16);
+
+    BOOST_TEST_EQ(a.size(), 16);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](double x) { return x == 0.0; }));
+  }
+
+  // large, served by mmap
+  //
+  {
+    auto const count = 2 * alloc_type::mmap_threshold / sizeof(double);
+
+    auto a = sleip::dynamic_array<double, alloc_type>(count);
+
+    BOOST_TEST_EQ(a.size(), count);
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](double x) { return x == 0.0; }));
+
+    a.fill(1.0);
+
+    auto b = a;
+    BOOST_TEST_ALL_EQ(a.begin(), a.end(), b.begin(), b.end());
+  }
+
+  // array element types
+  //
+  {
+    auto a = sleip::dynamic_array<float[4], sleip::zero_page_allocator<float[4]>>(64);
+
+    auto const* p = boost::first_scalar(a.data());
+    BOOST_TEST(std::all_of(p, p + 4 * a.size(), [](float x) { return x == 0.0f; }));
+  }
+
+  // non-scalar types still get constructed
+  //
+  {
+    auto a =
+      sleip::dynamic_array<std::string, sleip::zero_page_allocator<std::string>>(4, "sleip");
+
+    BOOST_TEST(std::all_of(a.begin(), a.end(), [](auto const& s) { return s == "sleip"; }));
+  }
+}
+
+int
+main()
+{
+  test_allocate_zeroed_detection();
+  test_zero_page_allocator();
+
+  return boost::report_errors();
+}